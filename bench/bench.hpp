@@ -0,0 +1,113 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sipp_bench {
+
+// Number of elements processed by one benchmark batch
+constexpr std::size_t batch_size = 4096;
+
+template<class T>
+inline void do_not_optimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char *sink = reinterpret_cast<const volatile char *>(&value);
+    (void) *sink;
+#endif
+}
+
+inline void clobber_memory()
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+struct benchmark_case {
+    std::string name;
+    void (*batch)();
+    std::size_t operations;
+    // name of the hand-written equivalent the case must not be slower than, empty if none
+    std::string baseline;
+};
+
+inline std::vector<benchmark_case> &registry()
+{
+    static std::vector<benchmark_case> cases;
+    return cases;
+}
+
+inline void add_benchmark(const std::string &name,
+                          void (*batch)(),
+                          std::size_t operations,
+                          const std::string &baseline = std::string())
+{
+    registry().push_back(benchmark_case{name, batch, operations, baseline});
+}
+
+struct registrar {
+    registrar(const char *name, void (*batch)(), std::size_t operations, const char *baseline = "")
+    {
+        add_benchmark(name, batch, operations, baseline);
+    }
+};
+
+// Deterministic pseudo-random samples in [-range, range)
+inline std::vector<double> make_samples(std::size_t count, double range)
+{
+    std::vector<double> samples(count);
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (auto &sample : samples) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        sample = (static_cast<double>(state >> 11) / 9007199254740992.0 * 2.0 - 1.0) * range;
+    }
+    return samples;
+}
+
+// Best of several repetitions, in nanoseconds per operation
+inline double measure(const benchmark_case &benchmark,
+                      std::chrono::nanoseconds min_time = std::chrono::milliseconds(10),
+                      int repetitions = 5)
+{
+    using clock = std::chrono::steady_clock;
+
+    benchmark.batch();
+
+    double best = 0.0;
+    for (int repetition = 0; repetition < repetitions; ++repetition) {
+        std::size_t batches = 0;
+        const auto start = clock::now();
+        auto elapsed = clock::duration::zero();
+        do {
+            benchmark.batch();
+            ++batches;
+            elapsed = clock::now() - start;
+        } while (elapsed < min_time);
+
+        const double ns_per_op = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+            / static_cast<double>(batches * benchmark.operations);
+        best = repetition == 0 ? ns_per_op : std::min(best, ns_per_op);
+    }
+    return best;
+}
+
+}
+
+#define SIPP_BENCHMARK(name, operations) \
+    static void name(); \
+    static const ::sipp_bench::registrar name##_registrar(#name, &name, operations); \
+    static void name()
+
+// Benchmark gated against the hand-written equivalent registered as baseline
+#define SIPP_BENCHMARK_VS(name, baseline, operations) \
+    static void name(); \
+    static const ::sipp_bench::registrar name##_registrar(#name, &name, operations, #baseline); \
+    static void name()
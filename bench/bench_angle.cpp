@@ -0,0 +1,79 @@
+#include <cmath>
+
+#include <sipp/trigonometry.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::vector<sipp::Degrees> &headings()
+{
+    static const std::vector<sipp::Degrees> angles = [] {
+        std::vector<sipp::Degrees> result;
+        for (const double value : sipp_bench::make_samples(batch_size, 360.0)) {
+            result.emplace_back(value);
+        }
+        return result;
+    }();
+    return angles;
+}
+
+const std::vector<sipp::Knots> &components(std::size_t seed)
+{
+    static const std::vector<sipp::Knots> north = [] {
+        std::vector<sipp::Knots> result;
+        for (const double value : sipp_bench::make_samples(batch_size, 400.0)) {
+            result.emplace_back(value);
+        }
+        return result;
+    }();
+    static const std::vector<sipp::Knots> east = [] {
+        std::vector<sipp::Knots> result;
+        const auto values = sipp_bench::make_samples(batch_size + 1, 400.0);
+        for (std::size_t i = 1; i <= batch_size; ++i) {
+            result.emplace_back(values[i]);
+        }
+        return result;
+    }();
+    return seed == 0 ? north : east;
+}
+
+std::vector<double> ratios(batch_size);
+std::vector<sipp::Degrees> tracks(batch_size);
+
+}
+
+// Raw doubles: degrees scaled to radians by hand, then std::sin
+SIPP_BENCHMARK(sin_std_math, batch_size)
+{
+    const auto &angles = headings();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        ratios[i] = std::sin(angles[i].count() * (3.14159265358979323846 / 180.0));
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(sin_batch, sin_std_math, batch_size)
+{
+    sipp::sin(sipp::span<const sipp::Degrees>(headings()), sipp::span<double>(ratios));
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(atan2_std_math, batch_size)
+{
+    const auto &north = components(0);
+    const auto &east = components(1);
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        tracks[i] = sipp::Degrees(std::atan2(east[i].count(), north[i].count()) * (180.0 / 3.14159265358979323846));
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(atan2_batch, atan2_std_math, batch_size)
+{
+    sipp::atan2(sipp::span<const sipp::Knots>(components(1)), sipp::span<const sipp::Knots>(components(0)),
+                sipp::span<sipp::Degrees>(tracks));
+    sipp_bench::clobber_memory();
+}
@@ -0,0 +1,72 @@
+#include <sipp/batch.hpp>
+#include <sipp/precision.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::vector<sipp::Meters> &meters_samples()
+{
+    static const std::vector<double> raw = sipp_bench::make_samples(batch_size, 1.0e5);
+    static const std::vector<sipp::Meters> samples(raw.begin(), raw.end());
+    return samples;
+}
+
+std::vector<sipp::Feet> feet_output(batch_size);
+
+}
+
+SIPP_BENCHMARK(scalar_loop_meters_to_feet, batch_size)
+{
+    const auto &in = meters_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        feet_output[i] = sipp::distance_cast<sipp::Feet>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(batch_convert_meters_to_feet, batch_size)
+{
+    sipp::convert(sipp::span<const sipp::Meters>(meters_samples()), sipp::span<sipp::Feet>(feet_output));
+    sipp_bench::clobber_memory();
+}
+
+namespace {
+
+const std::vector<sipp::f32::Meters> &single_meters_samples()
+{
+    static const std::vector<double> raw = sipp_bench::make_samples(batch_size, 1.0e5);
+    static const std::vector<sipp::f32::Meters> samples = [] {
+        std::vector<sipp::f32::Meters> result;
+        for (double sample : raw) {
+            result.emplace_back(static_cast<float>(sample));
+        }
+        return result;
+    }();
+    return samples;
+}
+
+std::vector<sipp::f32::Feet> single_feet_output(batch_size);
+
+}
+
+SIPP_BENCHMARK(batch_convert_f32_meters_to_feet, batch_size)
+{
+    sipp::convert(sipp::span<const sipp::f32::Meters>(single_meters_samples()),
+                  sipp::span<sipp::f32::Feet>(single_feet_output));
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(accumulate_f64_meters, batch_size)
+{
+    auto total = sipp::accumulate(sipp::span<const sipp::Meters>(meters_samples()));
+    sipp_bench::do_not_optimize(total);
+}
+
+SIPP_BENCHMARK(accumulate_f32_meters_in_f64, batch_size)
+{
+    auto total = sipp::accumulate(sipp::span<const sipp::f32::Meters>(single_meters_samples()));
+    sipp_bench::do_not_optimize(total);
+}
@@ -0,0 +1,139 @@
+#include <sipp/sipp.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::vector<double> &raw_samples()
+{
+    static const std::vector<double> samples = sipp_bench::make_samples(batch_size, 1.0e5);
+    return samples;
+}
+
+template<class DistanceType>
+const std::vector<DistanceType> &samples()
+{
+    static const std::vector<DistanceType> typed(raw_samples().begin(), raw_samples().end());
+    return typed;
+}
+
+std::vector<double> raw_output(batch_size);
+std::vector<sipp::Meters> meters_output(batch_size);
+std::vector<sipp::Feet> feet_output(batch_size);
+std::vector<char> compare_output(batch_size);
+
+}
+
+SIPP_BENCHMARK(raw_feet_to_meters, batch_size)
+{
+    const auto &in = raw_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        raw_output[i] = in[i] * 0.3048;
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(distance_cast_feet_to_meters, raw_feet_to_meters, batch_size)
+{
+    const auto &in = samples<sipp::Feet>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        meters_output[i] = sipp::distance_cast<sipp::Meters>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(raw_km_to_feet, batch_size)
+{
+    const auto &in = raw_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        raw_output[i] = in[i] * (1250000.0 / 381.0);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(distance_cast_km_to_feet, raw_km_to_feet, batch_size)
+{
+    const auto &in = samples<sipp::Kilometers>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        feet_output[i] = sipp::distance_cast<sipp::Feet>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(raw_copy, batch_size)
+{
+    const auto &in = raw_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        raw_output[i] = in[i];
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(distance_cast_identity, raw_copy, batch_size)
+{
+    const auto &in = samples<sipp::Meters>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        meters_output[i] = sipp::distance_cast<sipp::Meters>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(raw_less, batch_size)
+{
+    const auto &in = raw_samples();
+    for (std::size_t i = 0; i + 1 < batch_size; ++i) {
+        compare_output[i] = in[i] < in[i + 1];
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(distance_less_same_unit, raw_less, batch_size)
+{
+    const auto &in = samples<sipp::Meters>();
+    for (std::size_t i = 0; i + 1 < batch_size; ++i) {
+        compare_output[i] = in[i] < in[i + 1];
+    }
+    sipp_bench::clobber_memory();
+}
+
+namespace {
+
+using IntMicrometers = sipp::Distance<std::int64_t, std::micro>;
+using IntFeet = sipp::Distance<std::int64_t, std::ratio<3048, 10000>>;
+
+const std::vector<IntFeet> &integer_feet_samples()
+{
+    static const std::vector<IntFeet> samples = [] {
+        std::vector<IntFeet> result;
+        for (double sample : raw_samples()) {
+            result.emplace_back(static_cast<std::int64_t>(sample));
+        }
+        return result;
+    }();
+    return samples;
+}
+
+std::vector<IntMicrometers> micrometers_output(batch_size);
+
+}
+
+SIPP_BENCHMARK(double_round_trip_int_feet_to_micrometers, batch_size)
+{
+    const auto &in = integer_feet_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        micrometers_output[i] = IntMicrometers(static_cast<std::int64_t>(
+            static_cast<double>(in[i].count()) * 0.3048 * 1.0e6));
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(distance_cast_int_feet_to_micrometers, batch_size)
+{
+    const auto &in = integer_feet_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        micrometers_output[i] = sipp::distance_cast<IntMicrometers>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
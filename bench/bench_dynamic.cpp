@@ -0,0 +1,67 @@
+#include <sipp/dynamic.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::vector<double> &samples()
+{
+    static const std::vector<double> raw = sipp_bench::make_samples(batch_size, 1.0e5);
+    return raw;
+}
+
+// The unit comes from configuration, the compiler can not see it
+volatile sipp::distance_unit configured_unit = sipp::distance_unit::feet;
+
+std::vector<sipp::Meters> meters_output(batch_size);
+
+sipp::Meters switch_to_meters(double count, sipp::distance_unit unit)
+{
+    switch (unit) {
+        case sipp::distance_unit::meters:
+            return sipp::Meters(count);
+        case sipp::distance_unit::kilometers:
+            return sipp::distance_cast<sipp::Meters>(sipp::Kilometers(count));
+        case sipp::distance_unit::millimeters:
+            return sipp::distance_cast<sipp::Meters>(sipp::Millimeters(count));
+        case sipp::distance_unit::micrometers:
+            return sipp::distance_cast<sipp::Meters>(sipp::Micrometers(count));
+        case sipp::distance_unit::nanometers:
+            return sipp::distance_cast<sipp::Meters>(sipp::Nanometers(count));
+        case sipp::distance_unit::feet:
+            return sipp::distance_cast<sipp::Meters>(sipp::Feet(count));
+        case sipp::distance_unit::nautical_miles:
+            return sipp::distance_cast<sipp::Meters>(sipp::NauticalMiles(count));
+        case sipp::distance_unit::statute_miles:
+            return sipp::distance_cast<sipp::Meters>(sipp::StatuteMiles(count));
+    }
+    return sipp::Meters();
+}
+
+}
+
+SIPP_BENCHMARK(dynamic_switch_per_element, batch_size)
+{
+    const auto &in = samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        meters_output[i] = switch_to_meters(in[i], configured_unit);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(dynamic_cast_per_element, dynamic_switch_per_element, batch_size)
+{
+    const auto &in = samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        meters_output[i] = sipp::distance_cast<sipp::Meters>(sipp::dynamic_distance(in[i], configured_unit));
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(dynamic_convert_array, dynamic_switch_per_element, batch_size)
+{
+    sipp::convert(sipp::span<const double>(samples()), configured_unit, sipp::span<sipp::Meters>(meters_output));
+    sipp_bench::clobber_memory();
+}
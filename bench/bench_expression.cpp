@@ -0,0 +1,45 @@
+#include <sipp/expression.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+template<class Quantity>
+const sipp::quantity_vector<Quantity> &samples()
+{
+    static const sipp::quantity_vector<Quantity> values = [] {
+        sipp::quantity_vector<Quantity> result;
+        for (double sample : sipp_bench::make_samples(batch_size, 1.0e3)) {
+            result.push_back(Quantity(sample));
+        }
+        return result;
+    }();
+    return values;
+}
+
+sipp::quantity_vector<sipp::Meters> meters_output(batch_size);
+
+}
+
+SIPP_BENCHMARK(stepwise_mixed_unit_sum, batch_size)
+{
+    const auto &kilometers = samples<sipp::Kilometers>();
+    const auto &feet = samples<sipp::Feet>();
+    const auto &nautical_miles = samples<sipp::NauticalMiles>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        meters_output.set(i, kilometers[i] + feet[i] - nautical_miles[i] * 2);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(expression_mixed_unit_sum, batch_size)
+{
+    using sipp::expr::lazy;
+
+    sipp::expr::assign(meters_output,
+                       lazy(samples<sipp::Kilometers>()) + lazy(samples<sipp::Feet>())
+                           - lazy(samples<sipp::NauticalMiles>()) * 2);
+    sipp_bench::clobber_memory();
+}
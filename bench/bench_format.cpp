@@ -0,0 +1,59 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sipp/format.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::vector<sipp::Meters> &meters()
+{
+    static const std::vector<sipp::Meters> values = [] {
+        const auto samples = sipp_bench::make_samples(batch_size, 1.0e5);
+        std::vector<sipp::Meters> result;
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            // half telemetry-like values with few decimals, half full precision
+            result.emplace_back(i % 2 == 0 ? static_cast<double>(static_cast<long>(samples[i] * 100.0)) / 100.0
+                                           : samples[i]);
+        }
+        return result;
+    }();
+    return values;
+}
+
+std::vector<char> text_output(batch_size * sipp::max_formatted_size);
+
+}
+
+SIPP_BENCHMARK(format_ostringstream, batch_size)
+{
+    std::ostringstream stream;
+    stream.precision(17);
+    for (const auto &value : meters()) {
+        stream << value.count() << "m\n";
+    }
+    sipp_bench::do_not_optimize(stream.str());
+}
+
+SIPP_BENCHMARK_VS(format_to_chars, format_ostringstream, batch_size)
+{
+    char *position = text_output.data();
+    char *const last = position + text_output.size();
+    for (const auto &value : meters()) {
+        position = sipp::to_chars(position, last, value).ptr;
+        *position++ = '\n';
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(format_column, format_ostringstream, batch_size)
+{
+    sipp::format_column(sipp::span<const sipp::Meters>(meters()),
+                        text_output.data(),
+                        text_output.data() + text_output.size());
+    sipp_bench::clobber_memory();
+}
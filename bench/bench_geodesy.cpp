@@ -0,0 +1,62 @@
+#include <sipp/geodesy.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+std::vector<sipp::geo_point> make_points(double offset)
+{
+    const auto latitudes = sipp_bench::make_samples(batch_size, 80.0);
+    const auto longitudes = sipp_bench::make_samples(batch_size + 1, 179.0);
+    std::vector<sipp::geo_point> points(batch_size);
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        points[i] = sipp::geo_point{latitudes[i], longitudes[i + 1] * offset};
+    }
+    return points;
+}
+
+const std::vector<sipp::geo_point> &origins()
+{
+    static const std::vector<sipp::geo_point> points = make_points(1.0);
+    return points;
+}
+
+const std::vector<sipp::geo_point> &destinations()
+{
+    static const std::vector<sipp::geo_point> points = make_points(-0.5);
+    return points;
+}
+
+std::vector<sipp::NauticalMiles> legs(batch_size);
+
+}
+
+// std::sin / std::cos / std::asin on raw doubles, then wrapped in a Distance
+SIPP_BENCHMARK(haversine_std_math, batch_size)
+{
+    const auto &from = origins();
+    const auto &to = destinations();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        legs[i] = sipp::haversine<sipp::NauticalMiles>(from[i], to[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(haversine_batch, haversine_std_math, batch_size)
+{
+    sipp::haversine(sipp::span<const sipp::geo_point>(origins()), sipp::span<const sipp::geo_point>(destinations()),
+                    sipp::span<sipp::NauticalMiles>(legs));
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(vincenty_scalar, batch_size)
+{
+    const auto &from = origins();
+    const auto &to = destinations();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        legs[i] = sipp::vincenty<sipp::NauticalMiles>(from[i], to[i]);
+    }
+    sipp_bench::clobber_memory();
+}
@@ -0,0 +1,58 @@
+#include <chrono>
+
+#include <sipp/kinematics.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::chrono::milliseconds tick(100);
+
+std::vector<sipp::Meters> positions = [] {
+    const auto raw = sipp_bench::make_samples(batch_size, 1.0e5);
+    return std::vector<sipp::Meters>(raw.begin(), raw.end());
+}();
+
+const std::vector<sipp::Knots> &velocities()
+{
+    static const std::vector<double> raw = sipp_bench::make_samples(batch_size, 500.0);
+    static const std::vector<sipp::Knots> samples(raw.begin(), raw.end());
+    return samples;
+}
+
+std::vector<std::chrono::duration<double>> times(batch_size);
+
+}
+
+SIPP_BENCHMARK(advance_scalar_operators, batch_size)
+{
+    const auto &v = velocities();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        positions[i] += v[i] * tick;
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(advance_batch, advance_scalar_operators, batch_size)
+{
+    sipp::advance(sipp::span<sipp::Meters>(positions), sipp::span<const sipp::Knots>(velocities()), tick);
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(time_to_go_scalar_operators, batch_size)
+{
+    const auto &v = velocities();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        times[i] = std::chrono::duration_cast<std::chrono::duration<double>>(positions[i] / v[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(time_to_go_batch, time_to_go_scalar_operators, batch_size)
+{
+    sipp::time_to_go(sipp::span<const sipp::Meters>(positions), sipp::span<const sipp::Knots>(velocities()),
+                     sipp::span<std::chrono::duration<double>>(times));
+    sipp_bench::clobber_memory();
+}
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <utility>
+
+#include <sipp/lookup_table.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+// Climb rate against altitude, 4096 unevenly spaced breakpoints (larger than L1 together)
+constexpr std::size_t table_size = 4096;
+
+const std::vector<std::pair<double, double>> &raw_table()
+{
+    static const std::vector<std::pair<double, double>> table = [] {
+        std::vector<std::pair<double, double>> result;
+        const auto steps = sipp_bench::make_samples(table_size, 20.0);
+        const auto rates = sipp_bench::make_samples(table_size, 3000.0);
+        double altitude = 0.0;
+        for (std::size_t i = 0; i < table_size; ++i) {
+            result.emplace_back(altitude, rates[i]);
+            altitude += 1.0 + (steps[i] < 0.0 ? -steps[i] : steps[i]);
+        }
+        return result;
+    }();
+    return table;
+}
+
+const sipp::lookup_table<sipp::Feet, sipp::FeetPerMinute> &climb()
+{
+    static const sipp::lookup_table<sipp::Feet, sipp::FeetPerMinute> table = [] {
+        std::vector<sipp::Feet> keys;
+        std::vector<sipp::FeetPerMinute> values;
+        for (const auto &breakpoint : raw_table()) {
+            keys.emplace_back(breakpoint.first);
+            values.emplace_back(breakpoint.second);
+        }
+        const sipp::span<const sipp::Feet> key_span(keys);
+        return sipp::lookup_table<sipp::Feet, sipp::FeetPerMinute>(key_span,
+                                                                   sipp::span<const sipp::FeetPerMinute>(values));
+    }();
+    return table;
+}
+
+const std::vector<sipp::Feet> &altitudes()
+{
+    static const std::vector<sipp::Feet> queries = [] {
+        std::vector<sipp::Feet> result;
+        const double top = raw_table().back().first;
+        for (const double value : sipp_bench::make_samples(batch_size, top / 2.0)) {
+            result.emplace_back(top / 2.0 + value);
+        }
+        return result;
+    }();
+    return queries;
+}
+
+std::vector<sipp::FeetPerMinute> rates(batch_size);
+
+}
+
+// Raw pairs searched with std::upper_bound, as planning code does by hand
+SIPP_BENCHMARK(lookup_pairs_upper_bound, batch_size)
+{
+    const auto &table = raw_table();
+    const auto &queries = altitudes();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        const double key = queries[i].count();
+        auto high = std::upper_bound(table.begin(), table.end(), key,
+                                     [](double value, const std::pair<double, double> &breakpoint) {
+                                         return value < breakpoint.first;
+                                     });
+        if (high == table.begin()) {
+            rates[i] = sipp::FeetPerMinute(high->second);
+        } else if (high == table.end()) {
+            rates[i] = sipp::FeetPerMinute(table.back().second);
+        } else {
+            const auto low = high - 1;
+            const double t = (key - low->first) / (high->first - low->first);
+            rates[i] = sipp::FeetPerMinute(low->second + t * (high->second - low->second));
+        }
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(lookup_table_scalar, lookup_pairs_upper_bound, batch_size)
+{
+    const auto &table = climb();
+    const auto &queries = altitudes();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        rates[i] = table.interpolate(queries[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(lookup_table_batch, lookup_pairs_upper_bound, batch_size)
+{
+    climb().interpolate(sipp::span<const sipp::Feet>(altitudes()), sipp::span<sipp::FeetPerMinute>(rates));
+    sipp_bench::clobber_memory();
+}
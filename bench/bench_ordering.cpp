@@ -0,0 +1,67 @@
+#include <algorithm>
+
+#include <sipp/ordering.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::vector<sipp::Feet> &feet_samples()
+{
+    static const std::vector<double> raw = sipp_bench::make_samples(batch_size, 1.0e5);
+    static const std::vector<sipp::Feet> samples(raw.begin(), raw.end());
+    return samples;
+}
+
+const std::vector<sipp::Feet> &sorted_feet()
+{
+    static const std::vector<sipp::Feet> sorted = [] {
+        auto result = feet_samples();
+        std::sort(result.begin(), result.end());
+        return result;
+    }();
+    return sorted;
+}
+
+std::vector<sipp::Feet> sort_buffer(batch_size);
+std::vector<sipp::Feet> sort_scratch(batch_size);
+
+}
+
+SIPP_BENCHMARK(sort_std_sort_operator_less, batch_size)
+{
+    std::copy(feet_samples().begin(), feet_samples().end(), sort_buffer.begin());
+    std::sort(sort_buffer.begin(), sort_buffer.end());
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(sort_radix_sort, sort_std_sort_operator_less, batch_size)
+{
+    std::copy(feet_samples().begin(), feet_samples().end(), sort_buffer.begin());
+    sipp::radix_sort(sipp::span<sipp::Feet>(sort_buffer), sipp::span<sipp::Feet>(sort_scratch));
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(lower_bound_std_meters_threshold, batch_size)
+{
+    const auto &sorted = sorted_feet();
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        const sipp::Meters threshold(feet_samples()[i].count() * 0.3);
+        total += static_cast<std::size_t>(std::lower_bound(sorted.begin(), sorted.end(), threshold) - sorted.begin());
+    }
+    sipp_bench::do_not_optimize(total);
+}
+
+SIPP_BENCHMARK_VS(lower_bound_sipp_meters_threshold, lower_bound_std_meters_threshold, batch_size)
+{
+    const sipp::span<const sipp::Feet> sorted(sorted_feet());
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        const sipp::Meters threshold(feet_samples()[i].count() * 0.3);
+        total += sipp::lower_bound(sorted, threshold);
+    }
+    sipp_bench::do_not_optimize(total);
+}
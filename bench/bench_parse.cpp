@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <sipp/parse.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+// One quantity per line in mixed units, e.g. "-12345.678km"
+const std::string &text()
+{
+    static const std::string lines = [] {
+        static const char *suffixes[] = {"m", "km", "ft", " NM", "mi", "mm"};
+        const auto samples = sipp_bench::make_samples(batch_size, 1.0e5);
+        std::string result;
+        char field[64];
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            std::snprintf(field, sizeof(field), "%.3f%s\n", samples[i], suffixes[i % 6]);
+            result += field;
+        }
+        return result;
+    }();
+    return lines;
+}
+
+std::vector<sipp::Meters> meters_output(batch_size);
+
+sipp::Meters stod_strcmp(const std::string &field)
+{
+    std::size_t end = 0;
+    const double value = std::stod(field, &end);
+    while (end < field.size() && field[end] == ' ') {
+        ++end;
+    }
+
+    const char *suffix = field.c_str() + end;
+    if (std::strcmp(suffix, "m") == 0) {
+        return sipp::Meters(value);
+    } else if (std::strcmp(suffix, "km") == 0) {
+        return sipp::Kilometers(value);
+    } else if (std::strcmp(suffix, "ft") == 0) {
+        return sipp::Feet(value);
+    } else if (std::strcmp(suffix, "NM") == 0) {
+        return sipp::NauticalMiles(value);
+    } else if (std::strcmp(suffix, "mi") == 0) {
+        return sipp::StatuteMiles(value);
+    } else if (std::strcmp(suffix, "mm") == 0) {
+        return sipp::Millimeters(value);
+    }
+    return sipp::Meters();
+}
+
+}
+
+SIPP_BENCHMARK(parse_stod_strcmp, batch_size)
+{
+    const auto &lines = text();
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        const auto last = lines.find('\n', first);
+        meters_output[i] = stod_strcmp(lines.substr(first, last - first));
+        first = last + 1;
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(parse_from_chars, parse_stod_strcmp, batch_size)
+{
+    const auto &lines = text();
+    const char *position = lines.data();
+    const char *const last = position + lines.size();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        position = sipp::from_chars(position, last, meters_output[i]).ptr + 1;
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(parse_column, parse_stod_strcmp, batch_size)
+{
+    const auto &lines = text();
+    sipp::parse_column(lines.data(), lines.data() + lines.size(), sipp::span<sipp::Meters>(meters_output));
+    sipp_bench::clobber_memory();
+}
@@ -0,0 +1,46 @@
+#include <chrono>
+
+#include <sipp/quantity.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::chrono::seconds interval(30);
+
+const std::vector<double> &raw_speeds()
+{
+    static const std::vector<double> samples = sipp_bench::make_samples(batch_size, 500.0);
+    return samples;
+}
+
+const std::vector<sipp::Knots> &speeds()
+{
+    static const std::vector<sipp::Knots> samples(raw_speeds().begin(), raw_speeds().end());
+    return samples;
+}
+
+std::vector<double> raw_accelerations(batch_size);
+std::vector<sipp::StandardGravities> accelerations(batch_size);
+
+}
+
+SIPP_BENCHMARK(acceleration_raw_doubles, batch_size)
+{
+    const auto &v = raw_speeds();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        raw_accelerations[i] = v[i] * 1852.0 / 3600.0 / 30.0 / 9.80665;
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(acceleration_quantity, acceleration_raw_doubles, batch_size)
+{
+    const auto &v = speeds();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        accelerations[i] = v[i] / interval;
+    }
+    sipp_bench::clobber_memory();
+}
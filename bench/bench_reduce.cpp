@@ -0,0 +1,58 @@
+#include <sipp/reduce.hpp>
+
+#include "bench.hpp"
+
+namespace {
+
+// large enough to be split over every core, small enough for a quick benchmark run
+constexpr std::size_t reduce_size = std::size_t(1) << 22;
+
+const std::vector<sipp::NauticalMiles> &legs()
+{
+    static const std::vector<double> raw = sipp_bench::make_samples(reduce_size, 500.0);
+    static const std::vector<sipp::NauticalMiles> samples(raw.begin(), raw.end());
+    return samples;
+}
+
+}
+
+SIPP_BENCHMARK(sum_running_total, reduce_size)
+{
+    sipp::NauticalMiles total(0.0);
+    for (const auto &leg : legs()) {
+        total += leg;
+    }
+    sipp_bench::do_not_optimize(total);
+}
+
+SIPP_BENCHMARK_VS(sum_compensated, sum_running_total, reduce_size)
+{
+    sipp_bench::do_not_optimize(sipp::sum(sipp::span<const sipp::NauticalMiles>(legs())));
+}
+
+SIPP_BENCHMARK_VS(sum_compensated_parallel, sum_running_total, reduce_size)
+{
+    sipp_bench::do_not_optimize(sipp::sum(sipp::execution::par, sipp::span<const sipp::NauticalMiles>(legs())));
+}
+
+SIPP_BENCHMARK(summarize_sequential, reduce_size)
+{
+    sipp_bench::do_not_optimize(sipp::summarize(sipp::span<const sipp::NauticalMiles>(legs())).variance);
+}
+
+SIPP_BENCHMARK_VS(summarize_parallel, summarize_sequential, reduce_size)
+{
+    sipp_bench::do_not_optimize(
+        sipp::summarize(sipp::execution::par, sipp::span<const sipp::NauticalMiles>(legs())).variance);
+}
+
+SIPP_BENCHMARK(quantile_sequential, reduce_size)
+{
+    sipp_bench::do_not_optimize(sipp::quantile(sipp::span<const sipp::NauticalMiles>(legs()), 0.95));
+}
+
+SIPP_BENCHMARK_VS(quantile_parallel, quantile_sequential, reduce_size)
+{
+    sipp_bench::do_not_optimize(
+        sipp::quantile(sipp::execution::par, sipp::span<const sipp::NauticalMiles>(legs()), 0.95));
+}
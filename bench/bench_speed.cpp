@@ -0,0 +1,71 @@
+#include <sipp/sipp.hpp>
+
+#include "bench.hpp"
+
+using sipp_bench::batch_size;
+
+namespace {
+
+const std::vector<double> &raw_samples()
+{
+    static const std::vector<double> samples = sipp_bench::make_samples(batch_size, 1.0e3);
+    return samples;
+}
+
+template<class SpeedType>
+const std::vector<SpeedType> &samples()
+{
+    static const std::vector<SpeedType> typed(raw_samples().begin(), raw_samples().end());
+    return typed;
+}
+
+std::vector<double> raw_output(batch_size);
+std::vector<sipp::KmPerHour> km_per_hour_output(batch_size);
+std::vector<sipp::Knots> knots_output(batch_size);
+
+}
+
+SIPP_BENCHMARK(raw_knots_to_km_per_hour, batch_size)
+{
+    const auto &in = raw_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        raw_output[i] = in[i] * 1.852;
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(speed_cast_knots_to_km_per_hour, raw_knots_to_km_per_hour, batch_size)
+{
+    const auto &in = samples<sipp::Knots>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        km_per_hour_output[i] = sipp::speed_cast<sipp::KmPerHour>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK(raw_feet_per_minute_to_knots, batch_size)
+{
+    const auto &in = raw_samples();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        raw_output[i] = in[i] * (0.3048 * 60.0 / 1852.0);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(speed_cast_feet_per_minute_to_knots, raw_feet_per_minute_to_knots, batch_size)
+{
+    const auto &in = samples<sipp::FeetPerMinute>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        knots_output[i] = sipp::speed_cast<sipp::Knots>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+SIPP_BENCHMARK_VS(speed_cast_identity, raw_copy, batch_size)
+{
+    const auto &in = samples<sipp::Knots>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        knots_output[i] = sipp::speed_cast<sipp::Knots>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
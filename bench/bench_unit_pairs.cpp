@@ -0,0 +1,353 @@
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sipp/sipp.hpp>
+
+#include "bench.hpp"
+
+// Every operation for every pair of predefined units, each gated against a raw double
+// loop using the conversion factor computed by hand from the same ratios
+
+using sipp_bench::batch_size;
+
+namespace {
+
+template<class... Types>
+struct type_list {};
+
+using distances = type_list<sipp::Meters,
+                            sipp::Kilometers,
+                            sipp::Millimeters,
+                            sipp::Micrometers,
+                            sipp::Nanometers,
+                            sipp::Feet,
+                            sipp::NauticalMiles,
+                            sipp::StatuteMiles>;
+
+using speeds = type_list<sipp::KmPerHour,
+                         sipp::MetersPerSecond,
+                         sipp::FeetPerSecond,
+                         sipp::FeetPerMinute,
+                         sipp::Knots,
+                         sipp::MilesPerHour>;
+
+template<class Quantity>
+struct unit_name;
+
+#define SIPP_BENCH_UNIT_NAME(type) \
+    template<> \
+    struct unit_name<sipp::type> { \
+        static const char *get() { return #type; } \
+    }
+
+SIPP_BENCH_UNIT_NAME(Meters);
+SIPP_BENCH_UNIT_NAME(Kilometers);
+SIPP_BENCH_UNIT_NAME(Millimeters);
+SIPP_BENCH_UNIT_NAME(Micrometers);
+SIPP_BENCH_UNIT_NAME(Nanometers);
+SIPP_BENCH_UNIT_NAME(Feet);
+SIPP_BENCH_UNIT_NAME(NauticalMiles);
+SIPP_BENCH_UNIT_NAME(StatuteMiles);
+SIPP_BENCH_UNIT_NAME(KmPerHour);
+SIPP_BENCH_UNIT_NAME(MetersPerSecond);
+SIPP_BENCH_UNIT_NAME(FeetPerSecond);
+SIPP_BENCH_UNIT_NAME(FeetPerMinute);
+SIPP_BENCH_UNIT_NAME(Knots);
+SIPP_BENCH_UNIT_NAME(MilesPerHour);
+
+#undef SIPP_BENCH_UNIT_NAME
+
+template<class Ratio>
+constexpr double factor()
+{
+    return static_cast<double>(Ratio::num) / static_cast<double>(Ratio::den);
+}
+
+// Meters (per second) in one unit of the quantity
+template<class Distance>
+constexpr double distance_factor()
+{
+    return factor<typename Distance::ratio>();
+}
+
+template<class Speed>
+constexpr double speed_factor()
+{
+    return factor<std::ratio_divide<typename Speed::distance_type::ratio, typename Speed::ratio>>();
+}
+
+constexpr std::size_t page_size = 4096;
+
+// Buffer starting on a page boundary: library cases use quantity buffers and baseline
+// cases double buffers, all with the same placement, so a difference in timing can
+// only come from the generated code and not from memory layout
+template<class T>
+class aligned_buffer {
+public:
+    explicit aligned_buffer(const std::vector<double> &values)
+        : m_storage(values.size() + page_size / sizeof(T))
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(m_storage.data());
+        m_data = m_storage.data() + (page_size - address % page_size) % page_size / sizeof(T);
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            m_data[i] = T(values[i]);
+        }
+    }
+
+    aligned_buffer(const aligned_buffer &) = delete;
+    aligned_buffer &operator=(const aligned_buffer &) = delete;
+
+    T *data()
+    { return m_data; }
+
+private:
+    std::vector<T> m_storage;
+    T *m_data;
+};
+
+const std::vector<double> &sample_values(int seed)
+{
+    static const std::vector<double> first = sipp_bench::make_samples(batch_size, 1.0e5);
+    static const std::vector<double> second = sipp_bench::make_samples(2 * batch_size, 1.0e3);
+    return seed == 0 ? first : second;
+}
+
+template<class T>
+const T *typed_samples(int seed)
+{
+    static aligned_buffer<T> first(sample_values(0));
+    static aligned_buffer<T> second(sample_values(1));
+    return seed == 0 ? first.data() : second.data();
+}
+
+template<class T>
+T *typed_output()
+{
+    static aligned_buffer<T> values{std::vector<double>(batch_size)};
+    return values.data();
+}
+
+const double *raw_samples(int seed)
+{
+    return typed_samples<double>(seed);
+}
+
+double *raw_output()
+{
+    return typed_output<double>();
+}
+
+char *compare_output()
+{
+    return typed_output<char>();
+}
+
+template<class Quantity>
+const Quantity *samples(int seed = 0)
+{
+    return typed_samples<Quantity>(seed);
+}
+
+template<class Quantity>
+Quantity *output()
+{
+    return typed_output<Quantity>();
+}
+
+template<class From, class To>
+void distance_cast_case()
+{
+    const auto *in = samples<From>();
+    auto *out = output<To>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = sipp::distance_cast<To>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class From, class To>
+void raw_distance_cast_case()
+{
+    constexpr double scale = distance_factor<From>() / distance_factor<To>();
+    const auto *in = raw_samples(0);
+    auto *out = raw_output();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = in[i] * scale;
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class From, class To>
+void speed_cast_case()
+{
+    const auto *in = samples<From>();
+    auto *out = output<To>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = sipp::speed_cast<To>(in[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class From, class To>
+void raw_speed_cast_case()
+{
+    constexpr double scale = speed_factor<From>() / speed_factor<To>();
+    const auto *in = raw_samples(0);
+    auto *out = raw_output();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = in[i] * scale;
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class Left, class Right>
+void distance_less_case()
+{
+    const auto *left = samples<Left>(0);
+    const auto *right = samples<Right>(1);
+    auto *out = compare_output();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = left[i] < right[i];
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class Left, class Right>
+void raw_distance_less_case()
+{
+    constexpr double scale = factor<std::ratio_divide<typename Right::ratio, typename Left::ratio>>();
+    const auto *left = raw_samples(0);
+    const auto *right = raw_samples(1);
+    auto *out = compare_output();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = left[i] < right[i] * scale;
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class Speed>
+void speed_times_duration_case()
+{
+    const auto *speed = samples<Speed>(0);
+    const auto *time = raw_samples(1);
+    auto *out = output<typename Speed::distance_type>();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = speed[i] * std::chrono::duration<double>(time[i]);
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class Speed>
+void raw_speed_times_duration_case()
+{
+    constexpr double scale = 1.0 / factor<typename Speed::ratio>();
+    const auto *speed = raw_samples(0);
+    const auto *time = raw_samples(1);
+    auto *out = raw_output();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = speed[i] * time[i] * scale;
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class Distance, class Speed>
+void distance_over_speed_case()
+{
+    const auto *distance = samples<Distance>(0);
+    const auto *speed = samples<Speed>(1);
+    auto *out = raw_output();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = (distance[i] / speed[i]).count();
+    }
+    sipp_bench::clobber_memory();
+}
+
+template<class Distance, class Speed>
+void raw_distance_over_speed_case()
+{
+    constexpr double scale = distance_factor<Distance>() / distance_factor<typename Speed::distance_type>();
+    const auto *distance = raw_samples(0);
+    const auto *speed = raw_samples(1);
+    auto *out = raw_output();
+    for (std::size_t i = 0; i < batch_size; ++i) {
+        out[i] = distance[i] * scale / speed[i];
+    }
+    sipp_bench::clobber_memory();
+}
+
+void add_pair(const std::string &name, void (*library)(), void (*raw)())
+{
+    sipp_bench::add_benchmark("raw_" + name, raw, batch_size);
+    sipp_bench::add_benchmark(name, library, batch_size, "raw_" + name);
+}
+
+template<class Left, class Right>
+std::string pair_name(const char *operation)
+{
+    return std::string(operation) + "<" + unit_name<Left>::get() + "," + unit_name<Right>::get() + ">";
+}
+
+template<class From, class... To>
+void add_distance_row(type_list<To...>)
+{
+    const int expand[] = {
+        (add_pair(pair_name<From, To>("distance_cast"),
+                  &distance_cast_case<From, To>,
+                  &raw_distance_cast_case<From, To>),
+         add_pair(pair_name<From, To>("distance_less"),
+                  &distance_less_case<From, To>,
+                  &raw_distance_less_case<From, To>),
+         0)...
+    };
+    (void) expand;
+}
+
+template<class From, class... To>
+void add_speed_row(type_list<To...>)
+{
+    const int expand[] = {
+        (add_pair(pair_name<From, To>("speed_cast"),
+                  &speed_cast_case<From, To>,
+                  &raw_speed_cast_case<From, To>),
+         0)...
+    };
+    (void) expand;
+}
+
+template<class Distance, class... Speed>
+void add_distance_over_speed_row(type_list<Speed...>)
+{
+    const int expand[] = {
+        (add_pair(pair_name<Distance, Speed>("distance_over_speed"),
+                  &distance_over_speed_case<Distance, Speed>,
+                  &raw_distance_over_speed_case<Distance, Speed>),
+         0)...
+    };
+    (void) expand;
+}
+
+template<class... Distance>
+void add_distance_pairs(type_list<Distance...>)
+{
+    const int expand[] = {(add_distance_row<Distance>(distances()),
+                           add_distance_over_speed_row<Distance>(speeds()),
+                           0)...};
+    (void) expand;
+}
+
+template<class... Speed>
+void add_speed_pairs(type_list<Speed...>)
+{
+    const int expand[] = {(add_speed_row<Speed>(speeds()),
+                           add_pair(std::string("speed_times_duration<") + unit_name<Speed>::get() + ">",
+                                    &speed_times_duration_case<Speed>,
+                                    &raw_speed_times_duration_case<Speed>),
+                           0)...};
+    (void) expand;
+}
+
+const bool registered = (add_distance_pairs(distances()), add_speed_pairs(speeds()), true);
+
+}
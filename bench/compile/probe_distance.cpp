@@ -0,0 +1,8 @@
+#include <sipp/distance.hpp>
+
+double probe(double value)
+{
+    const sipp::Meters meters(value);
+    const auto sum = meters + sipp::Kilometers(1.0) + sipp::Feet(3.0) + sipp::NauticalMiles(0.5);
+    return sipp::distance_cast<sipp::StatuteMiles>(sum).count();
+}
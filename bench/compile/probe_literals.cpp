@@ -0,0 +1,11 @@
+#include <sipp/literals.hpp>
+
+using namespace sipp::literals;
+
+double probe(double value)
+{
+    const sipp::Meters meters(value);
+    const auto sum = meters + 1_km + 3_ft + 0.5_NM;
+    const auto speed = sipp::speed_cast<sipp::Knots>(10_m_s + 250_km_h);
+    return sipp::distance_cast<sipp::StatuteMiles>(sum).count() + speed.count();
+}
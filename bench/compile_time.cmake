@@ -0,0 +1,47 @@
+# Compile-time benchmark: cmake -DCXX=<compiler> -DINCLUDE_DIR=<include> -P compile_time.cmake
+#
+# Compiles every probe in compile/ (the same operations through the different public
+# headers) REPETITIONS times with -fsyntax-only and prints the mean wall time in
+# milliseconds and the size of the preprocessed translation unit.
+
+cmake_minimum_required(VERSION 3.23)
+
+if(NOT CXX OR NOT INCLUDE_DIR)
+  message(FATAL_ERROR "Usage: cmake -DCXX=<compiler> -DINCLUDE_DIR=<include dir> -P compile_time.cmake")
+endif()
+if(NOT REPETITIONS)
+  set(REPETITIONS 5)
+endif()
+if(NOT STANDARD)
+  set(STANDARD c++14)
+endif()
+
+set(flags -std=${STANDARD} -I${INCLUDE_DIR})
+file(GLOB probes "${CMAKE_CURRENT_LIST_DIR}/compile/*.cpp")
+
+message("probe                 ms/compile   preprocessed lines")
+foreach(probe ${probes})
+  get_filename_component(name ${probe} NAME_WE)
+
+  execute_process(COMMAND ${CXX} ${flags} -E ${probe}
+                  OUTPUT_VARIABLE preprocessed
+                  RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${name} does not compile")
+  endif()
+  string(REGEX MATCHALL "\n" newlines "${preprocessed}")
+  list(LENGTH newlines lines)
+
+  string(TIMESTAMP start "%s%f")
+  foreach(i RANGE 1 ${REPETITIONS})
+    execute_process(COMMAND ${CXX} ${flags} -fsyntax-only ${probe} RESULT_VARIABLE result)
+  endforeach()
+  string(TIMESTAMP stop "%s%f")
+  # %s%f concatenates seconds and microseconds
+  math(EXPR milliseconds "(${stop} - ${start}) / 1000 / ${REPETITIONS}")
+
+  string(LENGTH "${name}" length)
+  math(EXPR padding "22 - ${length}")
+  string(REPEAT " " ${padding} spaces)
+  message("${name}${spaces}${milliseconds}          ${lines}")
+endforeach()
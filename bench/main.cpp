@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "bench.hpp"
+
+namespace {
+
+struct options {
+    // fail when a case is slower than its baseline by more than this fraction
+    double tolerance = 0.10;
+    // differences below this many nanoseconds per operation are timer noise
+    double noise_ns = 0.05;
+    // interleaved measurements of a case and its baseline, multiplied by attempts
+    // for pairs that still look slower
+    int rounds = 10;
+    int attempts = 3;
+    bool gate = false;
+    std::string filter;
+    std::chrono::milliseconds min_time{5};
+};
+
+void usage()
+{
+    std::printf("usage: sipp_bench [--gate] [--tolerance FRACTION] [--filter TEXT] [--min-time-ms N]\n"
+                "  --gate       exit with failure when an operation is measurably slower\n"
+                "               than its hand-written baseline\n");
+}
+
+bool parse(int argc, char **argv, options &result)
+{
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--gate") == 0) {
+            result.gate = true;
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && has_value) {
+            result.tolerance = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && has_value) {
+            result.filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--min-time-ms") == 0 && has_value) {
+            result.min_time = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool slower(double ns, double baseline_ns, const options &settings)
+{
+    return ns > baseline_ns * (1.0 + settings.tolerance) && ns - baseline_ns > settings.noise_ns;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    options settings;
+    if (!parse(argc, argv, settings)) {
+        usage();
+        return 2;
+    }
+
+    std::map<std::string, const sipp_bench::benchmark_case *> by_name;
+    for (const auto &benchmark : sipp_bench::registry()) {
+        by_name[benchmark.name] = &benchmark;
+    }
+
+    int failures = 0;
+    std::printf("%-64s %12s %12s %8s\n", "benchmark", "ns/op", "baseline", "ratio");
+    for (const auto &benchmark : sipp_bench::registry()) {
+        if (benchmark.name.find(settings.filter) == std::string::npos) {
+            continue;
+        }
+
+        double ns = sipp_bench::measure(benchmark, settings.min_time);
+        const auto baseline = by_name.find(benchmark.baseline);
+        if (baseline == by_name.end()) {
+            std::printf("%-64s %12.3f\n", benchmark.name.c_str(), ns);
+            continue;
+        }
+
+        // alternate which of the two cases runs first so that both see the same machine
+        // load, and keep measuring suspicious pairs to rule out noise from other processes
+        double baseline_ns = sipp_bench::measure(*baseline->second, settings.min_time);
+        for (int round = 1; round < settings.rounds
+                 || (round < settings.rounds * settings.attempts && slower(ns, baseline_ns, settings));
+             ++round) {
+            const auto &first = round % 2 == 0 ? benchmark : *baseline->second;
+            const auto &second = round % 2 == 0 ? *baseline->second : benchmark;
+            const double first_ns = sipp_bench::measure(first, settings.min_time, 1);
+            const double second_ns = sipp_bench::measure(second, settings.min_time, 1);
+            ns = std::min(ns, round % 2 == 0 ? first_ns : second_ns);
+            baseline_ns = std::min(baseline_ns, round % 2 == 0 ? second_ns : first_ns);
+        }
+
+        const bool failed = slower(ns, baseline_ns, settings);
+        failures += failed ? 1 : 0;
+        std::printf("%-64s %12.3f %12.3f %8.2f%s\n", benchmark.name.c_str(), ns, baseline_ns,
+                    ns / baseline_ns, failed ? "  SLOWER" : "");
+    }
+
+    if (settings.gate && failures > 0) {
+        std::printf("\n%d operation(s) slower than the hand-written equivalent\n", failures);
+        return 1;
+    }
+    return 0;
+}
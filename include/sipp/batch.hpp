@@ -0,0 +1,4 @@
+#pragma once
+
+#include "sipp.hpp"
+#include "internals/batch.hpp"
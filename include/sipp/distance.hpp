@@ -0,0 +1,4 @@
+#pragma once
+
+// Distance, distance_cast and the distance typedefs only: no <chrono>, speeds or literals
+#include "internals/distance.hpp"
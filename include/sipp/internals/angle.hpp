@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+#include <ratio>
+
+#include "conversion.hpp"
+#include "angle_fwd.hpp"
+
+namespace sipp {
+
+namespace detail {
+
+template<class Rep, class Ratio>
+struct quantity_traits<Angle<Rep, Ratio>> {
+    using dimension = dimensions::angle;
+    using ratio = Ratio;
+};
+
+// Number of Ratio units in a full turn, e.g. 360 for degrees
+template<class Ratio>
+using turn_count = std::ratio_divide<TurnRatio, Ratio>;
+
+template<class Rep, class Ratio>
+inline Rep wrap_count(Rep count, std::true_type)
+{
+    constexpr Rep full = Rep(turn_count<Ratio>::num) / Rep(turn_count<Ratio>::den);
+    Rep wrapped = std::fmod(count, full);
+    if (wrapped < Rep(0)) {
+        wrapped += full;
+    }
+    // a tiny negative count rounds up to exactly a full turn
+    return wrapped < full ? wrapped : Rep(0);
+}
+
+template<class Rep, class Ratio>
+constexpr Rep wrap_count(Rep count, std::false_type)
+{
+    static_assert(turn_count<Ratio>::den == 1, "A full turn must be a whole number of integral angle units");
+    return count % Rep(turn_count<Ratio>::num) < Rep(0)
+               ? count % Rep(turn_count<Ratio>::num) + Rep(turn_count<Ratio>::num)
+               : count % Rep(turn_count<Ratio>::num);
+}
+
+}
+
+template<class Rep0, class Ratio, class Rep>
+struct rebind_rep<Angle<Rep0, Ratio>, Rep> {
+    using type = Angle<Rep, Ratio>;
+};
+
+}
+
+namespace std {
+
+// Angle able to represent both operands exactly, as for std::chrono::duration
+template<class Rep1, class Ratio1, class Rep2, class Ratio2>
+struct common_type<sipp::Angle<Rep1, Ratio1>, sipp::Angle<Rep2, Ratio2>> {
+    using type = sipp::Angle<typename common_type<Rep1, Rep2>::type,
+                             sipp::detail::common_ratio<Ratio1, Ratio2>>;
+};
+
+}
+
+namespace sipp {
+
+template<class ToAngle, class Rounding = rounding::toward_zero, class Rep, class Ratio>
+constexpr ToAngle angle_cast(const Angle<Rep, Ratio> &angle)
+{
+    SIPP_TRACE_CONVERSION(Angle<Rep, Ratio>, ToAngle);
+    using conversion = detail::unit_conversion<typename ToAngle::rep,
+                                               typename ToAngle::ratio,
+                                               Rep,
+                                               Ratio,
+                                               Rounding>;
+
+    return ToAngle(conversion::apply(angle.count()));
+}
+
+template<class ToAngle, class Rep, class Ratio>
+constexpr ToAngle floor(const Angle<Rep, Ratio> &angle)
+{
+    return angle_cast<ToAngle, rounding::downward>(angle);
+}
+
+template<class ToAngle, class Rep, class Ratio>
+constexpr ToAngle ceil(const Angle<Rep, Ratio> &angle)
+{
+    return angle_cast<ToAngle, rounding::upward>(angle);
+}
+
+template<class ToAngle, class Rep, class Ratio>
+constexpr ToAngle round(const Angle<Rep, Ratio> &angle)
+{
+    return angle_cast<ToAngle, rounding::to_nearest>(angle);
+}
+
+// Plane angle, radians being the unit ratio. Headings and tracks are angles too: wrap()
+// brings them back into [0, 360) degrees after arithmetic.
+template<class Rep, class Ratio = RadianRatio>
+class Angle {
+public:
+    using rep = Rep;
+    using ratio = Ratio;
+
+    constexpr Angle() : m_count(0)
+    {}
+
+    template<class Rep2>
+    constexpr explicit Angle(const Rep2 &value): m_count(value)
+    {}
+
+    template<class Rep2, class Ratio2>
+    constexpr Angle(const Angle<Rep2, Ratio2> &other)
+        : m_count(angle_cast<Angle<Rep, Ratio>>(other).count())
+    {
+        static_assert(detail::is_lossless_conversion<Rep,
+                                                     Rep2,
+                                                     std::ratio_divide<Ratio2, Ratio>>::value,
+                      "Use sipp::angle_cast<> to perform explicit cast of integer types "
+                          "(possible precision loss)");
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr Angle<Rep, Ratio> &operator=(const Angle<Rep2, Ratio2> &other)
+    {
+        *this = Angle<Rep, Ratio>(other);
+        return *this;
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr Angle<Rep, Ratio> &operator+=(const Angle<Rep2, Ratio2> &other)
+    {
+        *this = *this + other;
+        return *this;
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr Angle<Rep, Ratio> &operator-=(const Angle<Rep2, Ratio2> &other)
+    {
+        *this = *this - other;
+        return *this;
+    }
+
+    template<class Rep2>
+    constexpr Angle<Rep, Ratio> &operator*=(const Rep2 &multiplier)
+    {
+        *this = *this * multiplier;
+        return *this;
+    }
+
+    template<class Rep2>
+    constexpr Angle<Rep, Ratio> &operator/=(const Rep2 &divider)
+    {
+        *this = *this / divider;
+        return *this;
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator<(const Angle<Rep2, Ratio2> &other) const
+    {
+        using counts = detail::comparable_counts<Angle<Rep, Ratio>, Angle<Rep2, Ratio2>>;
+        return counts::lhs(*this) < counts::rhs(other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator<=(const Angle<Rep2, Ratio2> &other) const
+    {
+        using counts = detail::comparable_counts<Angle<Rep, Ratio>, Angle<Rep2, Ratio2>>;
+        return counts::lhs(*this) <= counts::rhs(other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator>(const Angle<Rep2, Ratio2> &other) const
+    {
+        return !(*this <= other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator>=(const Angle<Rep2, Ratio2> &other) const
+    {
+        return !(*this < other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator==(const Angle<Rep2, Ratio2> &other) const
+    {
+        using counts = detail::comparable_counts<Angle<Rep, Ratio>, Angle<Rep2, Ratio2>>;
+        return counts::lhs(*this) == counts::rhs(other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator!=(const Angle<Rep2, Ratio2> &other) const
+    {
+        return !(*this == other);
+    }
+
+    constexpr Angle<Rep, Ratio> operator-() const
+    {
+        return Angle<Rep, Ratio>(-m_count);
+    }
+
+    constexpr const Rep &count() const
+    { return m_count; }
+
+    constexpr Angle<Rep, Ratio> abs() const
+    {
+        return Angle<Rep, Ratio>(m_count < Rep(0) ? -m_count : m_count);
+    }
+
+private:
+    Rep m_count;
+};
+
+template<class Rep, class Ratio, class Rep2>
+constexpr Angle<Rep, Ratio> operator*(const Angle<Rep, Ratio> &angle, const Rep2 &multiplier)
+{
+    static_assert(std::is_integral<Rep2>::value ||
+                      std::is_floating_point<Rep2>::value,
+                  "Allowed to multiply Angle only on integral or floating point types");
+
+    return Angle<Rep, Ratio>(angle.count() * multiplier);
+}
+
+template<class Rep, class Ratio, class Rep2>
+constexpr Angle<Rep, Ratio> operator*(const Rep2 &multiplier, const Angle<Rep, Ratio> &angle)
+{
+    return angle * multiplier;
+}
+
+template<class Rep, class Ratio, class Rep2>
+constexpr Angle<Rep, Ratio> operator/(const Angle<Rep, Ratio> &angle, const Rep2 &divider)
+{
+    static_assert(std::is_integral<Rep2>::value ||
+                      std::is_floating_point<Rep2>::value,
+                  "Allowed to divide Angle only by integral or floating point types");
+
+    return Angle<Rep, Ratio>(angle.count() / divider);
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Ratio2>
+constexpr typename std::common_type<Angle<Rep1, Ratio1>, Angle<Rep2, Ratio2>>::type
+operator+(const Angle<Rep1, Ratio1> &angle1, const Angle<Rep2, Ratio2> &angle2)
+{
+    using common = typename std::common_type<Angle<Rep1, Ratio1>, Angle<Rep2, Ratio2>>::type;
+    return common(angle_cast<common>(angle1).count() + angle_cast<common>(angle2).count());
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Ratio2>
+constexpr typename std::common_type<Angle<Rep1, Ratio1>, Angle<Rep2, Ratio2>>::type
+operator-(const Angle<Rep1, Ratio1> &angle1, const Angle<Rep2, Ratio2> &angle2)
+{
+    using common = typename std::common_type<Angle<Rep1, Ratio1>, Angle<Rep2, Ratio2>>::type;
+    return common(angle_cast<common>(angle1).count() - angle_cast<common>(angle2).count());
+}
+
+// The same direction within [0, 1) turn, e.g. a heading of -10 degrees becomes 350.
+// Integral angles need a unit which divides the turn (degrees, arc minutes).
+template<class Rep, class Ratio>
+inline Angle<Rep, Ratio> wrap(const Angle<Rep, Ratio> &angle)
+{
+    return Angle<Rep, Ratio>(detail::wrap_count<Rep, Ratio>(angle.count(), std::is_floating_point<Rep>()));
+}
+
+// The same direction within [-1/2, 1/2) turn, e.g. the signed difference of two headings
+template<class Rep, class Ratio>
+inline Angle<Rep, Ratio> wrap_signed(const Angle<Rep, Ratio> &angle)
+{
+    using half_turn = std::ratio_divide<detail::turn_count<Ratio>, std::ratio<2>>;
+    const Angle<Rep, Ratio> half(Rep(half_turn::num) / Rep(half_turn::den));
+    const Angle<Rep, Ratio> wrapped = wrap(angle);
+    return wrapped < half ? wrapped : wrapped - half - half;
+}
+
+namespace literals {
+
+constexpr Degrees operator "" _deg(long double value)
+{ return Degrees(value); }
+
+constexpr Degrees operator "" _deg(unsigned long long int value)
+{ return Degrees(value); }
+
+constexpr Radians operator "" _rad(long double value)
+{ return Radians(value); }
+
+constexpr Radians operator "" _rad(unsigned long long int value)
+{ return Radians(value); }
+
+}
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <ratio>
+
+namespace sipp {
+
+template<class Rep, class Ratio>
+class Angle;
+
+// Ratios relative to the radian. Pi is the rational 245850922 / 78256779 (within 1e-16
+// relative, below double precision), so that degrees, turns and their fractions
+// convert into each other exactly.
+using RadianRatio = std::ratio<1>;
+using TurnRatio = std::ratio<2 * 245850922, 78256779>;
+using DegreeRatio = std::ratio_divide<TurnRatio, std::ratio<360>>;
+
+using Radians = Angle<double, RadianRatio>;
+using Degrees = Angle<double, DegreeRatio>;
+using ArcMinutes = Angle<double, std::ratio_divide<DegreeRatio, std::ratio<60>>>;
+using Turns = Angle<double, TurnRatio>;
+
+// Single precision variants, e.g. sipp::f32::Degrees
+namespace f32 {
+
+using Radians = Angle<float, RadianRatio>;
+using Degrees = Angle<float, DegreeRatio>;
+using ArcMinutes = Angle<float, std::ratio_divide<DegreeRatio, std::ratio<60>>>;
+using Turns = Angle<float, TurnRatio>;
+
+}
+
+}
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <ratio>
+#include <type_traits>
+
+#include "conversion.hpp"
+#include "distance.hpp"
+#include "span.hpp"
+#include "speed.hpp"
+
+#if !defined(SIPP_NO_SIMD) && (defined(__GNUC__) || defined(__clang__)) \
+    && (defined(__x86_64__) || defined(__i386__))
+#define SIPP_SIMD_X86 1
+#include <immintrin.h>
+#define SIPP_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace sipp {
+
+enum class simd_isa {
+    portable,
+    sse2,
+    avx2,
+    avx512
+};
+
+namespace detail {
+
+template<class Rep>
+using scale_kernel = void (*)(const Rep *, Rep *, std::size_t, Rep);
+
+template<class Rep>
+inline void scale_portable(const Rep *in, Rep *out, std::size_t count, Rep factor)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = in[i] * factor;
+    }
+}
+
+#ifdef SIPP_SIMD_X86
+
+SIPP_TARGET("sse2")
+inline void scale_sse2(const double *in, double *out, std::size_t count, double factor)
+{
+    const __m128d f = _mm_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128d a = _mm_loadu_pd(in + i);
+        const __m128d b = _mm_loadu_pd(in + i + 2);
+        _mm_storeu_pd(out + i, _mm_mul_pd(a, f));
+        _mm_storeu_pd(out + i + 2, _mm_mul_pd(b, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = in[i] * factor;
+    }
+}
+
+SIPP_TARGET("sse2")
+inline void scale_sse2(const float *in, float *out, std::size_t count, float factor)
+{
+    const __m128 f = _mm_set1_ps(factor);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128 a = _mm_loadu_ps(in + i);
+        const __m128 b = _mm_loadu_ps(in + i + 4);
+        _mm_storeu_ps(out + i, _mm_mul_ps(a, f));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(b, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = in[i] * factor;
+    }
+}
+
+SIPP_TARGET("avx2")
+inline void scale_avx2(const double *in, double *out, std::size_t count, double factor)
+{
+    const __m256d f = _mm256_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256d a = _mm256_loadu_pd(in + i);
+        const __m256d b = _mm256_loadu_pd(in + i + 4);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(a, f));
+        _mm256_storeu_pd(out + i + 4, _mm256_mul_pd(b, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = in[i] * factor;
+    }
+}
+
+SIPP_TARGET("avx2")
+inline void scale_avx2(const float *in, float *out, std::size_t count, float factor)
+{
+    const __m256 f = _mm256_set1_ps(factor);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256 a = _mm256_loadu_ps(in + i);
+        const __m256 b = _mm256_loadu_ps(in + i + 8);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(a, f));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(b, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = in[i] * factor;
+    }
+}
+
+SIPP_TARGET("avx512f")
+inline void scale_avx512(const double *in, double *out, std::size_t count, double factor)
+{
+    const __m512d f = _mm512_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(in + i), f));
+    }
+    if (i < count) {
+        const __mmask8 tail = static_cast<__mmask8>((1u << (count - i)) - 1u);
+        _mm512_mask_storeu_pd(out + i, tail, _mm512_mul_pd(_mm512_maskz_loadu_pd(tail, in + i), f));
+    }
+}
+
+SIPP_TARGET("avx512f")
+inline void scale_avx512(const float *in, float *out, std::size_t count, float factor)
+{
+    const __m512 f = _mm512_set1_ps(factor);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(in + i), f));
+    }
+    if (i < count) {
+        const __mmask16 tail = static_cast<__mmask16>((1u << (count - i)) - 1u);
+        _mm512_mask_storeu_ps(out + i, tail, _mm512_mul_ps(_mm512_maskz_loadu_ps(tail, in + i), f));
+    }
+}
+
+#endif
+
+inline simd_isa detect_simd_isa()
+{
+#ifdef SIPP_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return simd_isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return simd_isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return simd_isa::sse2;
+    }
+#endif
+    return simd_isa::portable;
+}
+
+// Kernel multiplying Rep (double or float) arrays by a factor on the given instruction set
+template<class Rep>
+inline scale_kernel<Rep> select_scale_kernel(simd_isa isa)
+{
+    switch (isa) {
+#ifdef SIPP_SIMD_X86
+        case simd_isa::avx512:
+            return static_cast<scale_kernel<Rep>>(&scale_avx512);
+        case simd_isa::avx2:
+            return static_cast<scale_kernel<Rep>>(&scale_avx2);
+        case simd_isa::sse2:
+            return static_cast<scale_kernel<Rep>>(&scale_sse2);
+#endif
+        default:
+            return &scale_portable<Rep>;
+    }
+}
+
+template<class Rep>
+inline void scale(const Rep *in, Rep *out, std::size_t count, Rep factor)
+{
+    static const scale_kernel<Rep> kernel = select_scale_kernel<Rep>(detect_simd_isa());
+    kernel(in, out, count, factor);
+}
+
+template<class Factor, class Rep>
+inline void convert_reps(const Rep *in, Rep *out, std::size_t count, std::true_type)
+{
+    if (std::ratio_equal<Factor, std::ratio<1>>::value) {
+        std::copy(in, in + count, out);
+    } else {
+        scale(in, out, count, static_cast<Rep>(Factor::num) / static_cast<Rep>(Factor::den));
+    }
+}
+
+template<class Factor, class FromRep, class ToRep>
+inline void convert_reps(const FromRep *in, ToRep *out, std::size_t count, std::false_type)
+{
+    using conversion = unit_conversion<ToRep, std::ratio<1>, FromRep, Factor>;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = conversion::apply(in[i]);
+    }
+}
+
+// Converts raw counts scaled by Factor, vectorized for double -> double and float -> float
+template<class Factor, class FromRep, class ToRep>
+inline void convert_reps(const FromRep *in, ToRep *out, std::size_t count)
+{
+    using simd_path = std::integral_constant<bool,
+                                             std::is_same<FromRep, ToRep>::value
+                                                 && (std::is_same<ToRep, double>::value
+                                                     || std::is_same<ToRep, float>::value)>;
+    convert_reps<Factor>(in, out, count, simd_path());
+}
+
+template<class Quantity>
+inline const typename Quantity::rep *rep_data(const Quantity *quantities)
+{
+    static_assert(std::is_standard_layout<Quantity>::value
+                      && sizeof(Quantity) == sizeof(typename Quantity::rep),
+                  "Quantity must be layout-compatible with its representation");
+    return reinterpret_cast<const typename Quantity::rep *>(quantities);
+}
+
+template<class Quantity>
+inline typename Quantity::rep *rep_data(Quantity *quantities)
+{
+    static_assert(std::is_standard_layout<Quantity>::value
+                      && sizeof(Quantity) == sizeof(typename Quantity::rep),
+                  "Quantity must be layout-compatible with its representation");
+    return reinterpret_cast<typename Quantity::rep *>(quantities);
+}
+
+template<class From, class To>
+inline void convert_quantities(const From *in, To *out, std::size_t count)
+{
+    convert_reps<typename quantity_factor<To, From>::type>(rep_data(in), rep_data(out), count);
+}
+
+}
+
+// Instruction set used by the batch conversion kernels on this machine
+inline simd_isa active_simd_isa()
+{
+    static const simd_isa isa = detail::detect_simd_isa();
+    return isa;
+}
+
+template<class Rep, class Ratio, class ToRep, class ToRatio>
+inline Distance<ToRep, ToRatio> *convert(const Distance<Rep, Ratio> *first,
+                                         const Distance<Rep, Ratio> *last,
+                                         Distance<ToRep, ToRatio> *out)
+{
+    const auto count = static_cast<std::size_t>(last - first);
+    detail::convert_quantities(first, out, count);
+    return out + count;
+}
+
+template<class Rep, class DistanceType, class Ratio, class ToRep, class ToDistanceType, class ToRatio>
+inline Speed<ToRep, ToDistanceType, ToRatio> *convert(const Speed<Rep, DistanceType, Ratio> *first,
+                                                      const Speed<Rep, DistanceType, Ratio> *last,
+                                                      Speed<ToRep, ToDistanceType, ToRatio> *out)
+{
+    const auto count = static_cast<std::size_t>(last - first);
+    detail::convert_quantities(first, out, count);
+    return out + count;
+}
+
+// Converts min(in.size(), out.size()) elements, returns the number of converted elements
+template<class From, class To>
+inline std::size_t convert(span<From> in, span<To> out)
+{
+    const auto count = std::min(in.size(), out.size());
+    const typename std::add_const<From>::type *first = in.data();
+    convert(first, first + count, out.data());
+    return count;
+}
+
+}
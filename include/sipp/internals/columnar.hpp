@@ -0,0 +1,603 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "batch.hpp"
+#include "conversion.hpp"
+#include "mapped_file.hpp"
+#include "quantity_vector.hpp"
+#include "span.hpp"
+
+namespace sipp {
+
+// Columnar file of unit-tagged samples. Every column records its representation and the
+// ratio of its unit, values are stored raw and page-aligned so that a mapped column can be
+// used in place as a span of quantities:
+//
+//   sipp::columnar_writer().add("altitude", altitudes).add("speed", speeds).write(path);
+//
+//   sipp::columnar_file file(path);
+//   sipp::span<const sipp::Meters> altitude = file.values<sipp::Meters>("altitude");
+//   auto speed = file.reader<sipp::Knots>("speed");   // converted chunk by chunk
+//
+// Files use the native byte order and are rejected on machines with another one.
+enum class column_rep : std::uint8_t {
+    float32 = 1,
+    float64 = 2,
+    int32 = 3,
+    int64 = 4
+};
+
+enum class column_dimension : std::uint8_t {
+    distance = 1,
+    speed = 2
+};
+
+struct column_info {
+    std::string name;
+    column_dimension dimension;
+    column_rep rep;
+    // unit as a ratio of meters (per second for speeds)
+    std::intmax_t ratio_num;
+    std::intmax_t ratio_den;
+    std::size_t size;
+};
+
+class columnar_error : public std::runtime_error {
+public:
+    explicit columnar_error(const std::string &message) : std::runtime_error("sipp: " + message)
+    {}
+};
+
+namespace detail {
+
+constexpr std::uint32_t columnar_version = 1;
+constexpr std::uint32_t columnar_byte_order = 0x01020304;
+constexpr std::size_t columnar_alignment = 4096;
+constexpr std::size_t columnar_name_size = 40;
+
+struct columnar_file_header {
+    char magic[8];
+    std::uint32_t byte_order;
+    std::uint32_t version;
+    std::uint64_t column_count;
+    std::uint64_t reserved;
+};
+
+struct columnar_column_header {
+    char name[columnar_name_size];
+    std::uint8_t dimension;
+    std::uint8_t rep;
+    std::uint8_t reserved[6];
+    std::int64_t ratio_num;
+    std::int64_t ratio_den;
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+static_assert(sizeof(columnar_file_header) == 32, "Unexpected padding in the file header");
+static_assert(sizeof(columnar_column_header) == 80, "Unexpected padding in the column header");
+
+inline const char *columnar_magic()
+{ return "SIPPCOL"; }
+
+template<class Rep, class = void>
+struct column_rep_of;
+
+template<>
+struct column_rep_of<float> : std::integral_constant<column_rep, column_rep::float32> {};
+
+template<>
+struct column_rep_of<double> : std::integral_constant<column_rep, column_rep::float64> {};
+
+// Any signed integer of 32 or 64 bits, e.g. long long and long on LP64
+template<class Rep>
+struct column_rep_of<Rep,
+                     typename std::enable_if<std::is_integral<Rep>::value && std::is_signed<Rep>::value
+                                             && sizeof(Rep) == 4>::type>
+    : std::integral_constant<column_rep, column_rep::int32> {};
+
+template<class Rep>
+struct column_rep_of<Rep,
+                     typename std::enable_if<std::is_integral<Rep>::value && std::is_signed<Rep>::value
+                                             && sizeof(Rep) == 8>::type>
+    : std::integral_constant<column_rep, column_rep::int64> {};
+
+template<class Dimension>
+struct column_dimension_of;
+
+template<>
+struct column_dimension_of<distance_dimension>
+    : std::integral_constant<column_dimension, column_dimension::distance> {};
+
+template<>
+struct column_dimension_of<speed_dimension>
+    : std::integral_constant<column_dimension, column_dimension::speed> {};
+
+inline std::size_t column_rep_size(column_rep rep)
+{
+    switch (rep) {
+        case column_rep::float32:
+        case column_rep::int32:
+            return 4;
+        case column_rep::float64:
+        case column_rep::int64:
+            return 8;
+    }
+    return 0;
+}
+
+template<class Quantity>
+inline column_info describe_column(const std::string &name, std::size_t size)
+{
+    using traits = quantity_traits<Quantity>;
+    return column_info{name,
+                       column_dimension_of<typename traits::dimension>::value,
+                       column_rep_of<typename Quantity::rep>::value,
+                       traits::ratio::num,
+                       traits::ratio::den,
+                       size};
+}
+
+// Whether a column holds exactly Quantity values, so it can be used without conversion
+template<class Quantity>
+inline bool same_unit(const column_info &column)
+{
+    const auto expected = describe_column<Quantity>(column.name, column.size);
+    return column.dimension == expected.dimension && column.rep == expected.rep
+        && column.ratio_num == expected.ratio_num && column.ratio_den == expected.ratio_den;
+}
+
+inline std::intmax_t runtime_gcd(std::intmax_t a, std::intmax_t b)
+{
+    while (b != 0) {
+        const auto rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a < 0 ? -a : a;
+}
+
+// unit_conversion with the source ratio only known at runtime. Results are the same as
+// for the compile-time conversion between the same units (rounded toward zero).
+template<class ToRep>
+class runtime_conversion {
+public:
+    runtime_conversion(std::intmax_t from_num, std::intmax_t from_den,
+                       std::intmax_t to_num, std::intmax_t to_den)
+    {
+        const auto num_gcd = runtime_gcd(from_num, to_num);
+        const auto den_gcd = runtime_gcd(to_den, from_den);
+        m_num = static_cast<wide_int>(from_num / num_gcd) * (to_den / den_gcd);
+        m_den = static_cast<wide_int>(from_den / den_gcd) * (to_num / num_gcd);
+    }
+
+    bool identity() const
+    { return m_num == m_den; }
+
+    template<class FromRep>
+    void apply(const FromRep *in, ToRep *out, std::size_t count) const
+    {
+        apply(in, out, count, std::is_floating_point<conversion_rep<ToRep, FromRep>>());
+    }
+
+private:
+    template<class FromRep>
+    void apply(const FromRep *in, ToRep *out, std::size_t count, std::true_type) const
+    {
+        using rep = conversion_rep<ToRep, FromRep>;
+        const rep factor = static_cast<rep>(m_num) / static_cast<rep>(m_den);
+        if (identity()) {
+            for (std::size_t i = 0; i < count; ++i) {
+                out[i] = static_cast<ToRep>(in[i]);
+            }
+        } else {
+            scale_floating(in, out, count, factor, std::is_same<FromRep, ToRep>());
+        }
+    }
+
+    template<class FromRep>
+    void apply(const FromRep *in, ToRep *out, std::size_t count, std::false_type) const
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<ToRep>(static_cast<wide_int>(in[i]) * m_num / m_den);
+        }
+    }
+
+    template<class Rep>
+    static void scale_floating(const ToRep *in, ToRep *out, std::size_t count, Rep factor, std::true_type)
+    {
+        scale(in, out, count, static_cast<ToRep>(factor));
+    }
+
+    template<class FromRep, class Rep>
+    static void scale_floating(const FromRep *in, ToRep *out, std::size_t count, Rep factor, std::false_type)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<ToRep>(static_cast<Rep>(in[i]) * factor);
+        }
+    }
+
+    wide_int m_num;
+    wide_int m_den;
+};
+
+template<class ToRep, class FromRep>
+inline void convert_column_counts(const unsigned char *in,
+                                  ToRep *out,
+                                  std::size_t count,
+                                  const runtime_conversion<ToRep> &conversion)
+{
+    conversion.apply(reinterpret_cast<const FromRep *>(in), out, count);
+}
+
+template<class ToRep>
+inline void convert_column_counts(const unsigned char *in,
+                                  column_rep rep,
+                                  ToRep *out,
+                                  std::size_t count,
+                                  const runtime_conversion<ToRep> &conversion)
+{
+    switch (rep) {
+        case column_rep::float32:
+            return convert_column_counts<ToRep, float>(in, out, count, conversion);
+        case column_rep::float64:
+            return convert_column_counts<ToRep, double>(in, out, count, conversion);
+        case column_rep::int32:
+            return convert_column_counts<ToRep, std::int32_t>(in, out, count, conversion);
+        case column_rep::int64:
+            return convert_column_counts<ToRep, std::int64_t>(in, out, count, conversion);
+    }
+}
+
+inline std::size_t align_offset(std::size_t offset)
+{
+    return (offset + columnar_alignment - 1) / columnar_alignment * columnar_alignment;
+}
+
+}
+
+// Collects columns (without copying them) and writes them into one file
+class columnar_writer {
+public:
+    template<class Quantity>
+    columnar_writer &add(const std::string &name, span<const Quantity> values)
+    {
+        if (name.empty() || name.size() >= detail::columnar_name_size) {
+            throw columnar_error("column name must have 1 to "
+                                 + std::to_string(detail::columnar_name_size - 1) + " characters");
+        }
+        for (const auto &column : m_columns) {
+            if (column.name == name) {
+                throw columnar_error("duplicate column " + name);
+            }
+        }
+
+        m_columns.push_back(detail::describe_column<Quantity>(name, values.size()));
+        m_data.push_back(detail::rep_data(values.data()));
+        return *this;
+    }
+
+    template<class Quantity>
+    columnar_writer &add(const std::string &name, span<Quantity> values)
+    { return add(name, span<const Quantity>(values)); }
+
+    template<class Quantity>
+    columnar_writer &add(const std::string &name, const std::vector<Quantity> &values)
+    { return add(name, span<const Quantity>(values.data(), values.size())); }
+
+    template<class Quantity>
+    columnar_writer &add(const std::string &name, const quantity_vector<Quantity> &values)
+    {
+        return add(name, span<const Quantity>(reinterpret_cast<const Quantity *>(values.data()),
+                                              values.size()));
+    }
+
+    void write(const std::string &path) const
+    {
+        std::FILE *file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) {
+            throw columnar_error("can not create " + path);
+        }
+
+        try {
+            write(file);
+        } catch (...) {
+            std::fclose(file);
+            throw;
+        }
+        if (std::fclose(file) != 0) {
+            throw columnar_error("can not write " + path);
+        }
+    }
+
+private:
+    void write(std::FILE *file) const
+    {
+        detail::columnar_file_header header = {};
+        std::memcpy(header.magic, detail::columnar_magic(), sizeof(header.magic));
+        header.byte_order = detail::columnar_byte_order;
+        header.version = detail::columnar_version;
+        header.column_count = m_columns.size();
+        write(file, &header, sizeof(header));
+
+        std::size_t offset = detail::align_offset(
+            sizeof(header) + m_columns.size() * sizeof(detail::columnar_column_header));
+        for (const auto &column : m_columns) {
+            detail::columnar_column_header column_header = {};
+            std::memcpy(column_header.name, column.name.data(), column.name.size());
+            column_header.dimension = static_cast<std::uint8_t>(column.dimension);
+            column_header.rep = static_cast<std::uint8_t>(column.rep);
+            column_header.ratio_num = column.ratio_num;
+            column_header.ratio_den = column.ratio_den;
+            column_header.offset = offset;
+            column_header.size = column.size;
+            write(file, &column_header, sizeof(column_header));
+            offset = detail::align_offset(offset + column.size * detail::column_rep_size(column.rep));
+        }
+
+        std::size_t position = sizeof(header) + m_columns.size() * sizeof(detail::columnar_column_header);
+        for (std::size_t i = 0; i < m_columns.size(); ++i) {
+            pad(file, detail::align_offset(position) - position);
+            position = detail::align_offset(position);
+
+            const auto bytes = m_columns[i].size * detail::column_rep_size(m_columns[i].rep);
+            write(file, m_data[i], bytes);
+            position += bytes;
+        }
+    }
+
+    static void write(std::FILE *file, const void *data, std::size_t bytes)
+    {
+        if (bytes != 0 && std::fwrite(data, 1, bytes, file) != bytes) {
+            throw columnar_error("write failed");
+        }
+    }
+
+    static void pad(std::FILE *file, std::size_t bytes)
+    {
+        static const char zeros[64] = {};
+        while (bytes > 0) {
+            const auto chunk = std::min(bytes, sizeof(zeros));
+            write(file, zeros, chunk);
+            bytes -= chunk;
+        }
+    }
+
+    std::vector<column_info> m_columns;
+    std::vector<const void *> m_data;
+};
+
+class columnar_file;
+
+// Column converted into Quantity one chunk at a time. Chunks of a column already stored
+// in Quantity units are returned in place, others are converted into an internal buffer
+// on access, so only the pages of the requested chunks are ever read. A reader refers to
+// the mapping, not to the columnar_file, and stays valid when the file object is moved.
+template<class Quantity>
+class column_reader {
+public:
+    using rep = typename Quantity::rep;
+
+    column_reader(const mapped_file &file,
+                  const column_info &column,
+                  std::size_t offset,
+                  std::size_t chunk_size)
+        : m_mapping(file.data()),
+          m_mapping_size(file.size()),
+          m_column(column),
+          m_data(file.data() + offset),
+          m_chunk_size(chunk_size == 0 ? 1 : chunk_size),
+          m_conversion(column.ratio_num,
+                       column.ratio_den,
+                       detail::quantity_traits<Quantity>::ratio::num,
+                       detail::quantity_traits<Quantity>::ratio::den),
+          m_zero_copy(detail::same_unit<Quantity>(column))
+    {}
+
+    std::size_t size() const
+    { return m_column.size; }
+
+    const column_info &info() const
+    { return m_column; }
+
+    // Whether chunks are returned without any conversion
+    bool zero_copy() const
+    { return m_zero_copy; }
+
+    std::size_t chunk_size() const
+    { return m_chunk_size; }
+
+    std::size_t chunk_count() const
+    { return (m_column.size + m_chunk_size - 1) / m_chunk_size; }
+
+    // Values [index * chunk_size(), ...), valid until the next call on this reader
+    span<const Quantity> chunk(std::size_t index)
+    {
+        const auto offset = index * m_chunk_size;
+        const auto count = std::min(m_chunk_size, m_column.size - std::min(offset, m_column.size));
+        if (m_zero_copy) {
+            return span<const Quantity>(
+                reinterpret_cast<const Quantity *>(m_data) + offset, count);
+        }
+
+        m_buffer.resize(count);
+        read(offset, span<Quantity>(m_buffer.data(), count));
+        return span<const Quantity>(m_buffer.data(), count);
+    }
+
+    // Converts min(out.size(), size() - offset) values starting at offset,
+    // returns the number of converted values
+    std::size_t read(std::size_t offset, span<Quantity> out) const
+    {
+        const auto count = std::min(out.size(), m_column.size - std::min(offset, m_column.size));
+        const auto width = detail::column_rep_size(m_column.rep);
+        detail::will_need(m_mapping,
+                          m_mapping_size,
+                          static_cast<std::size_t>(m_data - m_mapping) + offset * width,
+                          count * width);
+        detail::convert_column_counts(m_data + offset * width,
+                                      m_column.rep,
+                                      detail::rep_data(out.data()),
+                                      count,
+                                      m_conversion);
+        return count;
+    }
+
+private:
+    const unsigned char *m_mapping;
+    std::size_t m_mapping_size;
+    column_info m_column;
+    const unsigned char *m_data;
+    std::size_t m_chunk_size;
+    detail::runtime_conversion<rep> m_conversion;
+    bool m_zero_copy;
+    std::vector<Quantity> m_buffer;
+};
+
+// Memory-mapped columnar file. Opening it reads the headers only, column data is paged
+// in when accessed.
+class columnar_file {
+public:
+    static constexpr std::size_t default_chunk_size = 1 << 16;
+
+    explicit columnar_file(const std::string &path) : m_file(path)
+    {
+        detail::columnar_file_header header;
+        if (m_file.size() < sizeof(header)) {
+            throw columnar_error(path + " is not a sipp columnar file");
+        }
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        if (std::memcmp(header.magic, detail::columnar_magic(), sizeof(header.magic)) != 0) {
+            throw columnar_error(path + " is not a sipp columnar file");
+        }
+        if (header.byte_order != detail::columnar_byte_order) {
+            throw columnar_error(path + " was written with another byte order");
+        }
+        if (header.version != detail::columnar_version) {
+            throw columnar_error(path + " has unsupported version " + std::to_string(header.version));
+        }
+        if (header.column_count > (m_file.size() - sizeof(header)) / sizeof(detail::columnar_column_header)) {
+            throw columnar_error(path + " is truncated");
+        }
+
+        for (std::uint64_t i = 0; i < header.column_count; ++i) {
+            detail::columnar_column_header column;
+            std::memcpy(&column,
+                        m_file.data() + sizeof(header) + i * sizeof(column),
+                        sizeof(column));
+            add_column(path, column);
+        }
+    }
+
+    std::size_t column_count() const
+    { return m_columns.size(); }
+
+    const column_info &column(std::size_t index) const
+    { return m_columns[index]; }
+
+    bool contains(const std::string &name) const
+    { return find(name) != m_columns.size(); }
+
+    const column_info &column(const std::string &name) const
+    { return m_columns[index_of(name)]; }
+
+    // Whether the column holds exactly Quantity values (same dimension, unit and representation)
+    template<class Quantity>
+    bool holds(const std::string &name) const
+    { return detail::same_unit<Quantity>(column(name)); }
+
+    // Zero-copy view of a column stored in Quantity units
+    template<class Quantity>
+    span<const Quantity> values(const std::string &name) const
+    {
+        const auto index = index_of(name);
+        if (!detail::same_unit<Quantity>(m_columns[index])) {
+            throw columnar_error("column " + name + " is stored in other units, use reader<>()");
+        }
+        return span<const Quantity>(
+            reinterpret_cast<const Quantity *>(m_file.data() + m_offsets[index]),
+            m_columns[index].size);
+    }
+
+    // Column of the same dimension in any unit, converted into Quantity chunk by chunk
+    template<class Quantity>
+    column_reader<Quantity> reader(const std::string &name,
+                                   std::size_t chunk_size = default_chunk_size) const
+    {
+        const auto index = index_of(name);
+        if (m_columns[index].dimension != detail::describe_column<Quantity>(name, 0).dimension) {
+            throw columnar_error("column " + name + " has another dimension");
+        }
+        return column_reader<Quantity>(m_file, m_columns[index], m_offsets[index], chunk_size);
+    }
+
+    // All values of a column converted into Quantity
+    template<class Quantity>
+    quantity_vector<Quantity> load(const std::string &name) const
+    {
+        auto source = reader<Quantity>(name);
+        quantity_vector<Quantity> result(source.size());
+        source.read(0, span<Quantity>(reinterpret_cast<Quantity *>(result.data()), result.size()));
+        return result;
+    }
+
+private:
+    void add_column(const std::string &path, const detail::columnar_column_header &header)
+    {
+        const auto rep = static_cast<column_rep>(header.rep);
+        const auto dimension = static_cast<column_dimension>(header.dimension);
+        const auto width = detail::column_rep_size(rep);
+        const auto name_length = std::find(header.name, header.name + sizeof(header.name), '\0')
+            - header.name;
+
+        if (width == 0 || (dimension != column_dimension::distance && dimension != column_dimension::speed)
+            || header.ratio_num <= 0 || header.ratio_den <= 0
+            || header.offset % detail::columnar_alignment != 0 || header.offset > m_file.size()
+            || header.size > (m_file.size() - header.offset) / width) {
+            throw columnar_error(path + " has a corrupted column header");
+        }
+
+        m_columns.push_back(column_info{std::string(header.name, static_cast<std::size_t>(name_length)),
+                                        dimension,
+                                        rep,
+                                        static_cast<std::intmax_t>(header.ratio_num),
+                                        static_cast<std::intmax_t>(header.ratio_den),
+                                        static_cast<std::size_t>(header.size)});
+        m_offsets.push_back(static_cast<std::size_t>(header.offset));
+    }
+
+    std::size_t find(const std::string &name) const
+    {
+        for (std::size_t i = 0; i < m_columns.size(); ++i) {
+            if (m_columns[i].name == name) {
+                return i;
+            }
+        }
+        return m_columns.size();
+    }
+
+    std::size_t index_of(const std::string &name) const
+    {
+        const auto index = find(name);
+        if (index == m_columns.size()) {
+            throw columnar_error("no column " + name);
+        }
+        return index;
+    }
+
+    mapped_file m_file;
+    std::vector<column_info> m_columns;
+    std::vector<std::size_t> m_offsets;
+};
+
+}
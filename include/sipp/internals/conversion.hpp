@@ -0,0 +1,392 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+#include "dimension.hpp"
+
+namespace sipp {
+
+// Rounding policies for conversions into integral representations,
+// e.g. sipp::distance_cast<sipp::Distance<int>, sipp::rounding::to_nearest>(distance)
+namespace rounding {
+
+// Truncation, as static_cast and std::chrono::duration_cast (default)
+struct toward_zero {};
+
+// Largest value not greater than the exact result
+struct downward {};
+
+// Smallest value not less than the exact result
+struct upward {};
+
+// Nearest value, halfway cases to even
+struct to_nearest {};
+
+}
+
+// Same unit as Quantity with another representation, e.g. rebind_rep<f32::Knots, double> is
+// Knots, specialized next to each quantity template
+template<class Quantity, class Rep>
+struct rebind_rep;
+
+namespace detail {
+
+// Intermediate type for exact integral scaling: value * num never overflows
+// for 64 bit values where 128 bit integers are available
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef __int128 wide_int;
+#else
+using wide_int = std::intmax_t;
+#endif
+
+constexpr wide_int round_quotient(wide_int quotient, wide_int, wide_int, rounding::toward_zero)
+{
+    return quotient;
+}
+
+constexpr wide_int round_quotient(wide_int quotient, wide_int remainder, wide_int, rounding::downward)
+{
+    return remainder < 0 ? quotient - 1 : quotient;
+}
+
+constexpr wide_int round_quotient(wide_int quotient, wide_int remainder, wide_int, rounding::upward)
+{
+    return remainder > 0 ? quotient + 1 : quotient;
+}
+
+constexpr wide_int round_quotient(wide_int quotient,
+                                  wide_int remainder,
+                                  wide_int divisor,
+                                  rounding::to_nearest)
+{
+    return (remainder < 0 ? -remainder : remainder) * 2 > divisor
+               || ((remainder < 0 ? -remainder : remainder) * 2 == divisor && quotient % 2 != 0)
+           ? quotient + (remainder < 0 ? -1 : 1)
+           : quotient;
+}
+
+template<class ToRep, class Float>
+constexpr ToRep round_floating(const Float &value, rounding::toward_zero)
+{
+    return static_cast<ToRep>(value);
+}
+
+template<class ToRep, class Float>
+constexpr ToRep round_floating(const Float &value, rounding::downward)
+{
+    return static_cast<Float>(static_cast<ToRep>(value)) > value ? static_cast<ToRep>(value) - 1
+                                                                 : static_cast<ToRep>(value);
+}
+
+template<class ToRep, class Float>
+constexpr ToRep round_floating(const Float &value, rounding::upward)
+{
+    return static_cast<Float>(static_cast<ToRep>(value)) < value ? static_cast<ToRep>(value) + 1
+                                                                 : static_cast<ToRep>(value);
+}
+
+template<class ToRep, class Float>
+constexpr ToRep round_floating(const Float &value, rounding::to_nearest)
+{
+    return value - static_cast<Float>(static_cast<ToRep>(value)) > static_cast<Float>(0.5)
+               || (value - static_cast<Float>(static_cast<ToRep>(value)) == static_cast<Float>(0.5)
+                   && static_cast<ToRep>(value) % 2 != 0)
+           ? static_cast<ToRep>(value) + 1
+           : (value - static_cast<Float>(static_cast<ToRep>(value)) < static_cast<Float>(-0.5)
+                  || (value - static_cast<Float>(static_cast<ToRep>(value)) == static_cast<Float>(-0.5)
+                      && static_cast<ToRep>(value) % 2 != 0)
+              ? static_cast<ToRep>(value) - 1
+              : static_cast<ToRep>(value));
+}
+
+// Representation in which a conversion is computed (same rule as std::chrono::duration_cast):
+// integral only when both representations are integral, otherwise the widest floating type.
+template<class ToRep, class FromRep>
+using conversion_rep = typename std::common_type<ToRep, FromRep, std::intmax_t>::type;
+
+constexpr std::intmax_t static_gcd(std::intmax_t a, std::intmax_t b)
+{
+    return b == 0 ? (a < 0 ? -a : a) : static_gcd(b, a % b);
+}
+
+constexpr std::intmax_t static_lcm(std::intmax_t a, std::intmax_t b)
+{
+    return a / static_gcd(a, b) * b;
+}
+
+// Largest unit both ratios are integral multiples of (same as std::common_type of durations)
+template<class Ratio1, class Ratio2>
+using ratio_gcd = std::ratio<static_gcd(Ratio1::num, Ratio2::num),
+                             static_lcm(Ratio1::den, Ratio2::den)>;
+
+// Smallest unit which is an integral multiple of both ratios
+template<class Ratio1, class Ratio2>
+using ratio_lcm = std::ratio<static_lcm(Ratio1::num, Ratio2::num),
+                             static_gcd(Ratio1::den, Ratio2::den)>;
+
+// Reuses the spelling of an operand ratio when it equals Result, so that
+// e.g. Meters and Kilometers have exactly Meters as common type
+template<class Result, class Ratio1, class Ratio2>
+using preferred_ratio = typename std::conditional<
+    std::ratio_equal<Result, Ratio1>::value,
+    Ratio1,
+    typename std::conditional<std::ratio_equal<Result, Ratio2>::value, Ratio2, Result>::type>::type;
+
+// Common unit of two distances (or of two quantities measured per unit)
+template<class Ratio1, class Ratio2>
+using common_ratio = preferred_ratio<ratio_gcd<Ratio1, Ratio2>, Ratio1, Ratio2>;
+
+// Common time period of two speeds, the speed unit being distance per period
+template<class Ratio1, class Ratio2>
+using common_period = preferred_ratio<ratio_lcm<Ratio1, Ratio2>, Ratio1, Ratio2>;
+
+// Whether a value converted with Factor from FromRep into ToRep can not lose precision
+template<class ToRep, class FromRep, class Factor>
+using is_lossless_conversion = std::integral_constant<
+    bool,
+    std::is_floating_point<ToRep>::value
+        || (Factor::den == 1 && !std::is_floating_point<FromRep>::value)>;
+
+// Scales a value by a compile-time rational factor. The factor is folded once per
+// (Factor, Rep) pair, so every conversion costs at most one multiplication
+// (or one multiplication and one division for non-trivial integral ratios).
+template<class Factor,
+    class Rep,
+    bool IsFloating = std::is_floating_point<Rep>::value,
+    bool NumIsOne = Factor::num == 1,
+    bool DenIsOne = Factor::den == 1>
+struct ratio_scale;
+
+template<class Factor, class Rep, bool NumIsOne, bool DenIsOne>
+struct ratio_scale<Factor, Rep, true, NumIsOne, DenIsOne> {
+    static constexpr Rep factor = static_cast<Rep>(Factor::num) / static_cast<Rep>(Factor::den);
+
+    static constexpr Rep apply(const Rep &value)
+    { return value * factor; }
+};
+
+// Identity conversions, e.g. Meters -> Meters
+template<class Factor, class Rep>
+struct ratio_scale<Factor, Rep, true, true, true> {
+    static constexpr Rep apply(const Rep &value)
+    { return value; }
+};
+
+template<class Factor, class Rep>
+struct ratio_scale<Factor, Rep, false, true, true> {
+    static constexpr Rep apply(const Rep &value)
+    { return value; }
+};
+
+template<class Factor, class Rep>
+struct ratio_scale<Factor, Rep, false, true, false> {
+    static constexpr Rep apply(const Rep &value)
+    { return value / static_cast<Rep>(Factor::den); }
+};
+
+template<class Factor, class Rep>
+struct ratio_scale<Factor, Rep, false, false, true> {
+    static constexpr Rep apply(const Rep &value)
+    { return value * static_cast<Rep>(Factor::num); }
+};
+
+template<class Factor, class Rep>
+struct ratio_scale<Factor, Rep, false, false, false> {
+    static constexpr Rep apply(const Rep &value)
+    {
+        return static_cast<Rep>(static_cast<wide_int>(value) * Factor::num / Factor::den);
+    }
+};
+
+// Converts a raw count expressed in FromRatio units into ToRep counts of ToRatio units.
+// Integral conversions are computed exactly and rounded once according to Rounding.
+template<class ToRep,
+    class ToRatio,
+    class FromRep,
+    class FromRatio,
+    class Rounding = rounding::toward_zero>
+struct unit_conversion {
+    using factor = std::ratio_divide<FromRatio, ToRatio>;
+    using rep = conversion_rep<ToRep, FromRep>;
+    using scale = ratio_scale<factor, rep>;
+
+    static_assert(!std::is_integral<ToRep>::value || factor::den != 1
+                      || static_cast<std::uintmax_t>(factor::num)
+                          <= static_cast<std::uintmax_t>(std::numeric_limits<ToRep>::max()),
+                  "Conversion factor overflows the target representation");
+
+    static constexpr ToRep apply(const FromRep &value)
+    {
+        return convert(static_cast<rep>(value),
+                       std::is_floating_point<rep>(),
+                       std::integral_constant<bool,
+                                              std::is_same<Rounding, rounding::toward_zero>::value
+                                                  || factor::den == 1>());
+    }
+
+private:
+    // integral, exact or truncated
+    static constexpr ToRep convert(const rep &value, std::false_type, std::true_type)
+    { return static_cast<ToRep>(scale::apply(value)); }
+
+    // integral, rounded
+    static constexpr ToRep convert(const rep &value, std::false_type, std::false_type)
+    {
+        return static_cast<ToRep>(round_quotient(static_cast<wide_int>(value) * factor::num / factor::den,
+                                                 static_cast<wide_int>(value) * factor::num % factor::den,
+                                                 factor::den,
+                                                 Rounding()));
+    }
+
+    template<bool Exact>
+    static constexpr ToRep convert(const rep &value,
+                                   std::true_type,
+                                   std::integral_constant<bool, Exact>)
+    {
+        return convert_floating(scale::apply(value), std::is_floating_point<ToRep>());
+    }
+
+    static constexpr ToRep convert_floating(const rep &value, std::true_type)
+    { return static_cast<ToRep>(value); }
+
+    static constexpr ToRep convert_floating(const rep &value, std::false_type)
+    { return round_floating<ToRep>(value, Rounding()); }
+};
+
+// value * Factor / divisor computed with a single rounding, e.g. time = distance / speed
+template<class Factor, class ResultRep, class Rep, class DivisorRep>
+constexpr ResultRep scaled_quotient(const Rep &value, const DivisorRep &divisor, std::true_type)
+{
+    using rep = typename std::common_type<ResultRep, Rep, DivisorRep>::type;
+    return static_cast<ResultRep>(ratio_scale<Factor, rep>::apply(static_cast<rep>(value))
+                                      / static_cast<rep>(divisor));
+}
+
+template<class Factor, class ResultRep, class Rep, class DivisorRep>
+constexpr ResultRep scaled_quotient(const Rep &value, const DivisorRep &divisor, std::false_type)
+{
+    return static_cast<ResultRep>(static_cast<wide_int>(value) * Factor::num
+                                      / (static_cast<wide_int>(divisor) * Factor::den));
+}
+
+template<class Factor, class ResultRep, class Rep, class DivisorRep>
+constexpr ResultRep scaled_quotient(const Rep &value, const DivisorRep &divisor)
+{
+    return scaled_quotient<Factor, ResultRep>(
+        value,
+        divisor,
+        std::integral_constant<bool,
+                               std::is_floating_point<ResultRep>::value
+                                   || std::is_floating_point<Rep>::value
+                                   || std::is_floating_point<DivisorRep>::value>());
+}
+
+// Dimension and absolute ratio (relative to meters, seconds) of a quantity type,
+// specialized next to each quantity template
+template<class Quantity>
+struct quantity_traits;
+
+template<class...>
+struct void_type {
+    using type = void;
+};
+
+template<class T, class = void>
+struct is_quantity : std::false_type {};
+
+template<class T>
+struct is_quantity<T, typename void_type<typename quantity_traits<T>::dimension>::type>
+    : std::true_type {};
+
+using distance_dimension = dimensions::length;
+using speed_dimension = dimensions::velocity;
+
+// Compile-time factor converting FromQuantity counts into ToQuantity counts
+template<class ToQuantity, class FromQuantity>
+struct quantity_factor {
+    static_assert(std::is_same<typename quantity_traits<ToQuantity>::dimension,
+                               typename quantity_traits<FromQuantity>::dimension>::value,
+                  "Quantities of different dimensions can not be converted");
+
+    using type = std::ratio_divide<typename quantity_traits<FromQuantity>::ratio,
+                                   typename quantity_traits<ToQuantity>::ratio>;
+};
+
+// Factor of a double count from FromUnit into ToUnit
+template<class ToUnit, class FromUnit>
+constexpr double unit_factor()
+{
+    using factor = typename quantity_factor<ToUnit, FromUnit>::type;
+    return static_cast<double>(factor::num) / static_cast<double>(factor::den);
+}
+
+template<class ToQuantity, class FromQuantity>
+struct quantity_conversion
+    : unit_conversion<typename ToQuantity::rep,
+                      typename quantity_traits<ToQuantity>::ratio,
+                      typename FromQuantity::rep,
+                      typename quantity_traits<FromQuantity>::ratio> {
+    static_assert(std::is_same<typename quantity_traits<ToQuantity>::dimension,
+                               typename quantity_traits<FromQuantity>::dimension>::value,
+                  "Quantities of different dimensions can not be converted");
+};
+
+}
+}
+
+// Marks a conversion from the first type into the second: counted per thread with
+// SIPP_TRACE_CONVERSIONS defined (see trace.hpp), nothing otherwise
+#ifdef SIPP_TRACE_CONVERSIONS
+#define SIPP_TRACE_CONVERSION(...) ::sipp::detail::trace_conversion<__VA_ARGS__>()
+#include "trace.hpp"
+#else
+#define SIPP_TRACE_CONVERSION(...)
+#endif
+
+namespace sipp {
+namespace detail {
+
+// Counts of two quantities of the same dimension brought to one scale for comparison.
+// Floating counts: the right-hand count is scaled into the left-hand unit by a single
+// folded factor. Integral counts: both are converted exactly into the common type.
+template<class Quantity1,
+    class Quantity2,
+    bool IsFloating = std::is_floating_point<
+        conversion_rep<typename Quantity1::rep, typename Quantity2::rep>>::value>
+struct comparable_counts {
+    using rep = conversion_rep<typename Quantity1::rep, typename Quantity2::rep>;
+
+    static constexpr rep lhs(const Quantity1 &value)
+    { return static_cast<rep>(value.count()); }
+
+    static constexpr rep rhs(const Quantity2 &value)
+    {
+        SIPP_TRACE_CONVERSION(Quantity2, Quantity1);
+        return ratio_scale<typename quantity_factor<Quantity1, Quantity2>::type, rep>::apply(
+            static_cast<rep>(value.count()));
+    }
+};
+
+template<class Quantity1, class Quantity2>
+struct comparable_counts<Quantity1, Quantity2, false> {
+    using common = typename std::common_type<Quantity1, Quantity2>::type;
+    using rep = typename common::rep;
+
+    static constexpr rep lhs(const Quantity1 &value)
+    {
+        SIPP_TRACE_CONVERSION(Quantity1, common);
+        return quantity_conversion<common, Quantity1>::apply(value.count());
+    }
+
+    static constexpr rep rhs(const Quantity2 &value)
+    {
+        SIPP_TRACE_CONVERSION(Quantity2, common);
+        return quantity_conversion<common, Quantity2>::apply(value.count());
+    }
+};
+
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+namespace sipp {
+
+// Physical dimension as a compile-time vector of exponents of the SI base quantities,
+// e.g. acceleration = dimension<1, 0, -2> (length / time^2). Plane angle is counted as a
+// base quantity of its own so that angles do not mix with plain ratios.
+template<int Length, int Mass, int Time, int Angle = 0>
+struct dimension {
+    static constexpr int length = Length;
+    static constexpr int mass = Mass;
+    static constexpr int time = Time;
+    static constexpr int angle = Angle;
+};
+
+template<class Dimension1, class Dimension2>
+using dimension_multiply = dimension<Dimension1::length + Dimension2::length,
+                                     Dimension1::mass + Dimension2::mass,
+                                     Dimension1::time + Dimension2::time,
+                                     Dimension1::angle + Dimension2::angle>;
+
+template<class Dimension1, class Dimension2>
+using dimension_divide = dimension<Dimension1::length - Dimension2::length,
+                                   Dimension1::mass - Dimension2::mass,
+                                   Dimension1::time - Dimension2::time,
+                                   Dimension1::angle - Dimension2::angle>;
+
+namespace dimensions {
+
+using dimensionless = dimension<0, 0, 0>;
+using length = dimension<1, 0, 0>;
+using mass = dimension<0, 1, 0>;
+using time = dimension<0, 0, 1>;
+using area = dimension<2, 0, 0>;
+using velocity = dimension<1, 0, -1>;
+using acceleration = dimension<1, 0, -2>;
+using angle = dimension<0, 0, 0, 1>;
+using angular_velocity = dimension<0, 0, -1, 1>;
+
+}
+
+}
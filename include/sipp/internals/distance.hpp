@@ -2,20 +2,71 @@
 
 #include <type_traits>
 #include <ratio>
-#include <cmath>
 
+#include "conversion.hpp"
 #include "distance_fwd.hpp"
 
 namespace sipp {
 
-template<class ToDistance, class Rep, class Ratio>
+namespace detail {
+
+template<class Rep, class Ratio>
+struct quantity_traits<Distance<Rep, Ratio>> {
+    using dimension = distance_dimension;
+    using ratio = Ratio;
+};
+
+}
+
+template<class Rep0, class Ratio, class Rep>
+struct rebind_rep<Distance<Rep0, Ratio>, Rep> {
+    using type = Distance<Rep, Ratio>;
+};
+
+}
+
+namespace std {
+
+// Distance able to represent both operands exactly, as for std::chrono::duration
+template<class Rep1, class Ratio1, class Rep2, class Ratio2>
+struct common_type<sipp::Distance<Rep1, Ratio1>, sipp::Distance<Rep2, Ratio2>> {
+    using type = sipp::Distance<typename common_type<Rep1, Rep2>::type,
+                                sipp::detail::common_ratio<Ratio1, Ratio2>>;
+};
+
+}
+
+namespace sipp {
+
+template<class ToDistance, class Rounding = rounding::toward_zero, class Rep, class Ratio>
 constexpr ToDistance distance_cast(const Distance<Rep, Ratio> &distance)
 {
-    return ToDistance(static_cast<typename ToDistance::rep>(
-                          (static_cast<double>(ToDistance::ratio::den)
-                              / static_cast<double>(ToDistance::ratio::num))
-                              * (static_cast<double>(Ratio::num) / static_cast<double>(Ratio::den))
-                              * distance.count()));
+    SIPP_TRACE_CONVERSION(Distance<Rep, Ratio>, ToDistance);
+    using conversion = detail::unit_conversion<typename ToDistance::rep,
+                                               typename ToDistance::ratio,
+                                               Rep,
+                                               Ratio,
+                                               Rounding>;
+
+    return ToDistance(conversion::apply(distance.count()));
+}
+
+template<class ToDistance, class Rep, class Ratio>
+constexpr ToDistance floor(const Distance<Rep, Ratio> &distance)
+{
+    return distance_cast<ToDistance, rounding::downward>(distance);
+}
+
+template<class ToDistance, class Rep, class Ratio>
+constexpr ToDistance ceil(const Distance<Rep, Ratio> &distance)
+{
+    return distance_cast<ToDistance, rounding::upward>(distance);
+}
+
+template<class ToDistance, class Rep, class Ratio>
+constexpr ToDistance round(const Distance<Rep, Ratio> &distance)
+{
+    return distance_cast<ToDistance, rounding::to_nearest>(distance);
 }
 
 template<class Rep, class Ratio = std::ratio<1>>
@@ -33,18 +84,20 @@ public:
 
     template<class Rep2, class Ratio2>
     constexpr Distance(const Distance<Rep2, Ratio2> &other)
+        : m_count(distance_cast<Distance<Rep, Ratio>>(other).count())
     {
-        *this = other;
+        static_assert(detail::is_lossless_conversion<Rep,
+                                                     Rep2,
+                                                     std::ratio_divide<Ratio2, Ratio>>::value,
+                      "Use sipp::distance_cast<> to perform explicit cast of integer types "
+                          "(possible precision loss)");
     }
 
     template<class Rep2, class Ratio2>
-    constexpr void operator=(const Distance<Rep2, Ratio2> &other)
+    constexpr Distance<Rep, Ratio> &operator=(const Distance<Rep2, Ratio2> &other)
     {
-        static_assert(std::is_floating_point<Rep>::value
-                          && std::is_floating_point<Rep2>::value,
-                      "Use sipp::distance_cast<> to perform explicit cast of integer types "
-                          "(possible precision loss)");
-        *this = distance_cast<Distance<Rep, Ratio>>(other);
+        *this = Distance<Rep, Ratio>(other);
+        return *this;
     }
 
     template<class Rep2, class Ratio2>
@@ -78,13 +131,15 @@ public:
     template<class Rep2, class Ratio2>
     constexpr bool operator<(const Distance<Rep2, Ratio2> &other) const
     {
-        return m_count < distance_cast<Distance<Rep, Ratio>>(other).m_count;
+        using counts = detail::comparable_counts<Distance<Rep, Ratio>, Distance<Rep2, Ratio2>>;
+        return counts::lhs(*this) < counts::rhs(other);
     }
 
     template<class Rep2, class Ratio2>
     constexpr bool operator<=(const Distance<Rep2, Ratio2> &other) const
     {
-        return m_count <= distance_cast<Distance<Rep, Ratio>>(other).m_count;
+        using counts = detail::comparable_counts<Distance<Rep, Ratio>, Distance<Rep2, Ratio2>>;
+        return counts::lhs(*this) <= counts::rhs(other);
     }
 
     template<class Rep2, class Ratio2>
@@ -102,7 +157,14 @@ public:
     template<class Rep2, class Ratio2>
     constexpr bool operator==(const Distance<Rep2, Ratio2> &other) const
     {
-        return m_count == distance_cast<Distance<Rep, Ratio>>(other).m_count;
+        using counts = detail::comparable_counts<Distance<Rep, Ratio>, Distance<Rep2, Ratio2>>;
+        return counts::lhs(*this) == counts::rhs(other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator!=(const Distance<Rep2, Ratio2> &other) const
+    {
+        return !(*this == other);
     }
 
     constexpr Distance<Rep, Ratio> operator-() const
@@ -115,7 +177,7 @@ public:
 
     constexpr Distance<Rep, Ratio> abs() const
     {
-        return Distance<Rep, Ratio>(std::abs(m_count));
+        return Distance<Rep, Ratio>(m_count < Rep(0) ? -m_count : m_count);
     }
 
 private:
@@ -151,71 +213,19 @@ constexpr Distance<Rep, Ratio> operator/(const Distance<Rep, Ratio> &distance, c
 }
 
 template<class Rep1, class Ratio1, class Rep2, class Ratio2>
-constexpr Distance<Rep1, Ratio1> operator+(const Distance<Rep1, Ratio1> &distance1,
-                                           const Distance<Rep2, Ratio2> &distance2)
+constexpr typename std::common_type<Distance<Rep1, Ratio1>, Distance<Rep2, Ratio2>>::type
+operator+(const Distance<Rep1, Ratio1> &distance1, const Distance<Rep2, Ratio2> &distance2)
 {
-    const Distance<Rep1, Ratio1> converted_distance2 = distance2;
-    return Distance<Rep1, Ratio1>(distance1.count() + converted_distance2.count());
+    using common = typename std::common_type<Distance<Rep1, Ratio1>, Distance<Rep2, Ratio2>>::type;
+    return common(distance_cast<common>(distance1).count() + distance_cast<common>(distance2).count());
 }
 
 template<class Rep1, class Ratio1, class Rep2, class Ratio2>
-constexpr Distance<Rep1, Ratio1> operator-(const Distance<Rep1, Ratio1> &distance1,
-                                           const Distance<Rep2, Ratio2> &distance2)
+constexpr typename std::common_type<Distance<Rep1, Ratio1>, Distance<Rep2, Ratio2>>::type
+operator-(const Distance<Rep1, Ratio1> &distance1, const Distance<Rep2, Ratio2> &distance2)
 {
-    const Distance<Rep1, Ratio1> converted_distance2 = distance2;
-    return Distance<Rep1, Ratio1>(distance1.count() - converted_distance2.count());
-}
-
-namespace literals {
-
-constexpr Meters operator "" _m(long double value)
-{ return Meters(value); }
-
-constexpr Meters operator "" _m(unsigned long long int value)
-{ return Meters(value); }
-
-constexpr Kilometers operator "" _km(long double value)
-{ return Kilometers(value); }
-
-constexpr Kilometers operator "" _km(unsigned long long int value)
-{ return Kilometers(value); }
-
-constexpr Millimeters operator "" _mm(long double value)
-{ return Millimeters(value); }
-
-constexpr Millimeters operator "" _mm(unsigned long long int value)
-{ return Millimeters(value); }
-
-constexpr Micrometers operator "" _um(long double value)
-{ return Micrometers(value); }
-
-constexpr Micrometers operator "" _um(unsigned long long int value)
-{ return Micrometers(value); }
-
-constexpr Nanometers operator "" _nm(long double value)
-{ return Nanometers(value); }
-
-constexpr Nanometers operator "" _nm(unsigned long long int value)
-{ return Nanometers(value); }
-
-constexpr Feet operator "" _ft(long double value)
-{ return Feet(value); }
-
-constexpr Feet operator "" _ft(unsigned long long int value)
-{ return Feet(value); }
-
-constexpr NauticalMiles operator "" _NM(long double value)
-{ return NauticalMiles(value); }
-
-constexpr NauticalMiles operator "" _NM(unsigned long long int value)
-{ return NauticalMiles(value); }
-
-constexpr StatuteMiles operator "" _mi(long double value)
-{ return StatuteMiles(value); }
-
-constexpr StatuteMiles operator "" _mi(unsigned long long int value)
-{ return StatuteMiles(value); }
-
+    using common = typename std::common_type<Distance<Rep1, Ratio1>, Distance<Rep2, Ratio2>>::type;
+    return common(distance_cast<common>(distance1).count() - distance_cast<common>(distance2).count());
 }
 
 }
@@ -16,4 +16,18 @@ using Feet = Distance<double, std::ratio<3048, 10000>>;
 using NauticalMiles = Distance<double, std::ratio<1852, 1>>;
 using StatuteMiles = Distance<double, std::ratio<160934, 100>>;
 
+// Single precision variants, e.g. sipp::f32::Meters
+namespace f32 {
+
+using Meters = Distance<float, std::ratio<1>>;
+using Kilometers = Distance<float, std::kilo>;
+using Millimeters = Distance<float, std::milli>;
+using Micrometers = Distance<float, std::micro>;
+using Nanometers = Distance<float, std::nano>;
+using Feet = Distance<float, std::ratio<3048, 10000>>;
+using NauticalMiles = Distance<float, std::ratio<1852, 1>>;
+using StatuteMiles = Distance<float, std::ratio<160934, 100>>;
+
+}
+
 }
@@ -0,0 +1,489 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "batch.hpp"
+#include "conversion.hpp"
+#include "distance.hpp"
+#include "format.hpp"
+#include "parse.hpp"
+#include "span.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+// Units of the predefined typedefs, for quantities whose unit is only known at run time
+// (configuration, message headers). Listed in the order of distance_fwd.hpp/speed_fwd.hpp.
+enum class distance_unit : unsigned char {
+    meters,
+    kilometers,
+    millimeters,
+    micrometers,
+    nanometers,
+    feet,
+    nautical_miles,
+    statute_miles
+};
+
+enum class speed_unit : unsigned char {
+    km_per_hour,
+    meters_per_second,
+    feet_per_second,
+    feet_per_minute,
+    knots,
+    miles_per_hour
+};
+
+namespace detail {
+
+template<class... Units>
+struct unit_list {
+    static constexpr std::size_t size = sizeof...(Units);
+};
+
+// Every predefined unit of a dimension, in the order of its unit id enum
+template<class UnitId>
+struct unit_registry;
+
+template<>
+struct unit_registry<distance_unit> {
+    using dimension = distance_dimension;
+    using units = unit_list<Meters, Kilometers, Millimeters, Micrometers, Nanometers, Feet, NauticalMiles,
+                            StatuteMiles>;
+    // offset of the first unit in parsed_unit
+    static constexpr std::size_t parsed_offset = static_cast<std::size_t>(parsed_unit::meters);
+};
+
+template<>
+struct unit_registry<speed_unit> {
+    using dimension = speed_dimension;
+    using units = unit_list<KmPerHour, MetersPerSecond, FeetPerSecond, FeetPerMinute, Knots, MilesPerHour>;
+    static constexpr std::size_t parsed_offset = static_cast<std::size_t>(parsed_unit::km_per_hour);
+};
+
+// from_chars turns a parsed_unit into a unit id by subtracting the offset of its dimension,
+// which holds as long as every unit id has the position of its parsed_unit
+template<class UnitId>
+constexpr bool pairs_with(UnitId unit, parsed_unit parsed)
+{
+    return static_cast<std::size_t>(unit) + unit_registry<UnitId>::parsed_offset == static_cast<std::size_t>(parsed);
+}
+
+static_assert(pairs_with(distance_unit::meters, parsed_unit::meters)
+                  && pairs_with(distance_unit::kilometers, parsed_unit::kilometers)
+                  && pairs_with(distance_unit::millimeters, parsed_unit::millimeters)
+                  && pairs_with(distance_unit::micrometers, parsed_unit::micrometers)
+                  && pairs_with(distance_unit::nanometers, parsed_unit::nanometers)
+                  && pairs_with(distance_unit::feet, parsed_unit::feet)
+                  && pairs_with(distance_unit::nautical_miles, parsed_unit::nautical_miles)
+                  && pairs_with(distance_unit::statute_miles, parsed_unit::statute_miles),
+              "distance_unit must list the distances of parsed_unit in the same order");
+static_assert(pairs_with(speed_unit::km_per_hour, parsed_unit::km_per_hour)
+                  && pairs_with(speed_unit::meters_per_second, parsed_unit::meters_per_second)
+                  && pairs_with(speed_unit::feet_per_second, parsed_unit::feet_per_second)
+                  && pairs_with(speed_unit::feet_per_minute, parsed_unit::feet_per_minute)
+                  && pairs_with(speed_unit::knots, parsed_unit::knots)
+                  && pairs_with(speed_unit::miles_per_hour, parsed_unit::miles_per_hour),
+              "speed_unit must list the speeds of parsed_unit in the same order");
+static_assert(unit_registry<distance_unit>::parsed_offset + unit_registry<distance_unit>::units::size
+                      == unit_registry<speed_unit>::parsed_offset
+                  && unit_registry<speed_unit>::parsed_offset + unit_registry<speed_unit>::units::size
+                      == static_cast<std::size_t>(parsed_unit::count),
+              "Every parsed unit needs a unit id");
+
+template<class Quantity, class Unit>
+using is_same_unit = std::integral_constant<
+    bool,
+    std::is_same<typename quantity_traits<Quantity>::dimension, typename quantity_traits<Unit>::dimension>::value
+        && std::ratio_equal<typename quantity_traits<Quantity>::ratio,
+                            typename quantity_traits<Unit>::ratio>::value>;
+
+// Position of the unit of Quantity (any representation) in the list, the list size if absent
+template<class Quantity, class List>
+struct unit_index;
+
+template<class Quantity>
+struct unit_index<Quantity, unit_list<>> : std::integral_constant<std::size_t, 0> {};
+
+template<class Quantity, class Unit, class... Units>
+struct unit_index<Quantity, unit_list<Unit, Units...>>
+    : std::integral_constant<std::size_t,
+                             is_same_unit<Quantity, Unit>::value
+                                 ? 0
+                                 : 1 + unit_index<Quantity, unit_list<Units...>>::value> {};
+
+// factors[to][from] between every pair of units, folded at compile time from the ratios
+// exactly as distance_cast/speed_cast fold them for double counts
+template<class List>
+struct factor_matrix;
+
+template<class... Units>
+struct factor_matrix<unit_list<Units...>> {
+    struct row {
+        double factors[sizeof...(Units)];
+    };
+
+    template<class ToUnit>
+    static constexpr row make_row()
+    { return row{{unit_factor<ToUnit, Units>()...}}; }
+
+    static constexpr row rows[sizeof...(Units)] = {make_row<Units>()...};
+};
+
+template<class... Units>
+constexpr typename factor_matrix<unit_list<Units...>>::row factor_matrix<unit_list<Units...>>::rows[];
+
+template<class UnitId>
+constexpr double dynamic_factor(UnitId to, UnitId from)
+{
+    return factor_matrix<typename unit_registry<UnitId>::units>::rows[static_cast<std::size_t>(to)]
+        .factors[static_cast<std::size_t>(from)];
+}
+
+template<class ToQuantity, class FromUnit>
+ToQuantity convert_from_unit(double count)
+{
+    return ToQuantity(quantity_conversion<ToQuantity, FromUnit>::apply(count));
+}
+
+template<class ToQuantity, class FromUnit>
+void convert_array_from_unit(const double *in, ToQuantity *out, std::size_t count)
+{
+    convert_reps<typename quantity_factor<ToQuantity, FromUnit>::type>(in, rep_data(out), count);
+}
+
+template<class ToUnit, class FromQuantity>
+void convert_array_to_unit(const FromQuantity *in, double *out, std::size_t count)
+{
+    convert_reps<typename quantity_factor<ToUnit, FromQuantity>::type>(rep_data(in), out, count);
+}
+
+// Per-unit tables of the above, indexed by unit id: a runtime unit costs one lookup
+// per value (or per array), never a switch over every unit
+template<class ToQuantity, class... Units>
+inline auto from_unit_converters(unit_list<Units...>) -> ToQuantity (*const *)(double)
+{
+    static ToQuantity (*const converters[])(double) = {&convert_from_unit<ToQuantity, Units>...};
+    return converters;
+}
+
+template<class ToQuantity, class... Units>
+inline auto array_from_unit_converters(unit_list<Units...>)
+    -> void (*const *)(const double *, ToQuantity *, std::size_t)
+{
+    static void (*const converters[])(const double *, ToQuantity *, std::size_t) = {
+        &convert_array_from_unit<ToQuantity, Units>...};
+    return converters;
+}
+
+template<class FromQuantity, class... Units>
+inline auto array_to_unit_converters(unit_list<Units...>)
+    -> void (*const *)(const FromQuantity *, double *, std::size_t)
+{
+    static void (*const converters[])(const FromQuantity *, double *, std::size_t) = {
+        &convert_array_to_unit<Units, FromQuantity>...};
+    return converters;
+}
+
+template<class Quantity>
+using dynamic_unit_of = typename std::conditional<
+    std::is_same<typename quantity_traits<Quantity>::dimension, distance_dimension>::value,
+    distance_unit,
+    speed_unit>::type;
+
+template<class Quantity>
+constexpr std::size_t dynamic_unit_index()
+{
+    return unit_index<Quantity, typename unit_registry<dynamic_unit_of<Quantity>>::units>::value;
+}
+
+template<class... Units>
+inline const char *unit_symbol_by_index(std::size_t index, unit_list<Units...>)
+{
+    static const char *const symbols[] = {unit_symbol<Units>::get()...};
+    return symbols[index];
+}
+
+}
+
+// Unit id of a predefined quantity type, e.g. unit_of<sipp::f32::Feet>() == distance_unit::feet
+template<class Quantity>
+constexpr detail::dynamic_unit_of<Quantity> unit_of()
+{
+    static_assert(detail::dynamic_unit_index<Quantity>()
+                      < detail::unit_registry<detail::dynamic_unit_of<Quantity>>::units::size,
+                  "Only units of the predefined typedefs have a runtime unit id");
+    return static_cast<detail::dynamic_unit_of<Quantity>>(detail::dynamic_unit_index<Quantity>());
+}
+
+inline const char *unit_symbol(distance_unit unit)
+{
+    return detail::unit_symbol_by_index(static_cast<std::size_t>(unit),
+                                        detail::unit_registry<distance_unit>::units());
+}
+
+inline const char *unit_symbol(speed_unit unit)
+{
+    return detail::unit_symbol_by_index(static_cast<std::size_t>(unit),
+                                        detail::unit_registry<speed_unit>::units());
+}
+
+// Double precision count tagged with a runtime unit id. Converting between runtime units
+// costs one multiplication by an entry of a compile-time factor matrix.
+template<class UnitId>
+class dynamic_quantity {
+public:
+    using rep = double;
+    using unit_type = UnitId;
+
+    constexpr dynamic_quantity() : m_count(0), m_unit()
+    {
+    }
+
+    constexpr dynamic_quantity(double count, UnitId unit) : m_count(count), m_unit(unit)
+    {
+    }
+
+    template<class Quantity,
+        class = typename std::enable_if<
+            std::is_same<typename detail::quantity_traits<Quantity>::dimension,
+                         typename detail::unit_registry<UnitId>::dimension>::value>::type>
+    constexpr dynamic_quantity(const Quantity &quantity)
+        : m_count(static_cast<double>(quantity.count())), m_unit(unit_of<Quantity>())
+    {
+    }
+
+    constexpr double count() const
+    {
+        return m_count;
+    }
+
+    constexpr UnitId unit() const
+    {
+        return m_unit;
+    }
+
+    // The same quantity expressed in another unit
+    constexpr dynamic_quantity in(UnitId unit) const
+    {
+        return dynamic_quantity(unit == m_unit ? m_count : m_count * detail::dynamic_factor(unit, m_unit), unit);
+    }
+
+    constexpr dynamic_quantity operator+() const
+    {
+        return *this;
+    }
+
+    constexpr dynamic_quantity operator-() const
+    {
+        return dynamic_quantity(-m_count, m_unit);
+    }
+
+    dynamic_quantity &operator+=(const dynamic_quantity &other)
+    {
+        m_count += other.in(m_unit).m_count;
+        return *this;
+    }
+
+    dynamic_quantity &operator-=(const dynamic_quantity &other)
+    {
+        m_count -= other.in(m_unit).m_count;
+        return *this;
+    }
+
+    dynamic_quantity &operator*=(double factor)
+    {
+        m_count *= factor;
+        return *this;
+    }
+
+    dynamic_quantity &operator/=(double factor)
+    {
+        m_count /= factor;
+        return *this;
+    }
+
+    // Operands in different units are compared in the first unit of the dimension
+    constexpr bool operator<(const dynamic_quantity &other) const
+    {
+        return m_unit == other.m_unit ? m_count < other.m_count
+                                      : in(UnitId()).m_count < other.in(UnitId()).m_count;
+    }
+
+    constexpr bool operator>(const dynamic_quantity &other) const
+    {
+        return other < *this;
+    }
+
+    constexpr bool operator<=(const dynamic_quantity &other) const
+    {
+        return !(other < *this);
+    }
+
+    constexpr bool operator>=(const dynamic_quantity &other) const
+    {
+        return !(*this < other);
+    }
+
+    constexpr bool operator==(const dynamic_quantity &other) const
+    {
+        return m_unit == other.m_unit ? m_count == other.m_count
+                                      : in(UnitId()).m_count == other.in(UnitId()).m_count;
+    }
+
+    constexpr bool operator!=(const dynamic_quantity &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    double m_count;
+    UnitId m_unit;
+};
+
+using dynamic_distance = dynamic_quantity<distance_unit>;
+using dynamic_speed = dynamic_quantity<speed_unit>;
+
+// Sum and difference are expressed in the unit of the first operand
+template<class UnitId>
+constexpr dynamic_quantity<UnitId> operator+(const dynamic_quantity<UnitId> &quantity1,
+                                             const dynamic_quantity<UnitId> &quantity2)
+{
+    return dynamic_quantity<UnitId>(quantity1.count() + quantity2.in(quantity1.unit()).count(), quantity1.unit());
+}
+
+template<class UnitId>
+constexpr dynamic_quantity<UnitId> operator-(const dynamic_quantity<UnitId> &quantity1,
+                                             const dynamic_quantity<UnitId> &quantity2)
+{
+    return dynamic_quantity<UnitId>(quantity1.count() - quantity2.in(quantity1.unit()).count(), quantity1.unit());
+}
+
+template<class UnitId>
+constexpr dynamic_quantity<UnitId> operator*(const dynamic_quantity<UnitId> &quantity, double factor)
+{
+    return dynamic_quantity<UnitId>(quantity.count() * factor, quantity.unit());
+}
+
+template<class UnitId>
+constexpr dynamic_quantity<UnitId> operator*(double factor, const dynamic_quantity<UnitId> &quantity)
+{
+    return dynamic_quantity<UnitId>(factor * quantity.count(), quantity.unit());
+}
+
+template<class UnitId>
+constexpr dynamic_quantity<UnitId> operator/(const dynamic_quantity<UnitId> &quantity, double divisor)
+{
+    return dynamic_quantity<UnitId>(quantity.count() / divisor, quantity.unit());
+}
+
+template<class UnitId>
+constexpr double operator/(const dynamic_quantity<UnitId> &quantity1, const dynamic_quantity<UnitId> &quantity2)
+{
+    return quantity1.count() / quantity2.in(quantity1.unit()).count();
+}
+
+// Conversions into compile-time units give exactly the result of distance_cast/speed_cast
+// from the corresponding typedef
+template<class ToDistance>
+inline ToDistance distance_cast(const dynamic_distance &distance)
+{
+    return detail::from_unit_converters<ToDistance>(detail::unit_registry<distance_unit>::units())
+        [static_cast<std::size_t>(distance.unit())](distance.count());
+}
+
+template<class ToSpeed>
+inline ToSpeed speed_cast(const dynamic_speed &speed)
+{
+    return detail::from_unit_converters<ToSpeed>(detail::unit_registry<speed_unit>::units())
+        [static_cast<std::size_t>(speed.unit())](speed.count());
+}
+
+// Batch conversions of arrays of raw counts tagged with a runtime unit. The unit is
+// dispatched once per array, elements go through the same kernels as sipp::convert.
+// Each converts min(in.size(), out.size()) elements and returns that number.
+template<class UnitId>
+inline std::size_t convert(span<const double> in, UnitId from, span<double> out, UnitId to)
+{
+    const auto count = std::min(in.size(), out.size());
+    if (from == to) {
+        std::copy(in.data(), in.data() + count, out.data());
+    } else {
+        detail::scale(in.data(), out.data(), count, detail::dynamic_factor(to, from));
+    }
+    return count;
+}
+
+template<class Quantity>
+inline std::size_t convert(span<const double> in, detail::dynamic_unit_of<Quantity> from, span<Quantity> out)
+{
+    using units = typename detail::unit_registry<detail::dynamic_unit_of<Quantity>>::units;
+
+    const auto count = std::min(in.size(), out.size());
+    detail::array_from_unit_converters<Quantity>(units())[static_cast<std::size_t>(from)](
+        in.data(), out.data(), count);
+    return count;
+}
+
+template<class Quantity>
+inline std::size_t convert(span<const Quantity> in, span<double> out, detail::dynamic_unit_of<Quantity> to)
+{
+    using units = typename detail::unit_registry<detail::dynamic_unit_of<Quantity>>::units;
+
+    const auto count = std::min(in.size(), out.size());
+    detail::array_to_unit_converters<Quantity>(units())[static_cast<std::size_t>(to)](
+        in.data(), out.data(), count);
+    return count;
+}
+
+// Parses a number and any unit suffix of the dimension, keeping the unit of the text
+template<class UnitId>
+inline from_chars_result from_chars(const char *first, const char *last, dynamic_quantity<UnitId> &value)
+{
+    using registry = detail::unit_registry<UnitId>;
+
+    double count = 0.0;
+    const char *position = detail::parse_decimal(first, last, count);
+    if (position == nullptr) {
+        return from_chars_result{first, parse_error::invalid_number};
+    }
+
+    detail::parsed_unit unit;
+    position = detail::parse_suffix(detail::skip_spaces(position, last), last, unit);
+    if (position == nullptr) {
+        return from_chars_result{first, parse_error::unknown_unit};
+    }
+
+    const auto index = static_cast<std::size_t>(unit) - registry::parsed_offset;
+    if (static_cast<std::size_t>(unit) < registry::parsed_offset || index >= registry::units::size) {
+        return from_chars_result{first, parse_error::dimension_mismatch};
+    }
+
+    value = dynamic_quantity<UnitId>(count, static_cast<UnitId>(index));
+    return from_chars_result{position, parse_error::none};
+}
+
+// Writes the count and the symbol of its runtime unit, as sipp::to_chars does
+template<class UnitId>
+inline to_chars_result to_chars(char *first, char *last, const dynamic_quantity<UnitId> &value)
+{
+    char buffer[max_formatted_size];
+    char *const number_end = detail::write_floating(buffer, buffer + sizeof(buffer), value.count());
+    const auto number_size = static_cast<std::size_t>(number_end - buffer);
+    const char *const symbol = unit_symbol(value.unit());
+    const auto symbol_size = std::strlen(symbol);
+
+    const auto available = static_cast<std::size_t>(last - first);
+    if (available < symbol_size || available - symbol_size < number_size) {
+        return to_chars_result{last, std::errc::value_too_large};
+    }
+
+    std::memcpy(first, buffer, number_size);
+    std::memcpy(first + number_size, symbol, symbol_size);
+    return to_chars_result{first + number_size + symbol_size, std::errc()};
+}
+
+}
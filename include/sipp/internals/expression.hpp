@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "conversion.hpp"
+#include "quantity_vector.hpp"
+#include "span.hpp"
+
+namespace sipp {
+namespace expr {
+
+// Expression templates over Distance and Speed. An expression is started with
+// sipp::expr::lazy() and evaluated once into a target unit: every term is scaled
+// by its own folded factor straight into that unit, without intermediate casts.
+//
+//   auto total = sipp::expr::evaluate<sipp::Meters>(lazy(a_km) + b_ft - c_NM * 2);
+//
+// Terms can be scalars or arrays (quantity_vector, quantity_view, span). Array
+// expressions are evaluated element-wise in a single loop by assign()/materialize().
+// Arithmetic with scalars happens in their common type with the target rep, the result
+// is converted to the target rep once, e.g. an integral target scaled by 1.5 is
+// truncated after the sum, not per term.
+//
+// Array terms refer to the data of their source, which must outlive the expression:
+// lazy() does not accept a temporary quantity_vector.
+template<class Derived>
+struct expression {
+    constexpr const Derived &self() const
+    { return static_cast<const Derived &>(*this); }
+};
+
+template<class Quantity>
+class scalar_term : public expression<scalar_term<Quantity>> {
+public:
+    using quantity = Quantity;
+    using dimension = typename detail::quantity_traits<Quantity>::dimension;
+    static constexpr bool is_array = false;
+
+    constexpr explicit scalar_term(const Quantity &value) : m_value(value)
+    {}
+
+    constexpr std::size_t size() const
+    { return 0; }
+
+    template<class To>
+    constexpr typename To::rep eval(std::size_t) const
+    { return detail::quantity_conversion<To, Quantity>::apply(m_value.count()); }
+
+private:
+    Quantity m_value;
+};
+
+template<class Quantity, class FromQuantity>
+class array_term : public expression<array_term<Quantity, FromQuantity>> {
+public:
+    using quantity = Quantity;
+    using dimension = typename detail::quantity_traits<Quantity>::dimension;
+    static constexpr bool is_array = true;
+
+    constexpr array_term(const typename FromQuantity::rep *data, std::size_t size)
+        : m_data(data), m_size(size)
+    {}
+
+    constexpr std::size_t size() const
+    { return m_size; }
+
+    template<class To>
+    constexpr typename To::rep eval(std::size_t index) const
+    { return detail::quantity_conversion<To, FromQuantity>::apply(m_data[index]); }
+
+private:
+    const typename FromQuantity::rep *m_data;
+    std::size_t m_size;
+};
+
+struct plus {
+    template<class Left, class Right>
+    static constexpr auto apply(const Left &left, const Right &right)
+    { return left + right; }
+};
+
+struct minus {
+    template<class Left, class Right>
+    static constexpr auto apply(const Left &left, const Right &right)
+    { return left - right; }
+};
+
+template<class Left, class Right, class Operation>
+class binary : public expression<binary<Left, Right, Operation>> {
+    static_assert(std::is_same<typename Left::dimension, typename Right::dimension>::value,
+                  "Quantities of different dimensions can not be added or subtracted");
+
+public:
+    using quantity = typename Left::quantity;
+    using dimension = typename Left::dimension;
+    static constexpr bool is_array = Left::is_array || Right::is_array;
+
+    constexpr binary(const Left &left, const Right &right) : m_left(left), m_right(right)
+    {}
+
+    constexpr std::size_t size() const
+    {
+        return Left::is_array && Right::is_array ? std::min(m_left.size(), m_right.size())
+                                                 : (Left::is_array ? m_left.size() : m_right.size());
+    }
+
+    template<class To>
+    constexpr auto eval(std::size_t index) const
+    {
+        return Operation::apply(m_left.template eval<To>(index), m_right.template eval<To>(index));
+    }
+
+private:
+    Left m_left;
+    Right m_right;
+};
+
+template<class Operand, class Scalar>
+class scaled : public expression<scaled<Operand, Scalar>> {
+public:
+    using quantity = typename Operand::quantity;
+    using dimension = typename Operand::dimension;
+    static constexpr bool is_array = Operand::is_array;
+
+    constexpr scaled(const Operand &operand, const Scalar &multiplier)
+        : m_operand(operand), m_multiplier(multiplier)
+    {}
+
+    constexpr std::size_t size() const
+    { return m_operand.size(); }
+
+    template<class To>
+    constexpr auto eval(std::size_t index) const
+    { return m_operand.template eval<To>(index) * m_multiplier; }
+
+private:
+    Operand m_operand;
+    Scalar m_multiplier;
+};
+
+template<class Operand, class Scalar>
+class divided : public expression<divided<Operand, Scalar>> {
+public:
+    using quantity = typename Operand::quantity;
+    using dimension = typename Operand::dimension;
+    static constexpr bool is_array = Operand::is_array;
+
+    constexpr divided(const Operand &operand, const Scalar &divider)
+        : m_operand(operand), m_divider(divider)
+    {}
+
+    constexpr std::size_t size() const
+    { return m_operand.size(); }
+
+    template<class To>
+    constexpr auto eval(std::size_t index) const
+    { return m_operand.template eval<To>(index) / m_divider; }
+
+private:
+    Operand m_operand;
+    Scalar m_divider;
+};
+
+template<class Operand>
+class negated : public expression<negated<Operand>> {
+public:
+    using quantity = typename Operand::quantity;
+    using dimension = typename Operand::dimension;
+    static constexpr bool is_array = Operand::is_array;
+
+    constexpr explicit negated(const Operand &operand) : m_operand(operand)
+    {}
+
+    constexpr std::size_t size() const
+    { return m_operand.size(); }
+
+    template<class To>
+    constexpr auto eval(std::size_t index) const
+    { return -m_operand.template eval<To>(index); }
+
+private:
+    Operand m_operand;
+};
+
+template<class Quantity,
+    class = typename std::enable_if<detail::is_quantity<Quantity>::value>::type>
+constexpr scalar_term<Quantity> lazy(const Quantity &value)
+{
+    return scalar_term<Quantity>(value);
+}
+
+template<class Quantity, class FromQuantity>
+constexpr array_term<Quantity, FromQuantity> lazy(const quantity_view<Quantity, FromQuantity> &view)
+{
+    return array_term<Quantity, FromQuantity>(view.source_data(), view.size());
+}
+
+template<class Quantity>
+inline array_term<Quantity, Quantity> lazy(const quantity_vector<Quantity> &values)
+{
+    return array_term<Quantity, Quantity>(values.data(), values.size());
+}
+
+// The expression would outlive the vector
+template<class Quantity>
+void lazy(const quantity_vector<Quantity> &&values) = delete;
+
+template<class Quantity>
+inline array_term<typename std::remove_const<Quantity>::type,
+                  typename std::remove_const<Quantity>::type> lazy(span<Quantity> values)
+{
+    using quantity = typename std::remove_const<Quantity>::type;
+    return array_term<quantity, quantity>(detail::rep_data(values.data()), values.size());
+}
+
+template<class Left, class Right>
+constexpr binary<Left, Right, plus> operator+(const expression<Left> &left,
+                                              const expression<Right> &right)
+{
+    return binary<Left, Right, plus>(left.self(), right.self());
+}
+
+template<class Left, class Quantity,
+    class = typename std::enable_if<detail::is_quantity<Quantity>::value>::type>
+constexpr binary<Left, scalar_term<Quantity>, plus> operator+(const expression<Left> &left,
+                                                              const Quantity &right)
+{
+    return binary<Left, scalar_term<Quantity>, plus>(left.self(), scalar_term<Quantity>(right));
+}
+
+template<class Quantity, class Right,
+    class = typename std::enable_if<detail::is_quantity<Quantity>::value>::type>
+constexpr binary<scalar_term<Quantity>, Right, plus> operator+(const Quantity &left,
+                                                               const expression<Right> &right)
+{
+    return binary<scalar_term<Quantity>, Right, plus>(scalar_term<Quantity>(left), right.self());
+}
+
+template<class Left, class Right>
+constexpr binary<Left, Right, minus> operator-(const expression<Left> &left,
+                                               const expression<Right> &right)
+{
+    return binary<Left, Right, minus>(left.self(), right.self());
+}
+
+template<class Left, class Quantity,
+    class = typename std::enable_if<detail::is_quantity<Quantity>::value>::type>
+constexpr binary<Left, scalar_term<Quantity>, minus> operator-(const expression<Left> &left,
+                                                               const Quantity &right)
+{
+    return binary<Left, scalar_term<Quantity>, minus>(left.self(), scalar_term<Quantity>(right));
+}
+
+template<class Quantity, class Right,
+    class = typename std::enable_if<detail::is_quantity<Quantity>::value>::type>
+constexpr binary<scalar_term<Quantity>, Right, minus> operator-(const Quantity &left,
+                                                                const expression<Right> &right)
+{
+    return binary<scalar_term<Quantity>, Right, minus>(scalar_term<Quantity>(left), right.self());
+}
+
+template<class Operand>
+constexpr negated<Operand> operator-(const expression<Operand> &operand)
+{
+    return negated<Operand>(operand.self());
+}
+
+template<class Operand, class Scalar,
+    class = typename std::enable_if<std::is_arithmetic<Scalar>::value>::type>
+constexpr scaled<Operand, Scalar> operator*(const expression<Operand> &operand,
+                                            const Scalar &multiplier)
+{
+    return scaled<Operand, Scalar>(operand.self(), multiplier);
+}
+
+template<class Operand, class Scalar,
+    class = typename std::enable_if<std::is_arithmetic<Scalar>::value>::type>
+constexpr scaled<Operand, Scalar> operator*(const Scalar &multiplier,
+                                            const expression<Operand> &operand)
+{
+    return scaled<Operand, Scalar>(operand.self(), multiplier);
+}
+
+template<class Operand, class Scalar,
+    class = typename std::enable_if<std::is_arithmetic<Scalar>::value>::type>
+constexpr divided<Operand, Scalar> operator/(const expression<Operand> &operand,
+                                             const Scalar &divider)
+{
+    return divided<Operand, Scalar>(operand.self(), divider);
+}
+
+// Evaluates a scalar expression in the To unit
+template<class To, class Expression>
+constexpr To evaluate(const expression<Expression> &source)
+{
+    static_assert(!Expression::is_array, "Use sipp::expr::assign() to evaluate array expressions");
+    return To(static_cast<typename To::rep>(source.self().template eval<To>(0)));
+}
+
+// Evaluates a scalar expression in the unit of its leftmost term
+template<class Expression>
+constexpr typename Expression::quantity evaluate(const expression<Expression> &source)
+{
+    return evaluate<typename Expression::quantity>(source);
+}
+
+// Evaluates an array expression element-wise into out in one pass,
+// out must hold at least source.size() elements
+template<class To, class Expression>
+inline void assign(span<To> out, const expression<Expression> &source)
+{
+    static_assert(Expression::is_array, "Use sipp::expr::evaluate() for scalar expressions");
+
+    const auto &root = source.self();
+    const auto count = std::min(out.size(), root.size());
+    auto *const counts = detail::rep_data(out.data());
+    for (std::size_t i = 0; i < count; ++i) {
+        counts[i] = static_cast<typename To::rep>(root.template eval<To>(i));
+    }
+}
+
+template<class To, class Expression>
+inline void assign(quantity_vector<To> &out, const expression<Expression> &source)
+{
+    static_assert(Expression::is_array, "Use sipp::expr::evaluate() for scalar expressions");
+
+    const auto &root = source.self();
+    const auto count = root.size();
+    out.resize(count);
+    auto *const counts = out.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        counts[i] = static_cast<typename To::rep>(root.template eval<To>(i));
+    }
+}
+
+template<class To, class Expression>
+inline quantity_vector<To> materialize(const expression<Expression> &source)
+{
+    quantity_vector<To> result;
+    assign(result, source);
+    return result;
+}
+
+}
+}
@@ -0,0 +1,497 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+#include "conversion.hpp"
+#include "decimal.hpp"
+#include "distance.hpp"
+#include "span.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+// Enough characters for any formatted quantity (number and unit suffix)
+constexpr std::size_t max_formatted_size = 32;
+
+struct to_chars_result {
+    char *ptr;
+    std::errc ec;
+};
+
+struct format_column_result {
+    // number of values written
+    std::size_t count;
+    // one past the last written character
+    char *ptr;
+};
+
+namespace detail {
+
+// Symbol of a predefined unit, identified by dimension and absolute ratio so that every
+// representation (and every spelling of the ratio) of the unit shares it. The symbols are
+// the ones sipp::parse reads back.
+template<class Dimension, std::intmax_t Num, std::intmax_t Den>
+struct unit_symbol_of;
+
+#define SIPP_UNIT_SYMBOL(Unit, Dimension, Symbol) \
+    template<> \
+    struct unit_symbol_of<Dimension, quantity_traits<Unit>::ratio::num, quantity_traits<Unit>::ratio::den> { \
+        static constexpr const char *get() \
+        { return Symbol; } \
+        static constexpr std::size_t size() \
+        { return sizeof(Symbol) - 1; } \
+    }
+
+SIPP_UNIT_SYMBOL(Meters, distance_dimension, "m");
+SIPP_UNIT_SYMBOL(Kilometers, distance_dimension, "km");
+SIPP_UNIT_SYMBOL(Millimeters, distance_dimension, "mm");
+SIPP_UNIT_SYMBOL(Micrometers, distance_dimension, "um");
+SIPP_UNIT_SYMBOL(Nanometers, distance_dimension, "nm");
+SIPP_UNIT_SYMBOL(Feet, distance_dimension, "ft");
+SIPP_UNIT_SYMBOL(NauticalMiles, distance_dimension, "NM");
+SIPP_UNIT_SYMBOL(StatuteMiles, distance_dimension, "mi");
+SIPP_UNIT_SYMBOL(KmPerHour, speed_dimension, "km/h");
+SIPP_UNIT_SYMBOL(MetersPerSecond, speed_dimension, "m/s");
+SIPP_UNIT_SYMBOL(FeetPerSecond, speed_dimension, "ft/s");
+SIPP_UNIT_SYMBOL(FeetPerMinute, speed_dimension, "ft/min");
+SIPP_UNIT_SYMBOL(Knots, speed_dimension, "kts");
+SIPP_UNIT_SYMBOL(MilesPerHour, speed_dimension, "mph");
+
+#undef SIPP_UNIT_SYMBOL
+
+template<class Quantity>
+using unit_symbol = unit_symbol_of<typename quantity_traits<Quantity>::dimension,
+                                   quantity_traits<Quantity>::ratio::num,
+                                   quantity_traits<Quantity>::ratio::den>;
+
+template<class Integer>
+inline char *write_integer(char *first, Integer value)
+{
+    using unsigned_type = typename std::make_unsigned<Integer>::type;
+
+    char digits[24];
+    char *digit = digits + sizeof(digits);
+    auto magnitude = static_cast<unsigned_type>(value);
+    if (value < 0) {
+        *first++ = '-';
+        magnitude = static_cast<unsigned_type>(0) - magnitude;
+    }
+    // two digits per division
+    static const char pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    while (magnitude >= 100) {
+        const auto pair = static_cast<std::size_t>(magnitude % 100) * 2;
+        magnitude /= 100;
+        digit -= 2;
+        std::memcpy(digit, pairs + pair, 2);
+    }
+    if (magnitude >= 10) {
+        digit -= 2;
+        std::memcpy(digit, pairs + static_cast<std::size_t>(magnitude) * 2, 2);
+    } else {
+        *--digit = static_cast<char>('0' + magnitude);
+    }
+
+    const auto count = static_cast<std::size_t>(digits + sizeof(digits) - digit);
+    std::memcpy(first, digit, count);
+    return first + count;
+}
+
+// Writes mantissa / 10^decimals in fixed notation
+inline char *write_decimal(char *first, bool negative, std::uint64_t mantissa, int decimals)
+{
+    if (negative) {
+        *first++ = '-';
+    }
+    char digits[24];
+    char *const end = write_integer(digits, mantissa);
+    const auto count = static_cast<int>(end - digits);
+    if (decimals == 0) {
+        std::memcpy(first, digits, static_cast<std::size_t>(count));
+        return first + count;
+    }
+
+    if (count <= decimals) {
+        *first++ = '0';
+        *first++ = '.';
+        for (int i = count; i < decimals; ++i) {
+            *first++ = '0';
+        }
+    } else {
+        std::memcpy(first, digits, static_cast<std::size_t>(count - decimals));
+        first += count - decimals;
+        *first++ = '.';
+    }
+    const auto fraction = count < decimals ? count : decimals;
+    std::memcpy(first, end - fraction, static_cast<std::size_t>(fraction));
+    return first + fraction;
+}
+
+// Values with few decimals (most telemetry: 12.5, 3000, 0.3048) are written directly:
+// the smallest k for which value == m / 10^k with an integral m < 2^53 gives the
+// shortest decimal reading back as value, since that division is correctly rounded.
+template<class Float>
+inline char *write_fixed(char *first, Float value)
+{
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    const double limit = 9007199254740992.0;
+
+    const double magnitude = std::fabs(static_cast<double>(value));
+    if (!(magnitude < 1e15) || (magnitude != 0.0 && magnitude < 1e-4)) {
+        return nullptr;
+    }
+
+    for (int decimals = 0; decimals < 10; ++decimals) {
+        const double scaled = std::nearbyint(magnitude * powers[decimals]);
+        if (scaled >= limit) {
+            return nullptr;
+        }
+        if (static_cast<Float>(scaled / powers[decimals]) == static_cast<Float>(magnitude)) {
+            return write_decimal(first, std::signbit(value), static_cast<std::uint64_t>(scaled), decimals);
+        }
+    }
+    return nullptr;
+}
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 wide_uint;
+
+// 10^0 .. 10^21
+inline const wide_uint *wide_powers_of_ten()
+{
+    static const struct table {
+        wide_uint values[22];
+
+        table()
+        {
+            values[0] = 1;
+            for (int i = 1; i < 22; ++i) {
+                values[i] = values[i - 1] * 10;
+            }
+        }
+    } powers;
+    return powers.values;
+}
+
+// Whether the nearest mantissa / 10^decimals (ties to even, as std::to_chars) reads back
+// as significand / 2^shift
+inline bool reads_back(std::uint64_t significand, int shift, bool narrow_below, wide_uint power,
+                       wide_uint &mantissa)
+{
+    const wide_uint scaled = static_cast<wide_uint>(significand) * power;
+    mantissa = scaled >> shift;
+    if (shift != 0) {
+        const wide_uint half = wide_uint(1) << (shift - 1);
+        const wide_uint remainder = scaled & ((half << 1) - 1);
+        mantissa += remainder > half || (remainder == half && mantissa % 2 != 0) ? 1 : 0;
+    }
+
+    const wide_uint candidate = mantissa << (shift + 2);
+    const wide_uint center = scaled << 2;
+    const wide_uint distance = candidate >= center ? candidate - center : center - candidate;
+    const wide_uint half_gap = candidate >= center || !narrow_below ? power * 2 : power;
+    return distance < half_gap || (distance == half_gap && significand % 2 == 0);
+}
+
+// Shortest fixed notation of a double in [1e-4, 2^53), found with exact integer arithmetic:
+// value = significand / 2^shift, and m / 10^k reads back as value when it lies within half
+// a unit in the last place of it (ties going to the even significand, as strtod does).
+// Everything is scaled by 10^k * 2^(shift + 2), which stays below 2^125 for k <= 21.
+// A decimal reading back keeps doing so with one more digit, so the shortest is bisected;
+// next to a power of two the gaps differ on both sides and the digits are tried in order.
+inline char *write_exact(char *first, double value)
+{
+    const int digits = std::numeric_limits<double>::digits;
+
+    const double magnitude = std::fabs(value);
+    if (magnitude == 0.0) {
+        return write_decimal(first, std::signbit(value), 0, 0);
+    }
+    if (!(magnitude >= 1e-4 && magnitude < 9007199254740992.0)) {
+        return nullptr;
+    }
+
+    int exponent = 0;
+    const auto significand = static_cast<std::uint64_t>(std::ldexp(std::frexp(magnitude, &exponent), digits));
+    const int shift = digits - exponent;
+    // the gap to the next smaller double is half as wide at a power of two
+    const bool narrow_below = significand == std::uint64_t(1) << (digits - 1);
+    const wide_uint *powers = wide_powers_of_ten();
+
+    wide_uint mantissa = 0;
+    if (narrow_below) {
+        for (int decimals = 0; decimals <= 21; ++decimals) {
+            if (reads_back(significand, shift, narrow_below, powers[decimals], mantissa)) {
+                return write_decimal(first, std::signbit(value), static_cast<std::uint64_t>(mantissa), decimals);
+            }
+        }
+        return nullptr;
+    }
+
+    int low = 0;
+    int high = 21;
+    if (!reads_back(significand, shift, narrow_below, powers[high], mantissa)) {
+        return nullptr;
+    }
+    while (low < high) {
+        const int middle = (low + high) / 2;
+        if (reads_back(significand, shift, narrow_below, powers[middle], mantissa)) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    reads_back(significand, shift, narrow_below, powers[high], mantissa);
+    return write_decimal(first, std::signbit(value), static_cast<std::uint64_t>(mantissa), high);
+}
+#endif
+
+inline char *write_shortest(char *first, float value)
+{ return write_fixed(first, value); }
+
+inline char *write_shortest(char *first, double value)
+{
+#if defined(__SIZEOF_INT128__)
+    return write_exact(first, value);
+#else
+    return write_fixed(first, value);
+#endif
+}
+
+#ifndef SIPP_HAS_STD_TO_CHARS
+// Shortest text of any finite value, laid out as std::to_chars does without a format:
+// fixed or scientific notation, whichever is shorter (fixed when both are as long)
+template<class Float>
+inline char *write_general(char *first, Float value)
+{
+    if (std::signbit(value)) {
+        *first++ = '-';
+    }
+    if (value == 0) {
+        *first = '0';
+        return first + 1;
+    }
+    char digits[std::numeric_limits<Float>::max_digits10];
+    int exponent = 0;
+    const int count = shortest_digits(std::fabs(value), digits, exponent);
+
+    // value is 0.digits * 10^exponent, or digits[0].digits[1..] * 10^scientific
+    const int scientific = exponent - 1;
+    const int magnitude = scientific < 0 ? -scientific : scientific;
+    const int scientific_size = count + (count > 1 ? 1 : 0) + 2 + (magnitude >= 100 ? 3 : 2);
+    const int fixed_size = exponent >= count ? exponent : exponent > 0 ? count + 1 : 2 - exponent + count;
+
+    if (fixed_size <= scientific_size) {
+        if (exponent >= count) {
+            // an integer, written exactly as printf("%.0f") would
+            char integer[std::numeric_limits<Float>::max_exponent10 + 2];
+            const int size = integer_digits(std::fabs(value), integer);
+            std::memcpy(first, integer, static_cast<std::size_t>(size));
+            return first + size;
+        }
+        if (exponent > 0) {
+            std::memcpy(first, digits, static_cast<std::size_t>(exponent));
+            first[exponent] = '.';
+            std::memcpy(first + exponent + 1, digits + exponent, static_cast<std::size_t>(count - exponent));
+            return first + count + 1;
+        }
+        *first++ = '0';
+        *first++ = '.';
+        std::memset(first, '0', static_cast<std::size_t>(-exponent));
+        std::memcpy(first - exponent, digits, static_cast<std::size_t>(count));
+        return first - exponent + count;
+    }
+
+    *first++ = digits[0];
+    if (count > 1) {
+        *first++ = '.';
+        std::memcpy(first, digits + 1, static_cast<std::size_t>(count - 1));
+        first += count - 1;
+    }
+    *first++ = 'e';
+    *first++ = scientific < 0 ? '-' : '+';
+    if (magnitude < 10) {
+        *first++ = '0';
+    }
+    return write_integer(first, magnitude);
+}
+#endif
+
+template<class Float>
+inline char *write_floating(char *first, char *last, Float value)
+{
+    if (std::isnan(value)) {
+        std::memcpy(first, "nan", 3);
+        return first + 3;
+    }
+    if (std::isinf(value)) {
+        if (value < 0) {
+            *first++ = '-';
+        }
+        std::memcpy(first, "inf", 3);
+        return first + 3;
+    }
+
+    char *const end = write_shortest(first, value);
+    if (end != nullptr) {
+        return end;
+    }
+#ifdef SIPP_HAS_STD_TO_CHARS
+    return std::to_chars(first, last, value).ptr;
+#else
+    (void) last;
+    return write_general(first, value);
+#endif
+}
+
+template<class Rep>
+inline char *write_count(char *first, char *last, const Rep &value, std::true_type)
+{
+    return write_floating(first, last, value);
+}
+
+template<class Rep>
+inline char *write_count(char *first, char *, const Rep &value, std::false_type)
+{
+    return write_integer(first, value);
+}
+
+}
+
+// Writes the shortest text reading back as the same value (through sipp::parse or strtod)
+// followed by the unit symbol, e.g. "12.5km", "3000ft/min", "250kts". Nothing is null
+// terminated. Locale independent. Only predefined units have a symbol, cast others first.
+template<class Quantity,
+    class = typename std::enable_if<detail::is_quantity<Quantity>::value>::type>
+inline to_chars_result to_chars(char *first, char *last, const Quantity &value)
+{
+    using symbol = detail::unit_symbol<Quantity>;
+
+    char buffer[max_formatted_size];
+    char *const number_end = detail::write_count(buffer,
+                                                 buffer + sizeof(buffer),
+                                                 value.count(),
+                                                 std::is_floating_point<typename Quantity::rep>());
+    const auto number_size = static_cast<std::size_t>(number_end - buffer);
+    const auto available = static_cast<std::size_t>(last - first);
+    if (available < symbol::size() || available - symbol::size() < number_size) {
+        return to_chars_result{last, std::errc::value_too_large};
+    }
+
+    std::memcpy(first, buffer, number_size);
+    std::memcpy(first + number_size, symbol::get(), symbol::size());
+    return to_chars_result{first + number_size + symbol::size(), std::errc()};
+}
+
+// Formats values separated by delimiter into [first, last), stopping before the first
+// value that does not fit. Nothing is null terminated.
+template<class Quantity>
+inline format_column_result format_column(span<const Quantity> values,
+                                          char *first,
+                                          char *last,
+                                          char delimiter = '\n')
+{
+    std::size_t count = 0;
+    for (const auto &value : values) {
+        const auto formatted = to_chars(first, last, value);
+        if (formatted.ec != std::errc() || formatted.ptr == last) {
+            break;
+        }
+        *formatted.ptr = delimiter;
+        first = formatted.ptr + 1;
+        ++count;
+    }
+    return format_column_result{count, first};
+}
+
+template<class Quantity>
+inline format_column_result format_column(span<Quantity> values,
+                                          char *first,
+                                          char *last,
+                                          char delimiter = '\n')
+{
+    return format_column(span<const Quantity>(values), first, last, delimiter);
+}
+
+}
+
+#if defined(__cpp_lib_format) && __cpp_lib_format >= 201907L
+#include <format>
+
+namespace std {
+
+template<class Rep, class Ratio, class CharT>
+struct formatter<sipp::Distance<Rep, Ratio>, CharT> {
+    constexpr auto parse(std::basic_format_parse_context<CharT> &context)
+    { return context.begin(); }
+
+    template<class FormatContext>
+    auto format(const sipp::Distance<Rep, Ratio> &value, FormatContext &context) const
+    {
+        char buffer[sipp::max_formatted_size];
+        const auto end = sipp::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        return std::copy(buffer, end, context.out());
+    }
+};
+
+template<class Rep, class DistanceType, class Ratio, class CharT>
+struct formatter<sipp::Speed<Rep, DistanceType, Ratio>, CharT> {
+    constexpr auto parse(std::basic_format_parse_context<CharT> &context)
+    { return context.begin(); }
+
+    template<class FormatContext>
+    auto format(const sipp::Speed<Rep, DistanceType, Ratio> &value, FormatContext &context) const
+    {
+        char buffer[sipp::max_formatted_size];
+        const auto end = sipp::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        return std::copy(buffer, end, context.out());
+    }
+};
+
+}
+#endif
+
+#if defined(FMT_VERSION)
+namespace fmt {
+
+template<class Rep, class Ratio>
+struct formatter<sipp::Distance<Rep, Ratio>> {
+    constexpr auto parse(fmt::format_parse_context &context) -> decltype(context.begin())
+    { return context.begin(); }
+
+    template<class FormatContext>
+    auto format(const sipp::Distance<Rep, Ratio> &value, FormatContext &context) const
+        -> decltype(context.out())
+    {
+        char buffer[sipp::max_formatted_size];
+        const auto end = sipp::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        return std::copy(buffer, end, context.out());
+    }
+};
+
+template<class Rep, class DistanceType, class Ratio>
+struct formatter<sipp::Speed<Rep, DistanceType, Ratio>> {
+    constexpr auto parse(fmt::format_parse_context &context) -> decltype(context.begin())
+    { return context.begin(); }
+
+    template<class FormatContext>
+    auto format(const sipp::Speed<Rep, DistanceType, Ratio> &value, FormatContext &context) const
+        -> decltype(context.out())
+    {
+        char buffer[sipp::max_formatted_size];
+        const auto end = sipp::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+        return std::copy(buffer, end, context.out());
+    }
+};
+
+}
+#endif
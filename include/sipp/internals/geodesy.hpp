@@ -0,0 +1,378 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "batch.hpp"
+#include "distance.hpp"
+#include "simd_math.hpp"
+#include "span.hpp"
+
+namespace sipp {
+
+// Geographic position in degrees: latitude positive north, longitude positive east
+struct geo_point {
+    double latitude;
+    double longitude;
+};
+
+namespace detail {
+
+// IUGG mean radius of the Earth, the sphere of the haversine formula
+constexpr double earth_mean_radius = 6371008.8;
+
+// WGS84 ellipsoid of the Vincenty formula
+constexpr double wgs84_semi_major_axis = 6378137.0;
+constexpr double wgs84_flattening = 1.0 / 298.257223563;
+
+constexpr double degree = 3.14159265358979323846 / 180.0;
+
+static_assert(sizeof(geo_point) == 2 * sizeof(double), "geo_point must be two packed doubles");
+
+// Central angle between two points on a sphere, in radians
+inline double haversine_angle(const geo_point &from, const geo_point &to)
+{
+    const double sin_latitude = std::sin((to.latitude - from.latitude) * (degree / 2.0));
+    const double sin_longitude = std::sin((to.longitude - from.longitude) * (degree / 2.0));
+    const double h = sin_latitude * sin_latitude
+                     + std::cos(from.latitude * degree) * std::cos(to.latitude * degree)
+                         * sin_longitude * sin_longitude;
+    return 2.0 * std::asin(std::sqrt(std::min(h, 1.0)));
+}
+
+// Vincenty's series on the auxiliary sphere, for a geodesic with cos_sq_alpha the squared
+// cosine of its equatorial azimuth, spanning the arc sigma around the midpoint sigma_m
+
+// Ellipsoidal length in meters of the arc
+inline double vincenty_length(double cos_sq_alpha,
+                              double sigma,
+                              double sin_sigma,
+                              double cos_sigma,
+                              double cos_2sigma_m)
+{
+    constexpr double a = wgs84_semi_major_axis;
+    constexpr double b = a * (1.0 - wgs84_flattening);
+
+    const double u_sq = cos_sq_alpha * (a * a - b * b) / (b * b);
+    const double big_a = 1.0 + u_sq / 16384.0 * (4096.0 + u_sq * (-768.0 + u_sq * (320.0 - 175.0 * u_sq)));
+    const double big_b = u_sq / 1024.0 * (256.0 + u_sq * (-128.0 + u_sq * (74.0 - 47.0 * u_sq)));
+    const double delta_sigma =
+        big_b * sin_sigma
+            * (cos_2sigma_m + big_b / 4.0
+                                  * (cos_sigma * (-1.0 + 2.0 * cos_2sigma_m * cos_2sigma_m)
+                                     - big_b / 6.0 * cos_2sigma_m * (-3.0 + 4.0 * sin_sigma * sin_sigma)
+                                         * (-3.0 + 4.0 * cos_2sigma_m * cos_2sigma_m)));
+    return b * big_a * (sigma - delta_sigma);
+}
+
+// Difference between the longitude on the auxiliary sphere and on the ellipsoid
+inline double vincenty_longitude_offset(double sin_alpha,
+                                        double cos_sq_alpha,
+                                        double sigma,
+                                        double sin_sigma,
+                                        double cos_sigma,
+                                        double cos_2sigma_m)
+{
+    constexpr double f = wgs84_flattening;
+
+    const double c = f / 16.0 * cos_sq_alpha * (4.0 + f * (4.0 - 3.0 * cos_sq_alpha));
+    return (1.0 - c) * f * sin_alpha
+           * (sigma + c * sin_sigma * (cos_2sigma_m + c * cos_sigma * (-1.0 + 2.0 * cos_2sigma_m * cos_2sigma_m)));
+}
+
+// Geodesic length in meters for the nearly antipodal points where Vincenty's iteration
+// does not converge: bisection on the azimuth at the first point, of which the longitude
+// reached at the second point's latitude is a monotonic function once the points are in
+// Karney's canonical configuration (Algorithms for geodesics, 2013)
+inline double antipodal_meters(const geo_point &from, const geo_point &to)
+{
+    constexpr double f = wgs84_flattening;
+
+    const double l = std::abs(std::remainder(to.longitude - from.longitude, 360.0)) * degree;
+    double beta1 = std::atan((1.0 - f) * std::tan(from.latitude * degree));
+    double beta2 = std::atan((1.0 - f) * std::tan(to.latitude * degree));
+    // the first point farthest from the equator, in the southern hemisphere
+    if (std::abs(beta1) < std::abs(beta2)) {
+        std::swap(beta1, beta2);
+    }
+    if (beta1 > 0.0) {
+        beta1 = -beta1;
+        beta2 = -beta2;
+    }
+    const double sin_beta1 = std::sin(beta1);
+    const double cos_beta1 = std::cos(beta1);
+    const double sin_beta2 = std::sin(beta2);
+    const double cos_beta2 = std::cos(beta2);
+
+    // Both points on the equator: the geodesic follows it up to (1 - f) pi, beyond it
+    // leaves the equator northwards and meets it again after half a great circle, at a
+    // longitude decreasing with the azimuth
+    const bool equatorial = sin_beta1 == 0.0;
+    if (equatorial && l <= (1.0 - f) * pi) {
+        return wgs84_semi_major_axis * l;
+    }
+
+    double low = 0.0;
+    double high = equatorial ? pi / 2.0 : pi;
+    double length = 0.0;
+    for (double alpha1 = (low + high) / 2.0; low < alpha1 && alpha1 < high; alpha1 = (low + high) / 2.0) {
+        const double sin_alpha1 = std::sin(alpha1);
+        const double cos_alpha1 = std::cos(alpha1);
+        const double sin_alpha = sin_alpha1 * cos_beta1;
+        const double cos_sq_alpha = 1.0 - sin_alpha * sin_alpha;
+
+        // arcs and longitudes on the auxiliary sphere from the equator crossing
+        double sigma = pi;
+        double omega = pi;
+        double sigma_sum = pi;
+        if (!equatorial) {
+            const double cos_alpha2_cos_beta2 = std::sqrt((cos_alpha1 * cos_beta1) * (cos_alpha1 * cos_beta1)
+                                                          + (cos_beta2 - cos_beta1) * (cos_beta2 + cos_beta1));
+            const double sigma1 = std::atan2(sin_beta1, cos_alpha1 * cos_beta1);
+            const double sigma2 = std::atan2(sin_beta2, cos_alpha2_cos_beta2);
+            sigma = sigma2 - sigma1;
+            sigma_sum = sigma1 + sigma2;
+            omega = std::atan2(sin_alpha * sin_beta2, cos_alpha2_cos_beta2)
+                    - std::atan2(sin_alpha * sin_beta1, cos_alpha1 * cos_beta1);
+        }
+        const double sin_sigma = std::sin(sigma);
+        const double cos_sigma = std::cos(sigma);
+        const double cos_2sigma_m = std::cos(sigma_sum);
+
+        const double longitude =
+            omega - vincenty_longitude_offset(sin_alpha, cos_sq_alpha, sigma, sin_sigma, cos_sigma, cos_2sigma_m);
+        length = vincenty_length(cos_sq_alpha, sigma, sin_sigma, cos_sigma, cos_2sigma_m);
+        if ((longitude < l) != equatorial) {
+            low = alpha1;
+        } else {
+            high = alpha1;
+        }
+    }
+    return length;
+}
+
+// Geodesic length in meters on the WGS84 ellipsoid (Vincenty's inverse formula, 1975),
+// nearly antipodal points where the iteration does not converge go to antipodal_meters
+inline double vincenty_meters(const geo_point &from, const geo_point &to)
+{
+    constexpr double f = wgs84_flattening;
+
+    const double l = (to.longitude - from.longitude) * degree;
+    const double u1 = std::atan((1.0 - f) * std::tan(from.latitude * degree));
+    const double u2 = std::atan((1.0 - f) * std::tan(to.latitude * degree));
+    const double sin_u1 = std::sin(u1);
+    const double cos_u1 = std::cos(u1);
+    const double sin_u2 = std::sin(u2);
+    const double cos_u2 = std::cos(u2);
+
+    double lambda = l;
+    double sin_sigma = 0.0;
+    double cos_sigma = 0.0;
+    double sigma = 0.0;
+    double cos_sq_alpha = 0.0;
+    double cos_2sigma_m = 0.0;
+    for (int iteration = 0;; ++iteration) {
+        if (iteration == 200) {
+            return antipodal_meters(from, to);
+        }
+        const double sin_lambda = std::sin(lambda);
+        const double cos_lambda = std::cos(lambda);
+        const double cross = cos_u1 * sin_u2 - sin_u1 * cos_u2 * cos_lambda;
+        sin_sigma = std::sqrt((cos_u2 * sin_lambda) * (cos_u2 * sin_lambda) + cross * cross);
+        if (sin_sigma == 0.0) {
+            // coincident points, or antipodal ones on a meridian
+            return cos_lambda * cos_u1 * cos_u2 + sin_u1 * sin_u2 < 0.0 ? antipodal_meters(from, to) : 0.0;
+        }
+        cos_sigma = sin_u1 * sin_u2 + cos_u1 * cos_u2 * cos_lambda;
+        sigma = std::atan2(sin_sigma, cos_sigma);
+        const double sin_alpha = cos_u1 * cos_u2 * sin_lambda / sin_sigma;
+        cos_sq_alpha = 1.0 - sin_alpha * sin_alpha;
+        // equatorial lines have cos_sq_alpha = 0
+        cos_2sigma_m = cos_sq_alpha != 0.0 ? cos_sigma - 2.0 * sin_u1 * sin_u2 / cos_sq_alpha : 0.0;
+        const double previous = lambda;
+        lambda = l + vincenty_longitude_offset(sin_alpha, cos_sq_alpha, sigma, sin_sigma, cos_sigma, cos_2sigma_m);
+        if (std::abs(lambda - previous) < 1e-12) {
+            break;
+        }
+    }
+    return vincenty_length(cos_sq_alpha, sigma, sin_sigma, cos_sigma, cos_2sigma_m);
+}
+
+using haversine_kernel = void (*)(const geo_point *, const geo_point *, double *, std::size_t, double);
+
+// out[i] = radius * central angle between from[i] and to[i]
+inline void haversine_portable(const geo_point *from, const geo_point *to, double *out, std::size_t count,
+                               double radius)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = radius * haversine_angle(from[i], to[i]);
+    }
+}
+
+#ifdef SIPP_SIMD_X86
+
+// Vector kernels use the polynomial sin and asin of simd_math.hpp; the distances differ
+// from the portable kernel by a few ulp
+
+SIPP_TARGET("avx2")
+inline __m256d haversine_angle_avx2(__m256d latitude1, __m256d longitude1, __m256d latitude2, __m256d longitude2)
+{
+    const __m256d half_degree = _mm256_set1_pd(degree / 2.0);
+    const __m256d sin_latitude = sin_avx2(_mm256_mul_pd(_mm256_sub_pd(latitude2, latitude1), half_degree), 0);
+    const __m256d sin_longitude = sin_avx2(_mm256_mul_pd(_mm256_sub_pd(longitude2, longitude1), half_degree), 0);
+    const __m256d cos_latitudes = _mm256_mul_pd(sin_avx2(_mm256_mul_pd(latitude1, _mm256_set1_pd(degree)), 1),
+                                                sin_avx2(_mm256_mul_pd(latitude2, _mm256_set1_pd(degree)), 1));
+    const __m256d h = _mm256_add_pd(_mm256_mul_pd(sin_latitude, sin_latitude),
+                                    _mm256_mul_pd(cos_latitudes, _mm256_mul_pd(sin_longitude, sin_longitude)));
+    const __m256d angle = asin_avx2(_mm256_sqrt_pd(_mm256_min_pd(h, _mm256_set1_pd(1.0))));
+    return _mm256_add_pd(angle, angle);
+}
+
+SIPP_TARGET("avx2")
+inline void haversine_avx2(const geo_point *from, const geo_point *to, double *out, std::size_t count,
+                           double radius)
+{
+    const double *a = reinterpret_cast<const double *>(from);
+    const double *b = reinterpret_cast<const double *>(to);
+    const __m256d r = _mm256_set1_pd(radius);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // [lat0 lon0 lat1 lon1] [lat2 lon2 lat3 lon3] -> [lat0 lat1 lat2 lat3] [lon0 lon1 lon2 lon3]
+        const __m256d a01 = _mm256_loadu_pd(a + 2 * i);
+        const __m256d a23 = _mm256_loadu_pd(a + 2 * i + 4);
+        const __m256d b01 = _mm256_loadu_pd(b + 2 * i);
+        const __m256d b23 = _mm256_loadu_pd(b + 2 * i + 4);
+        const __m256d latitude1 = _mm256_permute4x64_pd(_mm256_unpacklo_pd(a01, a23), 0xD8);
+        const __m256d longitude1 = _mm256_permute4x64_pd(_mm256_unpackhi_pd(a01, a23), 0xD8);
+        const __m256d latitude2 = _mm256_permute4x64_pd(_mm256_unpacklo_pd(b01, b23), 0xD8);
+        const __m256d longitude2 = _mm256_permute4x64_pd(_mm256_unpackhi_pd(b01, b23), 0xD8);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(r, haversine_angle_avx2(latitude1, longitude1,
+                                                                        latitude2, longitude2)));
+    }
+    haversine_portable(from + i, to + i, out + i, count - i, radius);
+}
+
+SIPP_TARGET("avx512f")
+inline __m512d haversine_angle_avx512(__m512d latitude1, __m512d longitude1, __m512d latitude2, __m512d longitude2)
+{
+    const __m512d half_degree = _mm512_set1_pd(degree / 2.0);
+    const __m512d sin_latitude = sin_avx512(_mm512_mul_pd(_mm512_sub_pd(latitude2, latitude1), half_degree), 0);
+    const __m512d sin_longitude = sin_avx512(_mm512_mul_pd(_mm512_sub_pd(longitude2, longitude1), half_degree), 0);
+    const __m512d cos_latitudes = _mm512_mul_pd(sin_avx512(_mm512_mul_pd(latitude1, _mm512_set1_pd(degree)), 1),
+                                                sin_avx512(_mm512_mul_pd(latitude2, _mm512_set1_pd(degree)), 1));
+    const __m512d h = _mm512_add_pd(_mm512_mul_pd(sin_latitude, sin_latitude),
+                                    _mm512_mul_pd(cos_latitudes, _mm512_mul_pd(sin_longitude, sin_longitude)));
+    const __m512d angle =
+        asin_avx512(_mm512_maskz_sqrt_pd(all_lanes, _mm512_maskz_min_pd(all_lanes, h, _mm512_set1_pd(1.0))));
+    return _mm512_add_pd(angle, angle);
+}
+
+SIPP_TARGET("avx512f")
+inline void haversine_avx512(const geo_point *from, const geo_point *to, double *out, std::size_t count,
+                             double radius)
+{
+    const double *a = reinterpret_cast<const double *>(from);
+    const double *b = reinterpret_cast<const double *>(to);
+    const __m512i latitudes = _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14);
+    const __m512i longitudes = _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15);
+    const __m512d r = _mm512_set1_pd(radius);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d a03 = _mm512_loadu_pd(a + 2 * i);
+        const __m512d a47 = _mm512_loadu_pd(a + 2 * i + 8);
+        const __m512d b03 = _mm512_loadu_pd(b + 2 * i);
+        const __m512d b47 = _mm512_loadu_pd(b + 2 * i + 8);
+        const __m512d angle = haversine_angle_avx512(_mm512_permutex2var_pd(a03, latitudes, a47),
+                                                     _mm512_permutex2var_pd(a03, longitudes, a47),
+                                                     _mm512_permutex2var_pd(b03, latitudes, b47),
+                                                     _mm512_permutex2var_pd(b03, longitudes, b47));
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(r, angle));
+    }
+    haversine_portable(from + i, to + i, out + i, count - i, radius);
+}
+
+#endif
+
+inline haversine_kernel select_haversine_kernel(simd_isa isa)
+{
+    switch (isa) {
+#ifdef SIPP_SIMD_X86
+        case simd_isa::avx512:
+            return &haversine_avx512;
+        case simd_isa::avx2:
+            return &haversine_avx2;
+#endif
+        default:
+            return &haversine_portable;
+    }
+}
+
+template<class Rep, class Ratio>
+inline void haversine(const geo_point *from, const geo_point *to, Distance<Rep, Ratio> *out, std::size_t count,
+                      std::true_type)
+{
+    static const haversine_kernel kernel = select_haversine_kernel(detect_simd_isa());
+    kernel(from, to, rep_data(out), count,
+           earth_mean_radius * static_cast<double>(Ratio::den) / static_cast<double>(Ratio::num));
+}
+
+template<class Rep, class Ratio>
+inline void haversine(const geo_point *from, const geo_point *to, Distance<Rep, Ratio> *out, std::size_t count,
+                      std::false_type)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = distance_cast<Distance<Rep, Ratio>>(Meters(earth_mean_radius * haversine_angle(from[i], to[i])));
+    }
+}
+
+}
+
+// Great-circle distance on the mean Earth sphere (radius 6371008.8 m). Within 0.5 % of
+// the ellipsoidal distance; use vincenty() when that matters.
+template<class ToDistance = Meters>
+inline ToDistance haversine(const geo_point &from, const geo_point &to)
+{
+    static_assert(std::is_floating_point<typename ToDistance::rep>::value,
+                  "Geodesic distances need a floating point representation");
+    return distance_cast<ToDistance>(Meters(detail::earth_mean_radius * detail::haversine_angle(from, to)));
+}
+
+// Geodesic distance on the WGS84 ellipsoid, accurate to 0.5 mm (Vincenty's inverse formula).
+// Nearly antipodal points, where the iteration does not converge, are solved by bisection.
+template<class ToDistance = Meters>
+inline ToDistance vincenty(const geo_point &from, const geo_point &to)
+{
+    static_assert(std::is_floating_point<typename ToDistance::rep>::value,
+                  "Geodesic distances need a floating point representation");
+    return distance_cast<ToDistance>(Meters(detail::vincenty_meters(from, to)));
+}
+
+// Haversine distance of every pair from[i], to[i]. Double precision output is computed
+// with SIMD kernels (AVX2 or AVX-512 polynomial sin and asin, within a few ulp of the
+// scalar function). Computes min(sizes) values, returns that number.
+template<class Rep, class Ratio>
+inline std::size_t haversine(span<const geo_point> from, span<const geo_point> to, span<Distance<Rep, Ratio>> out)
+{
+    static_assert(std::is_floating_point<Rep>::value, "Geodesic distances need a floating point representation");
+    const auto count = std::min(std::min(from.size(), to.size()), out.size());
+    detail::haversine(from.data(), to.data(), out.data(), count, std::is_same<Rep, double>());
+    return count;
+}
+
+// Vincenty distance of every pair from[i], to[i], one scalar vincenty() call each (no SIMD
+// kernel). Computes min(sizes) values, returns that number.
+template<class Rep, class Ratio>
+inline std::size_t vincenty(span<const geo_point> from, span<const geo_point> to, span<Distance<Rep, Ratio>> out)
+{
+    const auto count = std::min(std::min(from.size(), to.size()), out.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = vincenty<Distance<Rep, Ratio>>(from[i], to[i]);
+    }
+    return count;
+}
+
+}
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ratio>
+#include <type_traits>
+
+#include "batch.hpp"
+#include "conversion.hpp"
+#include "distance.hpp"
+#include "span.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+namespace detail {
+
+template<class Rep>
+using advance_kernel = void (*)(Rep *, const Rep *, std::size_t, Rep);
+
+template<class Rep>
+using quotient_kernel = void (*)(const Rep *, const Rep *, Rep *, std::size_t, Rep);
+
+// positions[i] += velocities[i] * step
+template<class Rep>
+inline void advance_portable(Rep *positions, const Rep *velocities, std::size_t count, Rep step)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        positions[i] = positions[i] + velocities[i] * step;
+    }
+}
+
+// out[i] = distances[i] / speeds[i] * factor
+template<class Rep>
+inline void quotient_portable(const Rep *distances, const Rep *speeds, Rep *out, std::size_t count, Rep factor)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = distances[i] / speeds[i] * factor;
+    }
+}
+
+#ifdef SIPP_SIMD_X86
+
+// Separate multiply and add (no FMA) so that every instruction set gives the same result
+
+SIPP_TARGET("sse2")
+inline void advance_sse2(double *positions, const double *velocities, std::size_t count, double step)
+{
+    const __m128d s = _mm_set1_pd(step);
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d v = _mm_loadu_pd(velocities + i);
+        _mm_storeu_pd(positions + i, _mm_add_pd(_mm_loadu_pd(positions + i), _mm_mul_pd(v, s)));
+    }
+    for (; i < count; ++i) {
+        positions[i] = positions[i] + velocities[i] * step;
+    }
+}
+
+SIPP_TARGET("sse2")
+inline void advance_sse2(float *positions, const float *velocities, std::size_t count, float step)
+{
+    const __m128 s = _mm_set1_ps(step);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 v = _mm_loadu_ps(velocities + i);
+        _mm_storeu_ps(positions + i, _mm_add_ps(_mm_loadu_ps(positions + i), _mm_mul_ps(v, s)));
+    }
+    for (; i < count; ++i) {
+        positions[i] = positions[i] + velocities[i] * step;
+    }
+}
+
+SIPP_TARGET("avx2")
+inline void advance_avx2(double *positions, const double *velocities, std::size_t count, double step)
+{
+    const __m256d s = _mm256_set1_pd(step);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d v = _mm256_loadu_pd(velocities + i);
+        _mm256_storeu_pd(positions + i, _mm256_add_pd(_mm256_loadu_pd(positions + i), _mm256_mul_pd(v, s)));
+    }
+    for (; i < count; ++i) {
+        positions[i] = positions[i] + velocities[i] * step;
+    }
+}
+
+SIPP_TARGET("avx2")
+inline void advance_avx2(float *positions, const float *velocities, std::size_t count, float step)
+{
+    const __m256 s = _mm256_set1_ps(step);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 v = _mm256_loadu_ps(velocities + i);
+        _mm256_storeu_ps(positions + i, _mm256_add_ps(_mm256_loadu_ps(positions + i), _mm256_mul_ps(v, s)));
+    }
+    for (; i < count; ++i) {
+        positions[i] = positions[i] + velocities[i] * step;
+    }
+}
+
+SIPP_TARGET("avx512f")
+inline void advance_avx512(double *positions, const double *velocities, std::size_t count, double step)
+{
+    const __m512d s = _mm512_set1_pd(step);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d v = _mm512_loadu_pd(velocities + i);
+        _mm512_storeu_pd(positions + i, _mm512_add_pd(_mm512_loadu_pd(positions + i), _mm512_mul_pd(v, s)));
+    }
+    if (i < count) {
+        const __mmask8 tail = static_cast<__mmask8>((1u << (count - i)) - 1u);
+        const __m512d v = _mm512_maskz_loadu_pd(tail, velocities + i);
+        _mm512_mask_storeu_pd(positions + i, tail,
+                              _mm512_add_pd(_mm512_maskz_loadu_pd(tail, positions + i), _mm512_mul_pd(v, s)));
+    }
+}
+
+SIPP_TARGET("avx512f")
+inline void advance_avx512(float *positions, const float *velocities, std::size_t count, float step)
+{
+    const __m512 s = _mm512_set1_ps(step);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512 v = _mm512_loadu_ps(velocities + i);
+        _mm512_storeu_ps(positions + i, _mm512_add_ps(_mm512_loadu_ps(positions + i), _mm512_mul_ps(v, s)));
+    }
+    if (i < count) {
+        const __mmask16 tail = static_cast<__mmask16>((1u << (count - i)) - 1u);
+        const __m512 v = _mm512_maskz_loadu_ps(tail, velocities + i);
+        _mm512_mask_storeu_ps(positions + i, tail,
+                              _mm512_add_ps(_mm512_maskz_loadu_ps(tail, positions + i), _mm512_mul_ps(v, s)));
+    }
+}
+
+SIPP_TARGET("sse2")
+inline void quotient_sse2(const double *distances, const double *speeds, double *out, std::size_t count,
+                          double factor)
+{
+    const __m128d f = _mm_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d q = _mm_div_pd(_mm_loadu_pd(distances + i), _mm_loadu_pd(speeds + i));
+        _mm_storeu_pd(out + i, _mm_mul_pd(q, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = distances[i] / speeds[i] * factor;
+    }
+}
+
+SIPP_TARGET("sse2")
+inline void quotient_sse2(const float *distances, const float *speeds, float *out, std::size_t count,
+                          float factor)
+{
+    const __m128 f = _mm_set1_ps(factor);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 q = _mm_div_ps(_mm_loadu_ps(distances + i), _mm_loadu_ps(speeds + i));
+        _mm_storeu_ps(out + i, _mm_mul_ps(q, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = distances[i] / speeds[i] * factor;
+    }
+}
+
+SIPP_TARGET("avx2")
+inline void quotient_avx2(const double *distances, const double *speeds, double *out, std::size_t count,
+                          double factor)
+{
+    const __m256d f = _mm256_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d q = _mm256_div_pd(_mm256_loadu_pd(distances + i), _mm256_loadu_pd(speeds + i));
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(q, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = distances[i] / speeds[i] * factor;
+    }
+}
+
+SIPP_TARGET("avx2")
+inline void quotient_avx2(const float *distances, const float *speeds, float *out, std::size_t count,
+                          float factor)
+{
+    const __m256 f = _mm256_set1_ps(factor);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 q = _mm256_div_ps(_mm256_loadu_ps(distances + i), _mm256_loadu_ps(speeds + i));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(q, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = distances[i] / speeds[i] * factor;
+    }
+}
+
+// No masked AVX-512 variant: a zeroed tail lane would divide 0 by 0
+SIPP_TARGET("avx512f")
+inline void quotient_avx512(const double *distances, const double *speeds, double *out, std::size_t count,
+                            double factor)
+{
+    const __m512d f = _mm512_set1_pd(factor);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d q = _mm512_div_pd(_mm512_loadu_pd(distances + i), _mm512_loadu_pd(speeds + i));
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(q, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = distances[i] / speeds[i] * factor;
+    }
+}
+
+SIPP_TARGET("avx512f")
+inline void quotient_avx512(const float *distances, const float *speeds, float *out, std::size_t count,
+                            float factor)
+{
+    const __m512 f = _mm512_set1_ps(factor);
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512 q = _mm512_div_ps(_mm512_loadu_ps(distances + i), _mm512_loadu_ps(speeds + i));
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(q, f));
+    }
+    for (; i < count; ++i) {
+        out[i] = distances[i] / speeds[i] * factor;
+    }
+}
+
+#endif
+
+template<class Rep>
+inline advance_kernel<Rep> select_advance_kernel(simd_isa isa)
+{
+    switch (isa) {
+#ifdef SIPP_SIMD_X86
+        case simd_isa::avx512:
+            return static_cast<advance_kernel<Rep>>(&advance_avx512);
+        case simd_isa::avx2:
+            return static_cast<advance_kernel<Rep>>(&advance_avx2);
+        case simd_isa::sse2:
+            return static_cast<advance_kernel<Rep>>(&advance_sse2);
+#endif
+        default:
+            return &advance_portable<Rep>;
+    }
+}
+
+template<class Rep>
+inline quotient_kernel<Rep> select_quotient_kernel(simd_isa isa)
+{
+    switch (isa) {
+#ifdef SIPP_SIMD_X86
+        case simd_isa::avx512:
+            return static_cast<quotient_kernel<Rep>>(&quotient_avx512);
+        case simd_isa::avx2:
+            return static_cast<quotient_kernel<Rep>>(&quotient_avx2);
+        case simd_isa::sse2:
+            return static_cast<quotient_kernel<Rep>>(&quotient_sse2);
+#endif
+        default:
+            return &quotient_portable<Rep>;
+    }
+}
+
+template<class Rep>
+using is_simd_rep = std::integral_constant<bool, std::is_same<Rep, double>::value || std::is_same<Rep, float>::value>;
+
+template<class Factor, class Rep>
+constexpr Rep factor_value()
+{
+    return static_cast<Rep>(static_cast<double>(Factor::num) / static_cast<double>(Factor::den));
+}
+
+// Factor turning speed counts times timestep counts into position counts
+template<class Position, class Velocity, class Period>
+using advance_factor = std::ratio_multiply<std::ratio_divide<Period, typename Velocity::ratio>,
+                                           std::ratio_divide<typename Velocity::distance_type::ratio,
+                                                             typename Position::ratio>>;
+
+template<class Position, class Velocity, class RepTime, class PeriodTime>
+inline void advance(Position *positions,
+                    const Velocity *velocities,
+                    std::size_t count,
+                    std::chrono::duration<RepTime, PeriodTime> timestep,
+                    std::true_type)
+{
+    using rep = typename Position::rep;
+    static const advance_kernel<rep> kernel = select_advance_kernel<rep>(detect_simd_isa());
+
+    const auto step = static_cast<rep>(factor_value<advance_factor<Position, Velocity, PeriodTime>, double>()
+                                       * static_cast<double>(timestep.count()));
+    kernel(rep_data(positions), rep_data(velocities), count, step);
+}
+
+// Mixed or integral representations keep the exact semantics of the scalar operators
+template<class Position, class Velocity, class RepTime, class PeriodTime>
+inline void advance(Position *positions,
+                    const Velocity *velocities,
+                    std::size_t count,
+                    std::chrono::duration<RepTime, PeriodTime> timestep,
+                    std::false_type)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        positions[i] += velocities[i] * timestep;
+    }
+}
+
+template<class Position, class Velocity, class Duration>
+using time_to_go_factor = std::ratio_multiply<std::ratio_divide<typename Position::ratio,
+                                                                typename Velocity::distance_type::ratio>,
+                                              std::ratio_divide<typename Velocity::ratio,
+                                                                typename Duration::period>>;
+
+template<class Position, class Velocity, class Duration>
+inline void time_to_go(const Position *distances,
+                       const Velocity *speeds,
+                       Duration *out,
+                       std::size_t count,
+                       std::true_type)
+{
+    using rep = typename Position::rep;
+    static_assert(sizeof(Duration) == sizeof(rep), "Duration must be layout-compatible with its representation");
+    static const quotient_kernel<rep> kernel = select_quotient_kernel<rep>(detect_simd_isa());
+
+    kernel(rep_data(distances), rep_data(speeds), reinterpret_cast<rep *>(out), count,
+           factor_value<time_to_go_factor<Position, Velocity, Duration>, rep>());
+}
+
+// Time to go at a zero speed when an integral representation is involved: the largest
+// duration of the distance's sign (infinite for a floating Duration), zero for a zero distance
+template<class Duration, class Rep>
+inline Duration stopped_time_to_go(const Rep &distance)
+{
+    using limits = std::numeric_limits<typename Duration::rep>;
+    if (distance == Rep(0)) {
+        return Duration::zero();
+    }
+    if (limits::has_infinity) {
+        return Duration(distance > Rep(0) ? limits::infinity() : -limits::infinity());
+    }
+    return distance > Rep(0) ? Duration::max() : Duration::min();
+}
+
+// Quotients of integral counts, or into a floating Duration, convert as duration_cast does
+template<class Duration, class Quotient>
+inline Duration saturating_duration_cast(const Quotient &quotient, std::false_type)
+{
+    return std::chrono::duration_cast<Duration>(quotient);
+}
+
+// A floating quotient beyond the range of an integral Duration (a tiny speed) would make
+// the cast undefined: it saturates to Duration::max() or min() instead, NaN gives zero
+template<class Duration, class Quotient>
+inline Duration saturating_duration_cast(const Quotient &quotient, std::true_type)
+{
+    using rep = typename Quotient::rep;
+    using limits = std::numeric_limits<typename Duration::rep>;
+
+    // both bounds are zero or powers of two, exact in rep
+    const auto lowest = static_cast<rep>(limits::min());
+    const auto bound = static_cast<rep>(limits::max() / 2 + 1) * 2;
+    const auto counts = std::trunc(std::chrono::duration<rep, typename Duration::period>(quotient).count());
+    if (counts != counts) {
+        return Duration::zero();
+    }
+    if (counts < lowest) {
+        return Duration::min();
+    }
+    if (counts >= bound) {
+        return Duration::max();
+    }
+    return Duration(static_cast<typename Duration::rep>(counts));
+}
+
+template<class Position, class Velocity, class Duration>
+inline void time_to_go(const Position *distances,
+                       const Velocity *speeds,
+                       Duration *out,
+                       std::size_t count,
+                       std::false_type)
+{
+    using quotient = decltype(distances[0] / speeds[0]);
+    using narrowing = std::integral_constant<bool,
+                                             std::is_floating_point<typename quotient::rep>::value
+                                                 && !std::is_floating_point<typename Duration::rep>::value>;
+
+    // Only floating counts and durations can hold the infinite quotient
+    constexpr bool saturate = !std::is_floating_point<typename Position::rep>::value
+        || !std::is_floating_point<typename Duration::rep>::value;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (saturate && speeds[i].count() == typename Velocity::rep(0)) {
+            out[i] = stopped_time_to_go<Duration>(distances[i].count());
+        } else {
+            out[i] = saturating_duration_cast<Duration>(distances[i] / speeds[i], narrowing());
+        }
+    }
+}
+
+}
+
+// Dead reckoning step: positions[i] += velocities[i] * timestep for every track, the unit
+// ratios and the timestep being folded into one factor. Positions and speeds in the same
+// floating representation are updated with SIMD kernels (one multiply and one add per
+// track, which may differ from the scalar operators in the last bit); other
+// representations go through the scalar operators. Updates min(sizes) tracks, returns that number.
+template<class Position, class Velocity, class RepTime, class PeriodTime>
+inline std::size_t advance(span<Position> positions,
+                           span<const Velocity> velocities,
+                           std::chrono::duration<RepTime, PeriodTime> timestep)
+{
+    const auto count = std::min(positions.size(), velocities.size());
+    detail::advance(positions.data(), velocities.data(), count, timestep,
+                    std::integral_constant<bool,
+                                           std::is_same<typename Position::rep, typename Velocity::rep>::value
+                                               && detail::is_simd_rep<typename Position::rep>::value>());
+    return count;
+}
+
+template<class Position, class Velocity, class RepTime, class PeriodTime>
+inline std::size_t advance(span<Position> positions,
+                           span<Velocity> velocities,
+                           std::chrono::duration<RepTime, PeriodTime> timestep)
+{
+    return advance(positions, span<const Velocity>(velocities), timestep);
+}
+
+// Time to cover distances[i] at speeds[i] (distance / speed) for every track, written as
+// Duration. Same representations are divided with SIMD kernels (one divide and one multiply
+// by the folded factor per track, which may differ from the scalar operators in the last
+// bit). A zero speed gives an infinite time (NaN for a zero distance) when counts and
+// Duration are floating; with an integral representation it gives Duration::max() or min()
+// by the sign of the distance (infinity for a floating Duration) and zero for a zero
+// distance, never dividing by zero. Floating quotients beyond the range of an integral
+// Duration saturate the same way. Computes min(sizes) values, returns that number.
+template<class Position, class Velocity, class Duration>
+inline std::size_t time_to_go(span<const Position> distances, span<const Velocity> speeds, span<Duration> out)
+{
+    const auto count = std::min(std::min(distances.size(), speeds.size()), out.size());
+    detail::time_to_go(distances.data(), speeds.data(), out.data(), count,
+                       std::integral_constant<bool,
+                                              std::is_same<typename Position::rep, typename Velocity::rep>::value
+                                                  && std::is_same<typename Position::rep,
+                                                                  typename Duration::rep>::value
+                                                  && detail::is_simd_rep<typename Position::rep>::value>());
+    return count;
+}
+
+}
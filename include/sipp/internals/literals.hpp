@@ -0,0 +1,96 @@
+#pragma once
+
+#include "distance.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+namespace literals {
+
+constexpr Meters operator "" _m(long double value)
+{ return Meters(value); }
+
+constexpr Meters operator "" _m(unsigned long long int value)
+{ return Meters(value); }
+
+constexpr Kilometers operator "" _km(long double value)
+{ return Kilometers(value); }
+
+constexpr Kilometers operator "" _km(unsigned long long int value)
+{ return Kilometers(value); }
+
+constexpr Millimeters operator "" _mm(long double value)
+{ return Millimeters(value); }
+
+constexpr Millimeters operator "" _mm(unsigned long long int value)
+{ return Millimeters(value); }
+
+constexpr Micrometers operator "" _um(long double value)
+{ return Micrometers(value); }
+
+constexpr Micrometers operator "" _um(unsigned long long int value)
+{ return Micrometers(value); }
+
+constexpr Nanometers operator "" _nm(long double value)
+{ return Nanometers(value); }
+
+constexpr Nanometers operator "" _nm(unsigned long long int value)
+{ return Nanometers(value); }
+
+constexpr Feet operator "" _ft(long double value)
+{ return Feet(value); }
+
+constexpr Feet operator "" _ft(unsigned long long int value)
+{ return Feet(value); }
+
+constexpr NauticalMiles operator "" _NM(long double value)
+{ return NauticalMiles(value); }
+
+constexpr NauticalMiles operator "" _NM(unsigned long long int value)
+{ return NauticalMiles(value); }
+
+constexpr StatuteMiles operator "" _mi(long double value)
+{ return StatuteMiles(value); }
+
+constexpr StatuteMiles operator "" _mi(unsigned long long int value)
+{ return StatuteMiles(value); }
+
+constexpr KmPerHour operator "" _km_h(long double value)
+{ return KmPerHour(value); }
+
+constexpr KmPerHour operator "" _km_h(unsigned long long int value)
+{ return KmPerHour(value); }
+
+constexpr MetersPerSecond operator "" _m_s(long double value)
+{ return MetersPerSecond(value); }
+
+constexpr MetersPerSecond operator "" _m_s(unsigned long long int value)
+{ return MetersPerSecond(value); }
+
+constexpr FeetPerSecond operator "" _ft_s(long double value)
+{ return FeetPerSecond(value); }
+
+constexpr FeetPerSecond operator "" _ft_s(unsigned long long int value)
+{ return FeetPerSecond(value); }
+
+constexpr FeetPerMinute operator "" _ft_min(long double value)
+{ return FeetPerMinute(value); }
+
+constexpr FeetPerMinute operator "" _ft_min(unsigned long long int value)
+{ return FeetPerMinute(value); }
+
+constexpr Knots operator "" _kts(long double value)
+{ return Knots(value); }
+
+constexpr Knots operator "" _kts(unsigned long long int value)
+{ return Knots(value); }
+
+constexpr MilesPerHour operator "" _mph(long double value)
+{ return MilesPerHour(value); }
+
+constexpr MilesPerHour operator "" _mph(unsigned long long int value)
+{ return MilesPerHour(value); }
+
+}
+
+}
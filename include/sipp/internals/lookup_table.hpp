@@ -0,0 +1,418 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "batch.hpp"
+#include "conversion.hpp"
+#include "quantity.hpp"
+#include "simd_math.hpp"
+#include "span.hpp"
+
+namespace sipp {
+
+namespace detail {
+
+// Breakpoints of a lookup_table as seen by the search and interpolation kernels
+template<class KeyRep, class ValueRep>
+struct lookup_data {
+    const KeyRep *keys;
+    const ValueRep *values;
+    // Keys in Eytzinger (breadth-first) order from index 1, padded with +infinity to a
+    // perfect tree of 2^depth - 1 nodes
+    const KeyRep *tree;
+    std::size_t size;
+    unsigned depth;
+    // Keys evenly spaced: the segment is guessed from the key and corrected by one
+    bool uniform;
+    KeyRep first;
+    KeyRep inverse_step;
+};
+
+// In-order walk of the perfect tree, so that the Eytzinger array holds the sorted keys
+template<class KeyRep>
+inline void fill_tree(const KeyRep *keys, std::size_t count, std::vector<KeyRep> &tree, std::size_t node,
+                      std::size_t &next)
+{
+    if (node < tree.size()) {
+        fill_tree(keys, count, tree, 2 * node, next);
+        if (next < count) {
+            tree[node] = keys[next];
+        }
+        ++next;
+        fill_tree(keys, count, tree, 2 * node + 1, next);
+    }
+}
+
+// Lays out count sorted keys as lookup_data::tree, returns the depth of the tree
+template<class KeyRep>
+inline unsigned eytzinger_tree(const KeyRep *keys, std::size_t count, std::vector<KeyRep> &tree)
+{
+    unsigned depth = 0;
+    while ((std::size_t(1) << depth) - 1 < count) {
+        ++depth;
+    }
+    tree.assign(std::size_t(1) << depth, std::numeric_limits<KeyRep>::infinity());
+    std::size_t next = 0;
+    fill_tree(keys, count, tree, 1, next);
+    return depth;
+}
+
+// Index i of the segment [keys[i], keys[i + 1]] holding key, clamped to the first and last
+template<class KeyRep, class ValueRep>
+inline std::size_t lookup_segment(const lookup_data<KeyRep, ValueRep> &table, KeyRep key)
+{
+    const std::size_t last = table.size - 2;
+    if (table.uniform) {
+        KeyRep guess = (key - table.first) * table.inverse_step;
+        guess = guess > KeyRep(0) ? guess : KeyRep(0);
+        guess = guess < KeyRep(last) ? guess : KeyRep(last);
+        const std::size_t segment = static_cast<std::size_t>(guess);
+        if (segment > 0 && key < table.keys[segment]) {
+            return segment - 1;
+        }
+        return segment < last && key > table.keys[segment + 1] ? segment + 1 : segment;
+    }
+
+    // After depth steps down a perfect tree, node - 2^depth is the number of keys less than key
+    std::size_t node = 1;
+    for (unsigned level = 0; level < table.depth; ++level) {
+        node = 2 * node + (table.tree[node] < key ? 1 : 0);
+    }
+    const std::size_t rank = node - (std::size_t(1) << table.depth);
+    return rank == 0 ? 0 : (rank - 1 < last ? rank - 1 : last);
+}
+
+// Linear interpolation, constant beyond the first and last keys; NaN keys give NaN
+template<class KeyRep, class ValueRep>
+inline typename std::common_type<KeyRep, ValueRep>::type lookup_value(const lookup_data<KeyRep, ValueRep> &table,
+                                                                        KeyRep key)
+{
+    using rep = typename std::common_type<KeyRep, ValueRep>::type;
+    const std::size_t segment = lookup_segment(table, key);
+    const KeyRep low = table.keys[segment];
+    const KeyRep high = table.keys[segment + 1];
+    rep t = static_cast<rep>((key - low) / (high - low));
+    t = t < rep(0) ? rep(0) : (t > rep(1) ? rep(1) : t);
+    return (rep(1) - t) * static_cast<rep>(table.values[segment]) + t * static_cast<rep>(table.values[segment + 1]);
+}
+
+template<class KeyRep, class ValueRep, class InRep, class OutRep>
+inline void lookup_portable(const lookup_data<KeyRep, ValueRep> &table, const InRep *in, OutRep *out,
+                            std::size_t count, double in_scale, double out_scale)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        const KeyRep key = static_cast<KeyRep>(static_cast<double>(in[i]) * in_scale);
+        out[i] = static_cast<OutRep>(static_cast<double>(lookup_value(table, key)) * out_scale);
+    }
+}
+
+using lookup_kernel = void (*)(const lookup_data<double, double> &, const double *, double *, std::size_t,
+                               double, double);
+
+#ifdef SIPP_SIMD_X86
+
+SIPP_TARGET("avx2")
+inline void lookup_avx2(const lookup_data<double, double> &table, const double *in, double *out,
+                        std::size_t count, double in_scale, double out_scale)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256i none = _mm256_setzero_si256();
+    const __m256i unit = _mm256_set1_epi64x(1);
+    const __m256i last = _mm256_set1_epi64x(static_cast<long long>(table.size - 2));
+    const __m256d last_guess = _mm256_set1_pd(static_cast<double>(table.size - 2));
+    const __m256d first = _mm256_set1_pd(table.first);
+    const __m256d inverse_step = _mm256_set1_pd(table.inverse_step);
+    const __m256i leaves = _mm256_set1_epi64x(static_cast<long long>((std::size_t(1) << table.depth) + 1));
+    const double *keys = table.keys;
+    const double *values = table.values;
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d key = _mm256_mul_pd(_mm256_loadu_pd(in + i), _mm256_set1_pd(in_scale));
+        __m256i segment;
+        if (table.uniform) {
+            __m256d guess = _mm256_mul_pd(_mm256_sub_pd(key, first), inverse_step);
+            guess = _mm256_min_pd(_mm256_max_pd(guess, zero), last_guess);
+            segment = _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(guess));
+            const __m256d low = _mm256_i64gather_pd(keys, segment, 8);
+            const __m256d high = _mm256_i64gather_pd(keys, _mm256_add_epi64(segment, unit), 8);
+            // Masks are -1 where true
+            const __m256i down = _mm256_and_si256(_mm256_castpd_si256(_mm256_cmp_pd(key, low, _CMP_LT_OQ)),
+                                                  _mm256_cmpgt_epi64(segment, none));
+            const __m256i up = _mm256_and_si256(_mm256_castpd_si256(_mm256_cmp_pd(key, high, _CMP_GT_OQ)),
+                                                _mm256_cmpgt_epi64(last, segment));
+            segment = _mm256_sub_epi64(_mm256_add_epi64(segment, down), up);
+        } else {
+            __m256i node = unit;
+            for (unsigned level = 0; level < table.depth; ++level) {
+                const __m256d right = _mm256_cmp_pd(_mm256_i64gather_pd(table.tree, node, 8), key, _CMP_LT_OQ);
+                node = _mm256_sub_epi64(_mm256_slli_epi64(node, 1), _mm256_castpd_si256(right));
+            }
+            segment = _mm256_sub_epi64(node, leaves);
+            segment = _mm256_blendv_epi8(segment, none, _mm256_cmpgt_epi64(none, segment));
+            segment = _mm256_blendv_epi8(segment, last, _mm256_cmpgt_epi64(segment, last));
+        }
+
+        const __m256i next = _mm256_add_epi64(segment, unit);
+        const __m256d low = _mm256_i64gather_pd(keys, segment, 8);
+        const __m256d high = _mm256_i64gather_pd(keys, next, 8);
+        __m256d t = _mm256_div_pd(_mm256_sub_pd(key, low), _mm256_sub_pd(high, low));
+        // MAX and MIN return their second operand for NaN: NaN keys stay NaN
+        t = _mm256_min_pd(one, _mm256_max_pd(zero, t));
+        const __m256d low_value = _mm256_i64gather_pd(values, segment, 8);
+        const __m256d high_value = _mm256_i64gather_pd(values, next, 8);
+        const __m256d value = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(one, t), low_value),
+                                            _mm256_mul_pd(t, high_value));
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(value, _mm256_set1_pd(out_scale)));
+    }
+    lookup_portable(table, in + i, out + i, count - i, in_scale, out_scale);
+}
+
+// Masked form: the plain gather leaves its source operand undefined, which GCC 12 reports
+SIPP_TARGET("avx512f")
+inline __m512d gather_avx512(const double *base, __m512i index)
+{
+    return _mm512_mask_i64gather_pd(_mm512_setzero_pd(), all_lanes, index, base, 8);
+}
+
+SIPP_TARGET("avx512f")
+inline void lookup_avx512(const lookup_data<double, double> &table, const double *in, double *out,
+                          std::size_t count, double in_scale, double out_scale)
+{
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512i none = _mm512_setzero_si512();
+    const __m512i unit = _mm512_set1_epi64(1);
+    const __m512i last = _mm512_set1_epi64(static_cast<long long>(table.size - 2));
+    const __m512d last_guess = _mm512_set1_pd(static_cast<double>(table.size - 2));
+    const __m512d first = _mm512_set1_pd(table.first);
+    const __m512d inverse_step = _mm512_set1_pd(table.inverse_step);
+    const __m512i leaves = _mm512_set1_epi64(static_cast<long long>((std::size_t(1) << table.depth) + 1));
+    const double *keys = table.keys;
+    const double *values = table.values;
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d key = _mm512_mul_pd(_mm512_loadu_pd(in + i), _mm512_set1_pd(in_scale));
+        __m512i segment;
+        if (table.uniform) {
+            __m512d guess = _mm512_mul_pd(_mm512_sub_pd(key, first), inverse_step);
+            guess = _mm512_maskz_min_pd(all_lanes, _mm512_maskz_max_pd(all_lanes, guess, zero), last_guess);
+            segment = _mm512_maskz_cvtepu32_epi64(all_lanes, _mm512_maskz_cvttpd_epu32(all_lanes, guess));
+            const __m512d low = gather_avx512(keys, segment);
+            const __m512d high = gather_avx512(keys, _mm512_add_epi64(segment, unit));
+            const __mmask8 down = _mm512_cmp_pd_mask(key, low, _CMP_LT_OQ) & _mm512_cmpgt_epi64_mask(segment, none);
+            const __mmask8 up = _mm512_cmp_pd_mask(key, high, _CMP_GT_OQ) & _mm512_cmpgt_epi64_mask(last, segment);
+            segment = _mm512_mask_sub_epi64(segment, down, segment, unit);
+            segment = _mm512_mask_add_epi64(segment, up, segment, unit);
+        } else {
+            __m512i node = unit;
+            for (unsigned level = 0; level < table.depth; ++level) {
+                const __mmask8 right = _mm512_cmp_pd_mask(gather_avx512(table.tree, node), key, _CMP_LT_OQ);
+                node = _mm512_maskz_slli_epi64(all_lanes, node, 1);
+                node = _mm512_mask_add_epi64(node, right, node, unit);
+            }
+            segment = _mm512_maskz_max_epi64(all_lanes, _mm512_sub_epi64(node, leaves), none);
+            segment = _mm512_maskz_min_epi64(all_lanes, segment, last);
+        }
+
+        const __m512i next = _mm512_add_epi64(segment, unit);
+        const __m512d low = gather_avx512(keys, segment);
+        const __m512d high = gather_avx512(keys, next);
+        __m512d t = _mm512_div_pd(_mm512_sub_pd(key, low), _mm512_sub_pd(high, low));
+        t = _mm512_maskz_min_pd(all_lanes, one, _mm512_maskz_max_pd(all_lanes, zero, t));
+        const __m512d low_value = gather_avx512(values, segment);
+        const __m512d high_value = gather_avx512(values, next);
+        const __m512d value = _mm512_add_pd(_mm512_mul_pd(_mm512_sub_pd(one, t), low_value),
+                                            _mm512_mul_pd(t, high_value));
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(value, _mm512_set1_pd(out_scale)));
+    }
+    lookup_portable(table, in + i, out + i, count - i, in_scale, out_scale);
+}
+
+#endif
+
+inline lookup_kernel select_lookup_kernel(simd_isa isa)
+{
+    switch (isa) {
+#ifdef SIPP_SIMD_X86
+        case simd_isa::avx512:
+            return &lookup_avx512;
+        case simd_isa::avx2:
+            return &lookup_avx2;
+#endif
+        default:
+            return &lookup_portable<double, double, double, double>;
+    }
+}
+
+inline void lookup(const lookup_data<double, double> &table, const double *in, double *out, std::size_t count,
+                   double in_scale, double out_scale, std::true_type)
+{
+    static const lookup_kernel kernel = select_lookup_kernel(detect_simd_isa());
+    // The vector kernels compute indices in 32 bits
+    if (table.size <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+        kernel(table, in, out, count, in_scale, out_scale);
+    } else {
+        lookup_portable(table, in, out, count, in_scale, out_scale);
+    }
+}
+
+template<class KeyRep, class ValueRep, class InRep, class OutRep>
+inline void lookup(const lookup_data<KeyRep, ValueRep> &table, const InRep *in, OutRep *out, std::size_t count,
+                   double in_scale, double out_scale, std::false_type)
+{
+    lookup_portable(table, in, out, count, in_scale, out_scale);
+}
+
+}
+
+// Piecewise linear function of a quantity, e.g. climb rate against altitude:
+//
+//   sipp::lookup_table<sipp::Feet, sipp::FeetPerMinute> climb{
+//       {sipp::Feet(0.0), sipp::FeetPerMinute(2500.0)}, {sipp::Feet(10000.0), sipp::FeetPerMinute(2000.0)}};
+//   sipp::FeetPerMinute rate = climb.interpolate(sipp::Meters(1500.0));
+//
+// Values are constant beyond the first and last keys. Keys and values in other units of
+// the same dimensions are converted at the boundary, with one multiplication by the
+// folded factor. The keys are searched in Eytzinger order, or in constant time when they
+// are evenly spaced; batches of double counts are interpolated with AVX2 or AVX-512.
+template<class Key, class Value>
+class lookup_table {
+    static_assert(std::is_floating_point<typename Key::rep>::value
+                      && std::is_floating_point<typename Value::rep>::value,
+                  "sipp::lookup_table interpolates floating point quantities only");
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+
+    // Keys must be strictly increasing, at least two, with one value each
+    template<class KeyQuantity, class ValueQuantity>
+    lookup_table(span<const KeyQuantity> keys, span<const ValueQuantity> values)
+    {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("sipp::lookup_table: as many keys as values expected");
+        }
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            m_keys.push_back(quantity_cast<Key>(keys[i]).count());
+            m_values.push_back(quantity_cast<Value>(values[i]).count());
+        }
+        build();
+    }
+
+    lookup_table(std::initializer_list<std::pair<Key, Value>> breakpoints)
+    {
+        for (const auto &breakpoint : breakpoints) {
+            m_keys.push_back(breakpoint.first.count());
+            m_values.push_back(breakpoint.second.count());
+        }
+        build();
+    }
+
+    std::size_t size() const
+    { return m_keys.size(); }
+
+    Key key(std::size_t index) const
+    { return Key(m_keys[index]); }
+
+    Value value(std::size_t index) const
+    { return Value(m_values[index]); }
+
+    // Keys evenly spaced: searched in constant time instead of O(log(size))
+    bool uniform() const
+    { return m_uniform; }
+
+    template<class KeyQuantity>
+    Value interpolate(const KeyQuantity &key) const
+    {
+        static_assert(std::is_same<typename detail::quantity_traits<KeyQuantity>::dimension,
+                                   typename detail::quantity_traits<Key>::dimension>::value,
+                      "Key of another dimension");
+        const typename KeyQuantity::rep count = key.count();
+        Value value;
+        detail::lookup_portable(data(), &count, detail::rep_data(&value), 1,
+                                detail::unit_factor<Key, KeyQuantity>(), 1.0);
+        return value;
+    }
+
+    // Interpolates min(keys.size(), values.size()) elements, returns the number of interpolated elements
+    template<class KeyQuantity, class ValueQuantity>
+    std::size_t interpolate(span<const KeyQuantity> keys, span<ValueQuantity> values) const
+    {
+        static_assert(std::is_same<typename detail::quantity_traits<KeyQuantity>::dimension,
+                                   typename detail::quantity_traits<Key>::dimension>::value,
+                      "Keys of another dimension");
+        static_assert(std::is_same<typename detail::quantity_traits<ValueQuantity>::dimension,
+                                   typename detail::quantity_traits<Value>::dimension>::value,
+                      "Values of another dimension");
+        using vectorized = std::integral_constant<bool,
+                                                  std::is_same<typename Key::rep, double>::value
+                                                      && std::is_same<typename Value::rep, double>::value
+                                                      && std::is_same<typename KeyQuantity::rep, double>::value
+                                                      && std::is_same<typename ValueQuantity::rep, double>::value>;
+
+        const std::size_t count = keys.size() < values.size() ? keys.size() : values.size();
+        detail::lookup(data(), detail::rep_data(keys.data()), detail::rep_data(values.data()), count,
+                       detail::unit_factor<Key, KeyQuantity>(), detail::unit_factor<ValueQuantity, Value>(),
+                       vectorized());
+        return count;
+    }
+
+    template<class KeyQuantity, class ValueQuantity>
+    std::size_t interpolate(span<KeyQuantity> keys, span<ValueQuantity> values) const
+    {
+        return interpolate(span<const KeyQuantity>(keys), values);
+    }
+
+private:
+    using key_rep = typename Key::rep;
+    using value_rep = typename Value::rep;
+
+    void build()
+    {
+        if (m_keys.size() < 2) {
+            throw std::invalid_argument("sipp::lookup_table: at least two keys expected");
+        }
+        for (std::size_t i = 1; i < m_keys.size(); ++i) {
+            if (!(m_keys[i - 1] < m_keys[i])) {
+                throw std::invalid_argument("sipp::lookup_table: keys must be strictly increasing");
+            }
+        }
+
+        m_depth = detail::eytzinger_tree(m_keys.data(), m_keys.size(), m_tree);
+
+        // Evenly spaced within 1/1024 of a step: a guessed segment is off by one at most
+        const std::size_t last = m_keys.size() - 1;
+        const key_rep step = (m_keys[last] - m_keys[0]) / static_cast<key_rep>(last);
+        m_uniform = true;
+        for (std::size_t i = 1; i < last && m_uniform; ++i) {
+            const key_rep deviation = m_keys[i] - (m_keys[0] + static_cast<key_rep>(i) * step);
+            m_uniform = (deviation < 0 ? -deviation : deviation) <= step / key_rep(1024);
+        }
+        m_inverse_step = key_rep(1) / step;
+    }
+
+    detail::lookup_data<key_rep, value_rep> data() const
+    {
+        return detail::lookup_data<key_rep, value_rep>{m_keys.data(), m_values.data(), m_tree.data(), m_keys.size(),
+                                                       m_depth, m_uniform, m_keys[0], m_inverse_step};
+    }
+
+    std::vector<key_rep> m_keys;
+    std::vector<value_rep> m_values;
+    std::vector<key_rep> m_tree;
+    unsigned m_depth = 0;
+    bool m_uniform = false;
+    key_rep m_inverse_step = 0;
+};
+
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sipp {
+
+namespace detail {
+
+// Hints that [offset, offset + length) of a mapping is about to be read sequentially
+inline void will_need(const unsigned char *data, std::size_t size, std::size_t offset, std::size_t length)
+{
+#if !defined(_WIN32)
+    if (data == nullptr || offset >= size) {
+        return;
+    }
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t first = offset / page * page;
+    const std::size_t last = offset + length < size ? offset + length : size;
+    ::madvise(const_cast<unsigned char *>(data) + first, last - first, MADV_WILLNEED);
+#else
+    (void) data;
+    (void) size;
+    (void) offset;
+    (void) length;
+#endif
+}
+
+}
+
+// Read-only memory mapping of a whole file. Mapping is constant time, pages are
+// read from disk only when they are first touched.
+class mapped_file {
+public:
+    mapped_file() : m_data(nullptr), m_size(0)
+    {}
+
+    explicit mapped_file(const std::string &path) : m_data(nullptr), m_size(0)
+    {
+        open(path);
+    }
+
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    mapped_file(mapped_file &&other) noexcept : m_data(other.m_data), m_size(other.m_size)
+    {
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+
+    mapped_file &operator=(mapped_file &&other) noexcept
+    {
+        if (this != &other) {
+            close();
+            m_data = other.m_data;
+            m_size = other.m_size;
+            other.m_data = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    ~mapped_file()
+    {
+        close();
+    }
+
+    const unsigned char *data() const
+    { return m_data; }
+
+    std::size_t size() const
+    { return m_size; }
+
+    bool empty() const
+    { return m_size == 0; }
+
+    // Hints that [offset, offset + length) is about to be read sequentially
+    void will_need(std::size_t offset, std::size_t length) const
+    { detail::will_need(m_data, m_size, offset, length); }
+
+private:
+#if defined(_WIN32)
+    void open(const std::string &path)
+    {
+        const HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(),
+                                    "sipp: can not open " + path);
+        }
+
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file, &size)) {
+            const auto error = static_cast<int>(::GetLastError());
+            ::CloseHandle(file);
+            throw std::system_error(error, std::system_category(), "sipp: can not stat " + path);
+        }
+
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        if (m_size == 0) {
+            ::CloseHandle(file);
+            return;
+        }
+
+        const HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);
+        if (mapping == nullptr) {
+            throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(),
+                                    "sipp: can not map " + path);
+        }
+
+        m_data = static_cast<const unsigned char *>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        ::CloseHandle(mapping);
+        if (m_data == nullptr) {
+            m_size = 0;
+            throw std::system_error(static_cast<int>(::GetLastError()), std::system_category(),
+                                    "sipp: can not map " + path);
+        }
+    }
+
+    void close()
+    {
+        if (m_data != nullptr) {
+            ::UnmapViewOfFile(m_data);
+        }
+        m_data = nullptr;
+        m_size = 0;
+    }
+#else
+    void open(const std::string &path)
+    {
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            throw std::system_error(errno, std::generic_category(), "sipp: can not open " + path);
+        }
+
+        struct stat status;
+        if (::fstat(file, &status) != 0) {
+            const int error = errno;
+            ::close(file);
+            throw std::system_error(error, std::generic_category(), "sipp: can not stat " + path);
+        }
+
+        m_size = static_cast<std::size_t>(status.st_size);
+        if (m_size == 0) {
+            ::close(file);
+            return;
+        }
+
+        void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, file, 0);
+        const int error = errno;
+        ::close(file);
+        if (data == MAP_FAILED) {
+            m_size = 0;
+            throw std::system_error(error, std::generic_category(), "sipp: can not map " + path);
+        }
+        m_data = static_cast<const unsigned char *>(data);
+    }
+
+    void close()
+    {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<unsigned char *>(m_data), m_size);
+        }
+        m_data = nullptr;
+        m_size = 0;
+    }
+#endif
+
+    const unsigned char *m_data;
+    std::size_t m_size;
+};
+
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "batch.hpp"
+#include "conversion.hpp"
+#include "distance.hpp"
+#include "span.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+namespace detail {
+
+// Unsigned integer as wide as Rep whose natural order is the order of Rep values
+template<class Rep>
+using rep_key = typename std::conditional<sizeof(Rep) <= sizeof(std::uint32_t), std::uint32_t, std::uint64_t>::type;
+
+template<class Key, class Rep>
+inline Key count_key(const Rep &count, std::true_type)
+{
+    static_assert(sizeof(Rep) == sizeof(Key), "Floating representations must be 32 or 64 bits wide");
+
+    // negative values have all bits flipped (larger magnitude sorts first), positive values
+    // only the sign bit; -0.0 sorts right before +0.0 and NaNs sort to the ends
+    Key bits;
+    std::memcpy(&bits, &count, sizeof(bits));
+    const Key sign = Key(1) << (std::numeric_limits<Key>::digits - 1);
+    return (bits & sign) != 0 ? ~bits : bits | sign;
+}
+
+template<class Key, class Rep>
+inline Key count_key(const Rep &count, std::false_type)
+{
+    // offset binary for signed counts
+    const Key sign = std::is_signed<Rep>::value ? Key(1) << (std::numeric_limits<Key>::digits - 1) : Key(0);
+    return static_cast<Key>(count) ^ sign;
+}
+
+// Key preserving the order of counts of one quantity type, computed without any conversion
+template<class Rep>
+inline rep_key<Rep> count_key(const Rep &count)
+{
+    return count_key<rep_key<Rep>>(count, std::is_floating_point<Rep>());
+}
+
+// Unit (meters or meters per second) in which keys of different quantity types compare
+template<class Quantity>
+using canonical_conversion = unit_conversion<double,
+                                             std::ratio<1>,
+                                             typename Quantity::rep,
+                                             typename quantity_traits<Quantity>::ratio>;
+
+template<class Quantity>
+inline void radix_sort(Quantity *values, Quantity *scratch, std::size_t count)
+{
+    using key_type = rep_key<typename Quantity::rep>;
+    constexpr std::size_t digits = sizeof(key_type);
+    constexpr std::size_t buckets = 256;
+
+    // histograms of every byte in a single pass over the input
+    std::vector<std::size_t> histograms(digits * buckets, 0);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto key = count_key(values[i].count());
+        for (std::size_t digit = 0; digit < digits; ++digit) {
+            ++histograms[digit * buckets + ((key >> (digit * 8)) & 0xff)];
+        }
+    }
+
+    Quantity *in = values;
+    Quantity *out = scratch;
+    for (std::size_t digit = 0; digit < digits; ++digit) {
+        std::size_t *const histogram = histograms.data() + digit * buckets;
+        const auto key_byte = (count_key(values[0].count()) >> (digit * 8)) & 0xff;
+        // every key has the same byte here, e.g. the exponent bytes of values of one magnitude
+        if (histogram[key_byte] == count) {
+            continue;
+        }
+
+        std::size_t offset = 0;
+        for (std::size_t bucket = 0; bucket < buckets; ++bucket) {
+            const auto size = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += size;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto bucket = (count_key(in[i].count()) >> (digit * 8)) & 0xff;
+            out[histogram[bucket]++] = in[i];
+        }
+        std::swap(in, out);
+    }
+
+    if (in != values) {
+        std::copy(in, in + count, values);
+    }
+}
+
+// First index in [0, count) whose count does not satisfy before(count), for a partitioned
+// array. Branchless so that the loads of the next step do not wait for a misprediction.
+template<class Quantity, class Predicate>
+inline std::size_t partition_point(const Quantity *values, std::size_t count, Predicate before)
+{
+    const Quantity *first = values;
+    while (count > 1) {
+        const std::size_t half = count / 2;
+        first = before(first[half - 1].count()) ? first + half : first;
+        count -= half;
+    }
+    return static_cast<std::size_t>(first - values) + (count == 1 && before(first->count()) ? 1 : 0);
+}
+
+}
+
+// Order-preserving key of a distance or speed in the canonical unit (meters, meters per
+// second): a < b implies order_key(a) <= order_key(b) whatever the units of a and b, so
+// keys of values from different sources are compared without any further conversion.
+template<class Quantity,
+    class = typename std::enable_if<detail::is_quantity<Quantity>::value>::type>
+inline std::uint64_t order_key(const Quantity &value)
+{
+    return detail::count_key(detail::canonical_conversion<Quantity>::apply(value.count()));
+}
+
+// Stable LSD radix sort in ascending order. Keys are derived from the counts directly, so
+// unlike std::sort with operator< nothing is converted per comparison. Bytes equal across
+// all values are skipped. scratch must hold at least values.size() elements.
+template<class Quantity>
+inline void radix_sort(span<Quantity> values, span<Quantity> scratch)
+{
+    if (values.size() > 1) {
+        detail::radix_sort(values.data(), scratch.data(), values.size());
+    }
+}
+
+template<class Quantity>
+inline void radix_sort(span<Quantity> values)
+{
+    std::vector<Quantity> scratch(values.size());
+    radix_sort(values, span<Quantity>(scratch));
+}
+
+// Index of the first value not less than threshold in an ascending array, as std::lower_bound.
+// The threshold may be in any unit of the same dimension: it is converted into the unit of
+// the array once (rounded up for integral counts) instead of once per comparison.
+template<class Quantity, class Threshold>
+inline std::size_t lower_bound(span<const Quantity> sorted, const Threshold &threshold)
+{
+    using rep = detail::conversion_rep<typename Quantity::rep, typename Threshold::rep>;
+    using conversion = detail::unit_conversion<rep,
+                                               typename detail::quantity_traits<Quantity>::ratio,
+                                               typename Threshold::rep,
+                                               typename detail::quantity_traits<Threshold>::ratio,
+                                               rounding::upward>;
+    static_assert(std::is_same<typename detail::quantity_traits<Quantity>::dimension,
+                               typename detail::quantity_traits<Threshold>::dimension>::value,
+                  "Quantities of different dimensions can not be compared");
+
+    const rep bound = conversion::apply(threshold.count());
+    return detail::partition_point(sorted.data(), sorted.size(), [bound](const typename Quantity::rep &count) {
+        return static_cast<rep>(count) < bound;
+    });
+}
+
+// Index of the first value greater than threshold in an ascending array, as std::upper_bound
+template<class Quantity, class Threshold>
+inline std::size_t upper_bound(span<const Quantity> sorted, const Threshold &threshold)
+{
+    using rep = detail::conversion_rep<typename Quantity::rep, typename Threshold::rep>;
+    using conversion = detail::unit_conversion<rep,
+                                               typename detail::quantity_traits<Quantity>::ratio,
+                                               typename Threshold::rep,
+                                               typename detail::quantity_traits<Threshold>::ratio,
+                                               rounding::downward>;
+    static_assert(std::is_same<typename detail::quantity_traits<Quantity>::dimension,
+                               typename detail::quantity_traits<Threshold>::dimension>::value,
+                  "Quantities of different dimensions can not be compared");
+
+    const rep bound = conversion::apply(threshold.count());
+    return detail::partition_point(sorted.data(), sorted.size(), [bound](const typename Quantity::rep &count) {
+        return !(bound < static_cast<rep>(count));
+    });
+}
+
+template<class Quantity, class Threshold>
+inline std::size_t lower_bound(span<Quantity> sorted, const Threshold &threshold)
+{
+    return lower_bound(span<const Quantity>(sorted), threshold);
+}
+
+template<class Quantity, class Threshold>
+inline std::size_t upper_bound(span<Quantity> sorted, const Threshold &threshold)
+{
+    return upper_bound(span<const Quantity>(sorted), threshold);
+}
+
+}
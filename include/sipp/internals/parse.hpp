@@ -0,0 +1,434 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "conversion.hpp"
+#include "decimal.hpp"
+#include "distance.hpp"
+#include "span.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+// Locale-independent parsing of quantities written with a unit suffix, e.g. "12.5km",
+// "250 kts", "3000ft/min". Every suffix of sipp::literals is recognised (with or without
+// the leading underscore), as are the usual "km/h", "m/s", "ft/s", "ft/min" and "kt".
+// The parsed value is converted into the requested unit of the same dimension exactly as
+// by distance_cast/speed_cast. Nothing allocates and nothing throws.
+enum class parse_error {
+    none,
+    invalid_number,
+    unknown_unit,
+    dimension_mismatch,
+    // the value does not fit the integral representation of the requested quantity
+    out_of_range
+};
+
+struct from_chars_result {
+    // one past the parsed text on success, the start of the text otherwise
+    const char *ptr;
+    parse_error error;
+};
+
+template<class Quantity>
+struct parse_result {
+    Quantity value;
+    parse_error error;
+
+    explicit operator bool() const
+    { return error == parse_error::none; }
+};
+
+struct parse_column_result {
+    // number of values written
+    std::size_t count;
+    // start of the first field not parsed (the failed one if error is set)
+    const char *ptr;
+    parse_error error;
+};
+
+namespace detail {
+
+// Units known to the parser, suffixes index into this list
+enum class parsed_unit : unsigned char {
+    meters,
+    kilometers,
+    millimeters,
+    micrometers,
+    nanometers,
+    feet,
+    nautical_miles,
+    statute_miles,
+    km_per_hour,
+    meters_per_second,
+    feet_per_second,
+    feet_per_minute,
+    knots,
+    miles_per_hour,
+    count
+};
+
+// Suffix of up to 8 characters packed into an integer, so matching is one comparison
+constexpr std::uint64_t suffix_key(const char *text, std::size_t length)
+{
+    return length == 0 ? 0 : (suffix_key(text, length - 1) << 8)
+                                 | static_cast<unsigned char>(text[length - 1]);
+}
+
+struct unit_suffix {
+    std::uint64_t key;
+    parsed_unit unit;
+};
+
+template<std::size_t N>
+constexpr unit_suffix make_suffix(const char (&text)[N], parsed_unit unit)
+{
+    static_assert(N - 1 <= 8, "Unit suffixes are limited to 8 characters");
+    return unit_suffix{suffix_key(text, N - 1), unit};
+}
+
+inline const unit_suffix *unit_suffixes(std::size_t &count)
+{
+    static const unit_suffix suffixes[] = {
+        make_suffix("m", parsed_unit::meters),
+        make_suffix("km", parsed_unit::kilometers),
+        make_suffix("ft", parsed_unit::feet),
+        make_suffix("NM", parsed_unit::nautical_miles),
+        make_suffix("mi", parsed_unit::statute_miles),
+        make_suffix("mm", parsed_unit::millimeters),
+        make_suffix("um", parsed_unit::micrometers),
+        make_suffix("nm", parsed_unit::nanometers),
+        make_suffix("kts", parsed_unit::knots),
+        make_suffix("kt", parsed_unit::knots),
+        make_suffix("km_h", parsed_unit::km_per_hour),
+        make_suffix("km/h", parsed_unit::km_per_hour),
+        make_suffix("m_s", parsed_unit::meters_per_second),
+        make_suffix("m/s", parsed_unit::meters_per_second),
+        make_suffix("ft_s", parsed_unit::feet_per_second),
+        make_suffix("ft/s", parsed_unit::feet_per_second),
+        make_suffix("ft_min", parsed_unit::feet_per_minute),
+        make_suffix("ft/min", parsed_unit::feet_per_minute),
+        make_suffix("mph", parsed_unit::miles_per_hour),
+    };
+    count = sizeof(suffixes) / sizeof(suffixes[0]);
+    return suffixes;
+}
+
+inline bool is_suffix_char(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '/';
+}
+
+inline bool is_space(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+inline bool is_digit(char c)
+{
+    return static_cast<unsigned char>(c - '0') < 10;
+}
+
+// Matches the unit suffix starting at first, returns its end or nullptr
+inline const char *parse_suffix(const char *first, const char *last, parsed_unit &unit)
+{
+    if (first != last && *first == '_') {
+        ++first;
+    }
+    const char *end = first;
+    std::uint64_t key = 0;
+    while (end != last && is_suffix_char(*end)) {
+        key = (key << 8) | static_cast<unsigned char>(*end);
+        ++end;
+    }
+    if (end - first > 8) {
+        return nullptr;
+    }
+
+    std::size_t count = 0;
+    const unit_suffix *suffixes = unit_suffixes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (suffixes[i].key == key) {
+            unit = suffixes[i].unit;
+            return end;
+        }
+    }
+    return nullptr;
+}
+
+// Correctly rounded conversion of text the fast path can not handle: std::from_chars where
+// the standard library has it, Eisel-Lemire with an exact fallback otherwise (and for
+// values out of the range of double, which std::from_chars rejects)
+inline double parse_decimal_slow(const char *first,
+                                 const char *last,
+                                 std::uint64_t mantissa,
+                                 int exponent,
+                                 bool truncated,
+                                 bool negative)
+{
+#ifdef SIPP_HAS_STD_TO_CHARS
+    double value = 0.0;
+    const char *start = first != last && *first == '+' ? first + 1 : first;
+    const auto result = std::from_chars(start, last, value);
+    if (result.ec == std::errc() && result.ptr == last) {
+        return value;
+    }
+#endif
+    return decimal_to_double(first, last, mantissa, exponent, truncated, negative);
+}
+
+// Parses [+-]digits[.digits][(e|E)[+-]digits], returns the end of the number or nullptr.
+// Values with at most 19 significant digits whose mantissa and power of ten are exactly
+// representable as doubles are computed with one correctly rounded operation (Clinger's
+// fast path), the rest goes through parse_decimal_slow.
+inline const char *parse_decimal(const char *first, const char *last, double &value)
+{
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    const char *position = first;
+    const bool negative = position != last && *position == '-';
+    if (position != last && (*position == '-' || *position == '+')) {
+        ++position;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool any_digit = false;
+
+    for (; position != last && is_digit(*position); ++position) {
+        any_digit = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*position - '0');
+            digits += mantissa != 0 ? 1 : 0;
+        } else {
+            ++exponent;
+            truncated = truncated || *position != '0';
+        }
+    }
+    if (position != last && *position == '.') {
+        ++position;
+        for (; position != last && is_digit(*position); ++position) {
+            any_digit = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*position - '0');
+                digits += mantissa != 0 ? 1 : 0;
+                --exponent;
+            } else {
+                truncated = truncated || *position != '0';
+            }
+        }
+    }
+    if (!any_digit) {
+        return nullptr;
+    }
+
+    if (position != last && (*position == 'e' || *position == 'E')) {
+        const char *exponent_position = position + 1;
+        const bool negative_exponent = exponent_position != last && *exponent_position == '-';
+        if (exponent_position != last && (*exponent_position == '-' || *exponent_position == '+')) {
+            ++exponent_position;
+        }
+        if (exponent_position != last && is_digit(*exponent_position)) {
+            int written = 0;
+            for (; exponent_position != last && is_digit(*exponent_position); ++exponent_position) {
+                written = written < 10000 ? written * 10 + (*exponent_position - '0') : written;
+            }
+            exponent += negative_exponent ? -written : written;
+            position = exponent_position;
+        }
+    }
+
+    if (!truncated && mantissa <= (std::uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        const auto magnitude = static_cast<double>(mantissa);
+        value = exponent < 0 ? magnitude / powers[-exponent] : magnitude * powers[exponent];
+        value = negative ? -value : value;
+        return position;
+    }
+
+    value = parse_decimal_slow(first, position, mantissa, exponent, truncated, negative);
+    return position;
+}
+
+// Stores count converted into Quantity, false when the result would not be representable
+template<class Quantity>
+using parsed_converter = bool (*)(double, Quantity &);
+
+// Floating representations take any count, overflow becomes an infinity as with strtod
+template<class Quantity, class Unit>
+inline bool parsed_in_range(double, std::false_type)
+{
+    return true;
+}
+
+// Integral representations take the counts whose truncation (the rounding of
+// quantity_conversion) lies within numeric_limits, NaN never does
+template<class Quantity, class Unit>
+inline bool parsed_in_range(double count, std::true_type)
+{
+    using conversion = quantity_conversion<Quantity, Unit>;
+    using rep = typename conversion::rep;
+    using limits = std::numeric_limits<typename Quantity::rep>;
+
+    // both bounds are zero or powers of two, exact in rep
+    const auto lowest = static_cast<rep>(limits::min());
+    const auto bound = static_cast<rep>(limits::max() / 2 + 1) * 2;
+    const auto scaled = std::trunc(conversion::scale::apply(static_cast<rep>(count)));
+    return scaled >= lowest && scaled < bound;
+}
+
+template<class Quantity, class Unit>
+inline bool convert_parsed(double count, Quantity &value)
+{
+    if (!parsed_in_range<Quantity, Unit>(count, std::is_integral<typename Quantity::rep>())) {
+        return false;
+    }
+    value = Quantity(quantity_conversion<Quantity, Unit>::apply(count));
+    return true;
+}
+
+template<class Quantity, class Unit>
+constexpr parsed_converter<Quantity> parsed_converter_for(std::true_type)
+{
+    return &convert_parsed<Quantity, Unit>;
+}
+
+template<class Quantity, class Unit>
+constexpr parsed_converter<Quantity> parsed_converter_for(std::false_type)
+{
+    return nullptr;
+}
+
+template<class Quantity, class Unit>
+constexpr parsed_converter<Quantity> parsed_converter_for()
+{
+    return parsed_converter_for<Quantity, Unit>(
+        std::is_same<typename quantity_traits<Quantity>::dimension,
+                     typename quantity_traits<Unit>::dimension>());
+}
+
+// Conversions from every parsed unit into Quantity, nullptr for other dimensions
+template<class Quantity>
+inline const parsed_converter<Quantity> *parsed_converters()
+{
+    static const parsed_converter<Quantity> converters[] = {
+        parsed_converter_for<Quantity, Meters>(),
+        parsed_converter_for<Quantity, Kilometers>(),
+        parsed_converter_for<Quantity, Millimeters>(),
+        parsed_converter_for<Quantity, Micrometers>(),
+        parsed_converter_for<Quantity, Nanometers>(),
+        parsed_converter_for<Quantity, Feet>(),
+        parsed_converter_for<Quantity, NauticalMiles>(),
+        parsed_converter_for<Quantity, StatuteMiles>(),
+        parsed_converter_for<Quantity, KmPerHour>(),
+        parsed_converter_for<Quantity, MetersPerSecond>(),
+        parsed_converter_for<Quantity, FeetPerSecond>(),
+        parsed_converter_for<Quantity, FeetPerMinute>(),
+        parsed_converter_for<Quantity, Knots>(),
+        parsed_converter_for<Quantity, MilesPerHour>(),
+    };
+    static_assert(sizeof(converters) / sizeof(converters[0])
+                      == static_cast<std::size_t>(parsed_unit::count),
+                  "Every parsed unit needs a converter");
+    return converters;
+}
+
+inline const char *skip_spaces(const char *first, const char *last)
+{
+    while (first != last && is_space(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+}
+
+// Parses a number immediately followed by a unit suffix (blanks in between are allowed),
+// in the manner of std::from_chars. value is left untouched on error.
+template<class Quantity>
+inline from_chars_result from_chars(const char *first, const char *last, Quantity &value)
+{
+    double count = 0.0;
+    const char *position = detail::parse_decimal(first, last, count);
+    if (position == nullptr) {
+        return from_chars_result{first, parse_error::invalid_number};
+    }
+
+    detail::parsed_unit unit;
+    position = detail::parse_suffix(detail::skip_spaces(position, last), last, unit);
+    if (position == nullptr) {
+        return from_chars_result{first, parse_error::unknown_unit};
+    }
+
+    const auto converter = detail::parsed_converters<Quantity>()[static_cast<std::size_t>(unit)];
+    if (converter == nullptr) {
+        return from_chars_result{first, parse_error::dimension_mismatch};
+    }
+
+    if (!converter(count, value)) {
+        return from_chars_result{first, parse_error::out_of_range};
+    }
+    return from_chars_result{position, parse_error::none};
+}
+
+// Parses the whole text, surrounding blanks are ignored
+template<class Quantity>
+inline parse_result<Quantity> parse(const char *first, const char *last)
+{
+    parse_result<Quantity> result{Quantity(), parse_error::none};
+    first = detail::skip_spaces(first, last);
+    const auto parsed = from_chars(first, last, result.value);
+    result.error = parsed.error;
+    if (parsed.error == parse_error::none && detail::skip_spaces(parsed.ptr, last) != last) {
+        result.error = parse_error::unknown_unit;
+    }
+    return result;
+}
+
+template<class Quantity>
+inline parse_result<Quantity> parse(const char *text)
+{
+    return parse<Quantity>(text, text + std::strlen(text));
+}
+
+// Parses fields separated by delimiter (and/or line breaks) into out. Stops at the end of
+// the text, when out is full or at the first invalid field; empty fields are skipped.
+template<class Quantity>
+inline parse_column_result parse_column(const char *first,
+                                        const char *last,
+                                        span<Quantity> out,
+                                        char delimiter = '\n')
+{
+    std::size_t count = 0;
+    while (count < out.size()) {
+        while (first != last
+               && (*first == delimiter || *first == '\n' || *first == '\r' || detail::is_space(*first))) {
+            ++first;
+        }
+        if (first == last) {
+            break;
+        }
+
+        const auto parsed = from_chars(first, last, out[count]);
+        if (parsed.error != parse_error::none) {
+            return parse_column_result{count, first, parsed.error};
+        }
+
+        const char *end = detail::skip_spaces(parsed.ptr, last);
+        if (end != last && *end != delimiter && *end != '\n' && *end != '\r') {
+            return parse_column_result{count, first, parse_error::unknown_unit};
+        }
+        first = end;
+        ++count;
+    }
+    return parse_column_result{count, first, parse_error::none};
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+
+#include "distance.hpp"
+#include "span.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+// Representation in which values stored as Rep are accumulated:
+// single precision storage is accumulated in double precision
+template<class Rep>
+struct accumulation_rep {
+    using type = Rep;
+};
+
+template<>
+struct accumulation_rep<float> {
+    using type = double;
+};
+
+template<class Quantity>
+using accumulator_type =
+    typename rebind_rep<Quantity, typename accumulation_rep<typename Quantity::rep>::type>::type;
+
+// Sum of [first, last) in the same unit, accumulated in accumulation_rep.
+// Values may be stored compactly (e.g. sipp::f32::Meters) without losing precision in the total.
+template<class Quantity>
+inline accumulator_type<Quantity> accumulate(const Quantity *first, const Quantity *last)
+{
+    using rep = typename accumulator_type<Quantity>::rep;
+
+    // independent partial sums keep the additions pipelined
+    rep partial[4] = {rep(0), rep(0), rep(0), rep(0)};
+    const auto count = static_cast<std::size_t>(last - first);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        partial[0] += static_cast<rep>(first[i].count());
+        partial[1] += static_cast<rep>(first[i + 1].count());
+        partial[2] += static_cast<rep>(first[i + 2].count());
+        partial[3] += static_cast<rep>(first[i + 3].count());
+    }
+    for (; i < count; ++i) {
+        partial[0] += static_cast<rep>(first[i].count());
+    }
+    return accumulator_type<Quantity>((partial[0] + partial[1]) + (partial[2] + partial[3]));
+}
+
+template<class Quantity>
+inline accumulator_type<typename std::remove_const<Quantity>::type> accumulate(span<Quantity> values)
+{
+    const typename std::add_const<Quantity>::type *first = values.data();
+    return accumulate(first, first + values.size());
+}
+
+}
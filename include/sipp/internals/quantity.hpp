@@ -0,0 +1,383 @@
+#pragma once
+
+#include <chrono>
+#include <ratio>
+#include <type_traits>
+
+#include "conversion.hpp"
+#include "dimension.hpp"
+#include "distance.hpp"
+#include "quantity_fwd.hpp"
+#include "speed.hpp"
+
+namespace sipp {
+
+namespace detail {
+
+template<class Rep, class Dimension, class Ratio>
+struct quantity_traits<Quantity<Rep, Dimension, Ratio>> {
+    using dimension = Dimension;
+    using ratio = Ratio;
+};
+
+// Durations are quantities of time, so they convert to and from Quantity like any other
+template<class Rep, class Period>
+struct quantity_traits<std::chrono::duration<Rep, Period>> {
+    using dimension = dimensions::time;
+    using ratio = Period;
+};
+
+template<class Quantity1, class Quantity2>
+using is_same_dimension = std::is_same<typename quantity_traits<Quantity1>::dimension,
+                                       typename quantity_traits<Quantity2>::dimension>;
+
+}
+
+template<class Rep0, class Dimension, class Ratio, class Rep>
+struct rebind_rep<Quantity<Rep0, Dimension, Ratio>, Rep> {
+    using type = Quantity<Rep, Dimension, Ratio>;
+};
+
+}
+
+namespace std {
+
+// Quantity able to represent both operands exactly, as for std::chrono::duration
+template<class Rep1, class Dimension, class Ratio1, class Rep2, class Ratio2>
+struct common_type<sipp::Quantity<Rep1, Dimension, Ratio1>, sipp::Quantity<Rep2, Dimension, Ratio2>> {
+    using type = sipp::Quantity<typename common_type<Rep1, Rep2>::type,
+                                Dimension,
+                                sipp::detail::common_ratio<Ratio1, Ratio2>>;
+};
+
+}
+
+namespace sipp {
+
+// Converts between any quantities of the same dimension: Quantity, Distance, Speed and
+// std::chrono::duration, with the rounding policies of distance_cast
+template<class ToQuantity, class Rounding = rounding::toward_zero, class FromQuantity>
+constexpr ToQuantity quantity_cast(const FromQuantity &quantity)
+{
+    SIPP_TRACE_CONVERSION(FromQuantity, ToQuantity);
+    static_assert(detail::is_same_dimension<ToQuantity, FromQuantity>::value,
+                  "Quantities of different dimensions can not be converted");
+    using conversion = detail::unit_conversion<typename ToQuantity::rep,
+                                               typename detail::quantity_traits<ToQuantity>::ratio,
+                                               typename FromQuantity::rep,
+                                               typename detail::quantity_traits<FromQuantity>::ratio,
+                                               Rounding>;
+
+    return ToQuantity(conversion::apply(quantity.count()));
+}
+
+// Count of Rep in units of Ratio (relative to the coherent SI unit) of a Dimension.
+// Products and quotients of quantities multiply the counts only: dimensions and ratios
+// are combined in the result type, conversion factors are applied once on cast.
+template<class Rep, class Dimension, class Ratio>
+class Quantity {
+public:
+    using rep = Rep;
+    using dimension = Dimension;
+    using ratio = Ratio;
+
+    constexpr Quantity() : m_count(0)
+    {}
+
+    template<class Rep2,
+        class = typename std::enable_if<!detail::is_quantity<Rep2>::value>::type>
+    constexpr explicit Quantity(const Rep2 &value): m_count(value)
+    {}
+
+    // From any quantity of the same dimension, including Distance, Speed and durations
+    template<class Other,
+        class = typename std::enable_if<detail::is_quantity<Other>::value
+                                            && detail::is_same_dimension<Quantity, Other>::value>::type,
+        class = void>
+    constexpr Quantity(const Other &other)
+        : m_count(quantity_cast<Quantity>(other).count())
+    {
+        static_assert(detail::is_lossless_conversion<
+                          Rep,
+                          typename Other::rep,
+                          std::ratio_divide<typename detail::quantity_traits<Other>::ratio, Ratio>>::value,
+                      "Use sipp::quantity_cast<> to perform explicit cast of integer types "
+                          "(possible precision loss)");
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr Quantity &operator+=(const Quantity<Rep2, Dimension, Ratio2> &other)
+    {
+        *this = *this + other;
+        return *this;
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr Quantity &operator-=(const Quantity<Rep2, Dimension, Ratio2> &other)
+    {
+        *this = *this - other;
+        return *this;
+    }
+
+    template<class Rep2>
+    constexpr Quantity &operator*=(const Rep2 &multiplier)
+    {
+        m_count *= multiplier;
+        return *this;
+    }
+
+    template<class Rep2>
+    constexpr Quantity &operator/=(const Rep2 &divider)
+    {
+        m_count /= divider;
+        return *this;
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator<(const Quantity<Rep2, Dimension, Ratio2> &other) const
+    {
+        using counts = detail::comparable_counts<Quantity, Quantity<Rep2, Dimension, Ratio2>>;
+        return counts::lhs(*this) < counts::rhs(other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator<=(const Quantity<Rep2, Dimension, Ratio2> &other) const
+    {
+        using counts = detail::comparable_counts<Quantity, Quantity<Rep2, Dimension, Ratio2>>;
+        return counts::lhs(*this) <= counts::rhs(other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator>(const Quantity<Rep2, Dimension, Ratio2> &other) const
+    {
+        return !(*this <= other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator>=(const Quantity<Rep2, Dimension, Ratio2> &other) const
+    {
+        return !(*this < other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator==(const Quantity<Rep2, Dimension, Ratio2> &other) const
+    {
+        using counts = detail::comparable_counts<Quantity, Quantity<Rep2, Dimension, Ratio2>>;
+        return counts::lhs(*this) == counts::rhs(other);
+    }
+
+    template<class Rep2, class Ratio2>
+    constexpr bool operator!=(const Quantity<Rep2, Dimension, Ratio2> &other) const
+    {
+        return !(*this == other);
+    }
+
+    constexpr Quantity operator-() const
+    {
+        return Quantity(-m_count);
+    }
+
+    constexpr const Rep &count() const
+    { return m_count; }
+
+    constexpr Quantity abs() const
+    {
+        return Quantity(m_count < Rep(0) ? -m_count : m_count);
+    }
+
+private:
+    Rep m_count;
+};
+
+// The same value as a Quantity, e.g. Quantity<double, dimensions::length, std::kilo> for Kilometers
+template<class Other,
+    class = typename std::enable_if<detail::is_quantity<Other>::value>::type>
+constexpr Quantity<typename Other::rep,
+                   typename detail::quantity_traits<Other>::dimension,
+                   typename detail::quantity_traits<Other>::ratio> as_quantity(const Other &quantity)
+{
+    return Quantity<typename Other::rep,
+                    typename detail::quantity_traits<Other>::dimension,
+                    typename detail::quantity_traits<Other>::ratio>(quantity.count());
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Ratio2, class Dimension>
+constexpr typename std::common_type<Quantity<Rep1, Dimension, Ratio1>, Quantity<Rep2, Dimension, Ratio2>>::type
+operator+(const Quantity<Rep1, Dimension, Ratio1> &quantity1, const Quantity<Rep2, Dimension, Ratio2> &quantity2)
+{
+    using common = typename std::common_type<Quantity<Rep1, Dimension, Ratio1>,
+                                             Quantity<Rep2, Dimension, Ratio2>>::type;
+    return common(quantity_cast<common>(quantity1).count() + quantity_cast<common>(quantity2).count());
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Ratio2, class Dimension>
+constexpr typename std::common_type<Quantity<Rep1, Dimension, Ratio1>, Quantity<Rep2, Dimension, Ratio2>>::type
+operator-(const Quantity<Rep1, Dimension, Ratio1> &quantity1, const Quantity<Rep2, Dimension, Ratio2> &quantity2)
+{
+    using common = typename std::common_type<Quantity<Rep1, Dimension, Ratio1>,
+                                             Quantity<Rep2, Dimension, Ratio2>>::type;
+    return common(quantity_cast<common>(quantity1).count() - quantity_cast<common>(quantity2).count());
+}
+
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class Dimension2, class Ratio2>
+constexpr Quantity<typename std::common_type<Rep1, Rep2>::type,
+                   dimension_multiply<Dimension1, Dimension2>,
+                   std::ratio_multiply<Ratio1, Ratio2>>
+operator*(const Quantity<Rep1, Dimension1, Ratio1> &quantity1, const Quantity<Rep2, Dimension2, Ratio2> &quantity2)
+{
+    return Quantity<typename std::common_type<Rep1, Rep2>::type,
+                    dimension_multiply<Dimension1, Dimension2>,
+                    std::ratio_multiply<Ratio1, Ratio2>>(quantity1.count() * quantity2.count());
+}
+
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class Dimension2, class Ratio2>
+constexpr Quantity<typename std::common_type<Rep1, Rep2>::type,
+                   dimension_divide<Dimension1, Dimension2>,
+                   std::ratio_divide<Ratio1, Ratio2>>
+operator/(const Quantity<Rep1, Dimension1, Ratio1> &quantity1, const Quantity<Rep2, Dimension2, Ratio2> &quantity2)
+{
+    return Quantity<typename std::common_type<Rep1, Rep2>::type,
+                    dimension_divide<Dimension1, Dimension2>,
+                    std::ratio_divide<Ratio1, Ratio2>>(quantity1.count() / quantity2.count());
+}
+
+template<class Rep, class Dimension, class Ratio, class Rep2,
+    class = typename std::enable_if<!detail::is_quantity<Rep2>::value>::type>
+constexpr Quantity<Rep, Dimension, Ratio> operator*(const Quantity<Rep, Dimension, Ratio> &quantity,
+                                                    const Rep2 &multiplier)
+{
+    static_assert(std::is_integral<Rep2>::value ||
+                      std::is_floating_point<Rep2>::value,
+                  "Allowed to multiply Quantity only on integral or floating point types");
+
+    return Quantity<Rep, Dimension, Ratio>(quantity.count() * multiplier);
+}
+
+template<class Rep, class Dimension, class Ratio, class Rep2,
+    class = typename std::enable_if<!detail::is_quantity<Rep2>::value>::type>
+constexpr Quantity<Rep, Dimension, Ratio> operator*(const Rep2 &multiplier,
+                                                    const Quantity<Rep, Dimension, Ratio> &quantity)
+{
+    return quantity * multiplier;
+}
+
+template<class Rep, class Dimension, class Ratio, class Rep2,
+    class = typename std::enable_if<!detail::is_quantity<Rep2>::value>::type>
+constexpr Quantity<Rep, Dimension, Ratio> operator/(const Quantity<Rep, Dimension, Ratio> &quantity,
+                                                    const Rep2 &divider)
+{
+    static_assert(std::is_integral<Rep2>::value ||
+                      std::is_floating_point<Rep2>::value,
+                  "Allowed to divide Quantity only by integral or floating point types");
+
+    return Quantity<Rep, Dimension, Ratio>(quantity.count() / divider);
+}
+
+// Products and quotients of Quantity with Distance, Speed and durations, and the derived
+// quantities of distances and speeds alone (area, gradient, acceleration)
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class Ratio2>
+constexpr auto operator*(const Quantity<Rep1, Dimension1, Ratio1> &quantity, const Distance<Rep2, Ratio2> &distance)
+    -> decltype(quantity * as_quantity(distance))
+{
+    return quantity * as_quantity(distance);
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Dimension2, class Ratio2>
+constexpr auto operator*(const Distance<Rep1, Ratio1> &distance, const Quantity<Rep2, Dimension2, Ratio2> &quantity)
+    -> decltype(as_quantity(distance) * quantity)
+{
+    return as_quantity(distance) * quantity;
+}
+
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class Ratio2>
+constexpr auto operator/(const Quantity<Rep1, Dimension1, Ratio1> &quantity, const Distance<Rep2, Ratio2> &distance)
+    -> decltype(quantity / as_quantity(distance))
+{
+    return quantity / as_quantity(distance);
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Dimension2, class Ratio2>
+constexpr auto operator/(const Distance<Rep1, Ratio1> &distance, const Quantity<Rep2, Dimension2, Ratio2> &quantity)
+    -> decltype(as_quantity(distance) / quantity)
+{
+    return as_quantity(distance) / quantity;
+}
+
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class DistanceType2, class Ratio2>
+constexpr auto operator*(const Quantity<Rep1, Dimension1, Ratio1> &quantity,
+                         const Speed<Rep2, DistanceType2, Ratio2> &speed)
+    -> decltype(quantity * as_quantity(speed))
+{
+    return quantity * as_quantity(speed);
+}
+
+template<class Rep1, class DistanceType1, class Ratio1, class Rep2, class Dimension2, class Ratio2>
+constexpr auto operator*(const Speed<Rep1, DistanceType1, Ratio1> &speed,
+                         const Quantity<Rep2, Dimension2, Ratio2> &quantity)
+    -> decltype(as_quantity(speed) * quantity)
+{
+    return as_quantity(speed) * quantity;
+}
+
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class DistanceType2, class Ratio2>
+constexpr auto operator/(const Quantity<Rep1, Dimension1, Ratio1> &quantity,
+                         const Speed<Rep2, DistanceType2, Ratio2> &speed)
+    -> decltype(quantity / as_quantity(speed))
+{
+    return quantity / as_quantity(speed);
+}
+
+template<class Rep1, class DistanceType1, class Ratio1, class Rep2, class Dimension2, class Ratio2>
+constexpr auto operator/(const Speed<Rep1, DistanceType1, Ratio1> &speed,
+                         const Quantity<Rep2, Dimension2, Ratio2> &quantity)
+    -> decltype(as_quantity(speed) / quantity)
+{
+    return as_quantity(speed) / quantity;
+}
+
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class Period2>
+constexpr auto operator*(const Quantity<Rep1, Dimension1, Ratio1> &quantity,
+                         const std::chrono::duration<Rep2, Period2> &time)
+    -> decltype(quantity * as_quantity(time))
+{
+    return quantity * as_quantity(time);
+}
+
+template<class Rep1, class Period1, class Rep2, class Dimension2, class Ratio2>
+constexpr auto operator*(const std::chrono::duration<Rep1, Period1> &time,
+                         const Quantity<Rep2, Dimension2, Ratio2> &quantity)
+    -> decltype(as_quantity(time) * quantity)
+{
+    return as_quantity(time) * quantity;
+}
+
+template<class Rep1, class Dimension1, class Ratio1, class Rep2, class Period2>
+constexpr auto operator/(const Quantity<Rep1, Dimension1, Ratio1> &quantity,
+                         const std::chrono::duration<Rep2, Period2> &time)
+    -> decltype(quantity / as_quantity(time))
+{
+    return quantity / as_quantity(time);
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Ratio2>
+constexpr auto operator*(const Distance<Rep1, Ratio1> &distance1, const Distance<Rep2, Ratio2> &distance2)
+    -> decltype(as_quantity(distance1) * as_quantity(distance2))
+{
+    return as_quantity(distance1) * as_quantity(distance2);
+}
+
+template<class Rep1, class Ratio1, class Rep2, class Ratio2>
+constexpr auto operator/(const Distance<Rep1, Ratio1> &distance1, const Distance<Rep2, Ratio2> &distance2)
+    -> decltype(as_quantity(distance1) / as_quantity(distance2))
+{
+    return as_quantity(distance1) / as_quantity(distance2);
+}
+
+template<class Rep, class DistanceType, class Ratio, class RepTime, class PeriodTime>
+constexpr auto operator/(const Speed<Rep, DistanceType, Ratio> &speed, const std::chrono::duration<RepTime, PeriodTime> &time)
+    -> decltype(as_quantity(speed) / as_quantity(time))
+{
+    return as_quantity(speed) / as_quantity(time);
+}
+
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <ratio>
+
+#include "dimension.hpp"
+
+namespace sipp {
+
+template<class Rep, class Dimension, class Ratio = std::ratio<1>>
+class Quantity;
+
+using Seconds = Quantity<double, dimensions::time, std::ratio<1>>;
+using SquareMeters = Quantity<double, dimensions::area, std::ratio<1>>;
+using SquareKilometers = Quantity<double, dimensions::area, std::mega>;
+using SquareNauticalMiles = Quantity<double, dimensions::area, std::ratio<1852 * 1852>>;
+using MetersPerSecondSquared = Quantity<double, dimensions::acceleration, std::ratio<1>>;
+using KnotsPerSecond = Quantity<double, dimensions::acceleration, std::ratio<1852, 3600>>;
+using StandardGravities = Quantity<double, dimensions::acceleration, std::ratio<980665, 100000>>;
+// Climb and descent gradients
+using FeetPerNauticalMile = Quantity<double, dimensions::dimensionless, std::ratio<3048, 18520000>>;
+using Percent = Quantity<double, dimensions::dimensionless, std::centi>;
+
+}
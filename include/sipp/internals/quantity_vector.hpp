@@ -0,0 +1,346 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "batch.hpp"
+#include "conversion.hpp"
+#include "span.hpp"
+
+namespace sipp {
+
+// Iterator over raw counts, yielding them as Quantity values converted from FromQuantity
+// on access. It has the random access operations, but dereferencing returns a value rather
+// than a reference, so it only claims to be an input iterator.
+template<class Quantity, class FromQuantity>
+class quantity_iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Quantity;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Quantity;
+
+    constexpr quantity_iterator() : m_position(nullptr)
+    {}
+
+    constexpr explicit quantity_iterator(const typename FromQuantity::rep *position)
+        : m_position(position)
+    {}
+
+    constexpr Quantity operator*() const
+    { return convert(*m_position); }
+
+    constexpr Quantity operator[](difference_type offset) const
+    { return convert(m_position[offset]); }
+
+    quantity_iterator &operator++()
+    {
+        ++m_position;
+        return *this;
+    }
+
+    quantity_iterator operator++(int)
+    {
+        auto copy = *this;
+        ++m_position;
+        return copy;
+    }
+
+    quantity_iterator &operator--()
+    {
+        --m_position;
+        return *this;
+    }
+
+    quantity_iterator operator--(int)
+    {
+        auto copy = *this;
+        --m_position;
+        return copy;
+    }
+
+    quantity_iterator &operator+=(difference_type offset)
+    {
+        m_position += offset;
+        return *this;
+    }
+
+    quantity_iterator &operator-=(difference_type offset)
+    {
+        m_position -= offset;
+        return *this;
+    }
+
+    constexpr quantity_iterator operator+(difference_type offset) const
+    { return quantity_iterator(m_position + offset); }
+
+    constexpr quantity_iterator operator-(difference_type offset) const
+    { return quantity_iterator(m_position - offset); }
+
+    constexpr difference_type operator-(const quantity_iterator &other) const
+    { return m_position - other.m_position; }
+
+    constexpr bool operator==(const quantity_iterator &other) const
+    { return m_position == other.m_position; }
+
+    constexpr bool operator!=(const quantity_iterator &other) const
+    { return m_position != other.m_position; }
+
+    constexpr bool operator<(const quantity_iterator &other) const
+    { return m_position < other.m_position; }
+
+    constexpr bool operator<=(const quantity_iterator &other) const
+    { return m_position <= other.m_position; }
+
+    constexpr bool operator>(const quantity_iterator &other) const
+    { return m_position > other.m_position; }
+
+    constexpr bool operator>=(const quantity_iterator &other) const
+    { return m_position >= other.m_position; }
+
+private:
+    static constexpr Quantity convert(const typename FromQuantity::rep &count)
+    { return Quantity(detail::quantity_conversion<Quantity, FromQuantity>::apply(count)); }
+
+    const typename FromQuantity::rep *m_position;
+};
+
+template<class Quantity>
+class quantity_vector;
+
+// Read-only view of raw FromQuantity counts as Quantity values. Nothing is copied,
+// every access applies the folded conversion factor.
+template<class Quantity, class FromQuantity = Quantity>
+class quantity_view {
+public:
+    using value_type = Quantity;
+    using rep = typename Quantity::rep;
+    using source_type = FromQuantity;
+    using size_type = std::size_t;
+    using const_iterator = quantity_iterator<Quantity, FromQuantity>;
+    using iterator = const_iterator;
+
+    constexpr quantity_view() : m_data(nullptr), m_size(0)
+    {}
+
+    constexpr quantity_view(const typename FromQuantity::rep *data, std::size_t size)
+        : m_data(data), m_size(size)
+    {}
+
+    constexpr std::size_t size() const
+    { return m_size; }
+
+    constexpr bool empty() const
+    { return m_size == 0; }
+
+    constexpr Quantity operator[](std::size_t index) const
+    { return begin()[static_cast<std::ptrdiff_t>(index)]; }
+
+    constexpr const_iterator begin() const
+    { return const_iterator(m_data); }
+
+    constexpr const_iterator end() const
+    { return const_iterator(m_data + m_size); }
+
+    // Raw counts in the source unit
+    constexpr const typename FromQuantity::rep *source_data() const
+    { return m_data; }
+
+    constexpr quantity_view subview(std::size_t offset, std::size_t count) const
+    { return quantity_view(m_data + offset, count); }
+
+    template<class Quantity2>
+    constexpr quantity_view<Quantity2, FromQuantity> as() const
+    { return quantity_view<Quantity2, FromQuantity>(m_data, m_size); }
+
+    // Converts the whole view into out (which must hold at least size() elements)
+    void copy_to(rep *out) const
+    {
+        detail::convert_reps<typename detail::quantity_factor<Quantity, FromQuantity>::type>(
+            m_data, out, m_size);
+    }
+
+    quantity_vector<Quantity> materialize() const;
+
+private:
+    const typename FromQuantity::rep *m_data;
+    std::size_t m_size;
+};
+
+// Contiguous storage of raw counts tagged with a unit, e.g. quantity_vector<Meters>.
+// Same memory layout as std::vector<Quantity::rep>, with bulk conversions and
+// zero-copy views in other units.
+template<class Quantity>
+class quantity_vector {
+public:
+    using value_type = Quantity;
+    using rep = typename Quantity::rep;
+    using size_type = std::size_t;
+    using const_iterator = quantity_iterator<Quantity, Quantity>;
+    using iterator = const_iterator;
+
+    quantity_vector() = default;
+
+    explicit quantity_vector(std::size_t count, const Quantity &value = Quantity())
+        : m_counts(count, value.count())
+    {}
+
+    quantity_vector(std::initializer_list<Quantity> values)
+    {
+        m_counts.reserve(values.size());
+        for (const auto &value : values) {
+            m_counts.push_back(value.count());
+        }
+    }
+
+    template<class Quantity2, class FromQuantity2>
+    explicit quantity_vector(const quantity_view<Quantity2, FromQuantity2> &view)
+    {
+        assign(view);
+    }
+
+    template<class Quantity2, class FromQuantity2>
+    void assign(const quantity_view<Quantity2, FromQuantity2> &view)
+    {
+        m_counts.resize(view.size());
+        view.template as<Quantity>().copy_to(m_counts.data());
+    }
+
+    std::size_t size() const
+    { return m_counts.size(); }
+
+    bool empty() const
+    { return m_counts.empty(); }
+
+    std::size_t capacity() const
+    { return m_counts.capacity(); }
+
+    void reserve(std::size_t count)
+    { m_counts.reserve(count); }
+
+    void resize(std::size_t count, const Quantity &value = Quantity())
+    { m_counts.resize(count, value.count()); }
+
+    void clear()
+    { m_counts.clear(); }
+
+    void shrink_to_fit()
+    { m_counts.shrink_to_fit(); }
+
+    void push_back(const Quantity &value)
+    { m_counts.push_back(value.count()); }
+
+    void pop_back()
+    { m_counts.pop_back(); }
+
+    Quantity operator[](std::size_t index) const
+    { return Quantity(m_counts[index]); }
+
+    Quantity front() const
+    { return Quantity(m_counts.front()); }
+
+    Quantity back() const
+    { return Quantity(m_counts.back()); }
+
+    void set(std::size_t index, const Quantity &value)
+    { m_counts[index] = value.count(); }
+
+    const_iterator begin() const
+    { return const_iterator(m_counts.data()); }
+
+    const_iterator end() const
+    { return const_iterator(m_counts.data() + m_counts.size()); }
+
+    rep *data()
+    { return m_counts.data(); }
+
+    const rep *data() const
+    { return m_counts.data(); }
+
+    quantity_view<Quantity, Quantity> view() const
+    { return quantity_view<Quantity, Quantity>(m_counts.data(), m_counts.size()); }
+
+    // Zero-copy view of the stored values in another unit
+    template<class Quantity2>
+    quantity_view<Quantity2, Quantity> as() const
+    { return view().template as<Quantity2>(); }
+
+    // Copy of the stored values in another unit
+    template<class Quantity2>
+    quantity_vector<Quantity2> to() const
+    { return quantity_vector<Quantity2>(as<Quantity2>()); }
+
+    template<class Rep2>
+    quantity_vector &operator*=(const Rep2 &multiplier)
+    {
+        for (auto &count : m_counts) {
+            count *= multiplier;
+        }
+        return *this;
+    }
+
+    template<class Rep2>
+    quantity_vector &operator/=(const Rep2 &divider)
+    {
+        for (auto &count : m_counts) {
+            count /= divider;
+        }
+        return *this;
+    }
+
+    // Element-wise sum with values of any unit of the same dimension. Throws
+    // std::invalid_argument, leaving the vector unchanged, when the sizes differ
+    template<class Quantity2, class FromQuantity2>
+    quantity_vector &operator+=(const quantity_view<Quantity2, FromQuantity2> &other)
+    {
+        const auto converted = other.template as<Quantity>();
+        const std::size_t count = checked_size(converted.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            m_counts[i] += converted[i].count();
+        }
+        return *this;
+    }
+
+    template<class Quantity2, class FromQuantity2>
+    quantity_vector &operator-=(const quantity_view<Quantity2, FromQuantity2> &other)
+    {
+        const auto converted = other.template as<Quantity>();
+        const std::size_t count = checked_size(converted.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            m_counts[i] -= converted[i].count();
+        }
+        return *this;
+    }
+
+    template<class Quantity2>
+    quantity_vector &operator+=(const quantity_vector<Quantity2> &other)
+    { return *this += other.view(); }
+
+    template<class Quantity2>
+    quantity_vector &operator-=(const quantity_vector<Quantity2> &other)
+    { return *this -= other.view(); }
+
+private:
+    std::size_t checked_size(std::size_t other) const
+    {
+        if (other != m_counts.size()) {
+            throw std::invalid_argument("quantity_vector sizes differ");
+        }
+        return other;
+    }
+
+    std::vector<rep> m_counts;
+};
+
+template<class Quantity, class FromQuantity>
+inline quantity_vector<Quantity> quantity_view<Quantity, FromQuantity>::materialize() const
+{
+    return quantity_vector<Quantity>(*this);
+}
+
+}
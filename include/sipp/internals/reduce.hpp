@@ -0,0 +1,527 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <ratio>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "conversion.hpp"
+#include "precision.hpp"
+#include "quantity.hpp"
+#include "span.hpp"
+
+namespace sipp {
+
+// Execution policies of the reductions, as std::execution::seq and std::execution::par.
+// Both split the input into the same fixed chunks and combine the partial results in
+// chunk order, so the parallel result is bit-identical to the sequential one.
+namespace execution {
+
+struct sequenced_policy {};
+
+struct parallel_policy {
+    // worker threads including the calling one, 0 for std::thread::hardware_concurrency()
+    std::size_t threads;
+};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{0};
+
+}
+
+// Count, extrema, mean and population variance of an array of quantities.
+// mean and stddev() are in the unit of the values, variance in its square
+// (e.g. knots squared), both in at least double precision.
+template<class Quantity>
+struct summary {
+    using mean_rep = typename std::common_type<typename Quantity::rep, double>::type;
+    using mean_type = typename rebind_rep<Quantity, mean_rep>::type;
+    using variance_type = sipp::Quantity<mean_rep,
+                                         dimension_multiply<typename detail::quantity_traits<Quantity>::dimension,
+                                                            typename detail::quantity_traits<Quantity>::dimension>,
+                                         std::ratio_multiply<typename detail::quantity_traits<Quantity>::ratio,
+                                                             typename detail::quantity_traits<Quantity>::ratio>>;
+
+    std::size_t count;
+    Quantity min;
+    Quantity max;
+    mean_type mean;
+    variance_type variance;
+
+    mean_type stddev() const
+    {
+        return mean_type(std::sqrt(variance.count()));
+    }
+};
+
+namespace detail {
+
+// Elements per chunk: a chunk of doubles fits in L2, and the number of chunks (hence the
+// partial results) stays small for 10^8 elements
+constexpr std::size_t reduce_chunk_size = std::size_t(1) << 14;
+
+inline std::size_t worker_count(execution::sequenced_policy, std::size_t)
+{
+    return 1;
+}
+
+inline std::size_t worker_count(const execution::parallel_policy &policy, std::size_t chunks)
+{
+    std::size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, std::min(threads, chunks));
+}
+
+// Calls function(worker, chunk, begin, end) for every chunk of [0, count). Workers take the
+// next chunk from a shared counter, so a worker slowed down by the OS does not hold back the
+// others. The calling thread is worker 0. If function throws (in any worker) or a thread can
+// not be started, the remaining chunks are dropped, every started thread is joined and the
+// first exception is rethrown in the calling thread.
+template<class Function>
+inline void for_each_chunk(std::size_t count, std::size_t workers, Function function)
+{
+    const std::size_t chunks = (count + reduce_chunk_size - 1) / reduce_chunk_size;
+    std::atomic<std::size_t> next(0);
+    std::atomic_flag failed = ATOMIC_FLAG_INIT;
+    std::exception_ptr failure;
+    auto work = [&](std::size_t worker) {
+        try {
+            for (std::size_t chunk = next++; chunk < chunks; chunk = next++) {
+                const std::size_t begin = chunk * reduce_chunk_size;
+                function(worker, chunk, begin, std::min(count, begin + reduce_chunk_size));
+            }
+        } catch (...) {
+            next = chunks;
+            if (!failed.test_and_set()) {
+                failure = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    try {
+        threads.reserve(workers - 1);
+        for (std::size_t worker = 1; worker < workers; ++worker) {
+            threads.emplace_back(work, worker);
+        }
+    } catch (...) {
+        next = chunks;
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    work(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+template<class Policy>
+inline std::size_t chunk_workers(const Policy &policy, std::size_t count)
+{
+    return worker_count(policy, (count + reduce_chunk_size - 1) / reduce_chunk_size);
+}
+
+// Value and rounding error of a sum, added with Neumaier's variant of Kahan summation
+template<class Rep>
+struct compensated {
+    Rep sum;
+    Rep error;
+
+    void add(Rep value)
+    {
+        const Rep total = sum + value;
+        error += std::abs(sum) >= std::abs(value) ? (sum - total) + value : (value - total) + sum;
+        sum = total;
+    }
+
+    Rep value() const
+    {
+        return sum + error;
+    }
+};
+
+// Sum of one chunk: blocks of 256 values are summed in eight independent lanes (an error
+// of at most 32 roundings), block totals are added with compensation. As accurate as
+// Kahan summation of every value in practice, at the speed of a plain loop.
+template<class Rep, class Quantity>
+inline compensated<Rep> chunk_sum(const Quantity *values, std::size_t count, std::true_type)
+{
+    constexpr std::size_t lanes = 8;
+    constexpr std::size_t block = 256;
+
+    compensated<Rep> result{Rep(0), Rep(0)};
+    std::size_t i = 0;
+    for (; i + block <= count; i += block) {
+        Rep partial[lanes] = {};
+        for (std::size_t j = i; j < i + block; j += lanes) {
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                partial[lane] += static_cast<Rep>(values[j + lane].count());
+            }
+        }
+        result.add(((partial[0] + partial[1]) + (partial[2] + partial[3]))
+                       + ((partial[4] + partial[5]) + (partial[6] + partial[7])));
+    }
+    for (; i < count; ++i) {
+        result.add(static_cast<Rep>(values[i].count()));
+    }
+    return result;
+}
+
+// Integral counts are summed exactly without compensation
+template<class Rep, class Quantity>
+inline compensated<Rep> chunk_sum(const Quantity *values, std::size_t count, std::false_type)
+{
+    Rep sum = Rep(0);
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += static_cast<Rep>(values[i].count());
+    }
+    return compensated<Rep>{sum, Rep(0)};
+}
+
+template<class Rep>
+struct chunk_moments {
+    std::size_t count;
+    Rep mean;
+    // sum of squared deviations from mean
+    Rep m2;
+};
+
+// Chan et al. pairwise update of count, mean and m2
+template<class Rep>
+inline void merge_moments(chunk_moments<Rep> &total, const chunk_moments<Rep> &chunk)
+{
+    if (chunk.count == 0) {
+        return;
+    }
+    const Rep count = static_cast<Rep>(total.count + chunk.count);
+    const Rep delta = chunk.mean - total.mean;
+    const Rep weight = static_cast<Rep>(chunk.count) / count;
+    total.mean += delta * weight;
+    total.m2 += chunk.m2 + delta * delta * static_cast<Rep>(total.count) * weight;
+    total.count += chunk.count;
+}
+
+template<class Quantity, class Policy>
+inline accumulator_type<Quantity> sum(const Policy &policy, const Quantity *values, std::size_t count)
+{
+    using rep = typename accumulator_type<Quantity>::rep;
+
+    std::vector<compensated<rep>> partial((count + reduce_chunk_size - 1) / reduce_chunk_size);
+    for_each_chunk(count, chunk_workers(policy, count),
+                   [&](std::size_t, std::size_t chunk, std::size_t begin, std::size_t end) {
+                       partial[chunk] = chunk_sum<rep>(values + begin, end - begin,
+                                                       std::is_floating_point<rep>());
+                   });
+
+    compensated<rep> total{rep(0), rep(0)};
+    for (const auto &chunk : partial) {
+        total.add(chunk.sum);
+        total.add(chunk.error);
+    }
+    return accumulator_type<Quantity>(total.value());
+}
+
+// Largest and smallest counts of a representation, infinite if it has infinities: the
+// identities of min and max
+template<class Rep>
+constexpr Rep highest_count()
+{
+    return std::numeric_limits<Rep>::has_infinity ? std::numeric_limits<Rep>::infinity()
+                                                  : std::numeric_limits<Rep>::max();
+}
+
+template<class Rep>
+constexpr Rep lowest_count()
+{
+    return std::numeric_limits<Rep>::has_infinity ? -std::numeric_limits<Rep>::infinity()
+                                                  : std::numeric_limits<Rep>::lowest();
+}
+
+// NaN is the only value which differs from itself; always false for integral counts
+template<class Rep>
+constexpr bool is_nan(const Rep &value)
+{
+    return value != value;
+}
+
+template<class Quantity, class Policy>
+inline summary<Quantity> summarize(const Policy &policy, const Quantity *values, std::size_t count)
+{
+    using result_type = summary<Quantity>;
+    using rep = typename result_type::mean_rep;
+    using count_rep = typename Quantity::rep;
+
+    struct chunk_summary {
+        count_rep min;
+        count_rep max;
+        chunk_moments<rep> moments;
+    };
+
+    std::vector<chunk_summary> partial((count + reduce_chunk_size - 1) / reduce_chunk_size);
+    for_each_chunk(count, chunk_workers(policy, count),
+                   [&](std::size_t, std::size_t chunk, std::size_t begin, std::size_t end) {
+                       // two passes over a chunk which is still in cache: mean first, then
+                       // squared deviations from it, which does not cancel like sum(x^2) - n*mean^2
+                       auto min = highest_count<count_rep>();
+                       auto max = lowest_count<count_rep>();
+                       std::size_t ordered = 0;
+                       rep sum = rep(0);
+                       // without branches: comparisons with NaN are false, so min and max skip it
+                       for (std::size_t i = begin; i < end; ++i) {
+                           const auto value = values[i].count();
+                           const bool skipped = is_nan(value);
+                           min = value < min ? value : min;
+                           max = max < value ? value : max;
+                           sum += skipped ? rep(0) : static_cast<rep>(value);
+                           ordered += skipped ? 0 : 1;
+                       }
+                       const rep mean = ordered != 0 ? sum / static_cast<rep>(ordered) : rep(0);
+                       rep m2 = rep(0);
+                       for (std::size_t i = begin; i < end; ++i) {
+                           const auto value = values[i].count();
+                           const rep deviation = is_nan(value) ? rep(0) : static_cast<rep>(value) - mean;
+                           m2 += deviation * deviation;
+                       }
+                       partial[chunk] = chunk_summary{min, max, chunk_moments<rep>{ordered, mean, m2}};
+                   });
+
+    if (partial.empty()) {
+        return result_type{0, Quantity(), Quantity(), typename result_type::mean_type(),
+                           typename result_type::variance_type()};
+    }
+
+    auto min = highest_count<count_rep>();
+    auto max = lowest_count<count_rep>();
+    chunk_moments<rep> moments{0, rep(0), rep(0)};
+    for (const auto &chunk : partial) {
+        if (chunk.moments.count != 0) {
+            min = chunk.min < min ? chunk.min : min;
+            max = max < chunk.max ? chunk.max : max;
+            merge_moments(moments, chunk.moments);
+        }
+    }
+    if (moments.count == 0) {
+        // only NaNs
+        const auto nan = std::numeric_limits<count_rep>::quiet_NaN();
+        return result_type{0, Quantity(nan), Quantity(nan),
+                           typename result_type::mean_type(std::numeric_limits<rep>::quiet_NaN()),
+                           typename result_type::variance_type(std::numeric_limits<rep>::quiet_NaN())};
+    }
+    return result_type{moments.count,
+                       Quantity(min),
+                       Quantity(max),
+                       typename result_type::mean_type(moments.mean),
+                       typename result_type::variance_type(moments.m2 / static_cast<rep>(moments.count))};
+}
+
+// Bins of the quantile histogram: the result is within (max - min) / quantile_bins of the
+// exact quantile, max and min being the finite extrema
+constexpr std::size_t quantile_bins = 4096;
+
+// Number and extrema of the values in a bin of the quantile histogram
+template<class Rep>
+struct quantile_bin {
+    std::size_t count;
+    Rep min;
+    Rep max;
+};
+
+template<class Quantity, class Policy>
+inline typename summary<Quantity>::mean_type quantile(const Policy &policy,
+                                                      const Quantity *values,
+                                                      std::size_t count,
+                                                      double fraction)
+{
+    using mean_type = typename summary<Quantity>::mean_type;
+    using rep = typename summary<Quantity>::mean_rep;
+    constexpr rep infinity = std::numeric_limits<rep>::infinity();
+
+    if (count == 0) {
+        return mean_type();
+    }
+
+    // finite extrema and number of values by class: NaNs are skipped, infinities are the
+    // lowest and highest order statistics but stay out of the histogram range
+    struct chunk_range {
+        rep low;
+        rep high;
+        std::size_t finite;
+        std::size_t below;
+        std::size_t above;
+    };
+    const std::size_t workers = chunk_workers(policy, count);
+    std::vector<chunk_range> partial((count + reduce_chunk_size - 1) / reduce_chunk_size);
+    for_each_chunk(count, workers,
+                   [&](std::size_t, std::size_t chunk, std::size_t begin, std::size_t end) {
+                       chunk_range range{infinity, -infinity, 0, 0, 0};
+                       for (std::size_t i = begin; i < end; ++i) {
+                           const rep value = static_cast<rep>(values[i].count());
+                           if (value == -infinity) {
+                               ++range.below;
+                           } else if (value == infinity) {
+                               ++range.above;
+                           } else if (!is_nan(value)) {
+                               range.low = std::min(range.low, value);
+                               range.high = std::max(range.high, value);
+                               ++range.finite;
+                           }
+                       }
+                       partial[chunk] = range;
+                   });
+    chunk_range total{infinity, -infinity, 0, 0, 0};
+    for (const auto &range : partial) {
+        total.low = std::min(total.low, range.low);
+        total.high = std::max(total.high, range.high);
+        total.finite += range.finite;
+        total.below += range.below;
+        total.above += range.above;
+    }
+    const std::size_t ordered = total.below + total.finite + total.above;
+    if (ordered == 0) {
+        return mean_type(std::numeric_limits<rep>::quiet_NaN());
+    }
+    const rep low = total.low;
+    const rep high = total.high;
+
+    // one histogram per worker rather than per chunk, merged into the first one; halves
+    // keep the range finite between the largest counts of opposite signs
+    std::vector<quantile_bin<rep>> bins;
+    if (low < high) {
+        const rep scale = static_cast<rep>(quantile_bins / 2) / (high / 2 - low / 2);
+        bins.assign(workers * quantile_bins, quantile_bin<rep>{0, infinity, -infinity});
+        for_each_chunk(count, workers,
+                       [&](std::size_t worker, std::size_t, std::size_t begin, std::size_t end) {
+                           quantile_bin<rep> *const histogram = bins.data() + worker * quantile_bins;
+                           for (std::size_t i = begin; i < end; ++i) {
+                               const rep value = static_cast<rep>(values[i].count());
+                               // NaNs and infinities fail the comparisons
+                               if (!(value >= low && value <= high)) {
+                                   continue;
+                               }
+                               const rep position = (value / 2 - low / 2) * scale;
+                               auto &bin = histogram[position < static_cast<rep>(quantile_bins)
+                                                         ? static_cast<std::size_t>(position)
+                                                         : quantile_bins - 1];
+                               ++bin.count;
+                               bin.min = std::min(bin.min, value);
+                               bin.max = std::max(bin.max, value);
+                           }
+                       });
+        for (std::size_t worker = 1; worker < workers; ++worker) {
+            for (std::size_t index = 0; index < quantile_bins; ++index) {
+                const auto &bin = bins[worker * quantile_bins + index];
+                bins[index].count += bin.count;
+                bins[index].min = std::min(bins[index].min, bin.min);
+                bins[index].max = std::max(bins[index].max, bin.max);
+            }
+        }
+    }
+
+    // Estimate of the order statistic of the given rank (from 0): exact for a bin holding
+    // one distinct value, otherwise spread evenly between the extrema of its bin
+    const auto order_statistic = [&](std::size_t rank) {
+        if (rank < total.below) {
+            return -infinity;
+        }
+        rank -= total.below;
+        if (rank >= total.finite) {
+            return infinity;
+        }
+        if (!(low < high)) {
+            return low;
+        }
+        std::size_t before = 0;
+        for (std::size_t index = 0;; ++index) {
+            const auto &bin = bins[index];
+            if (rank < before + bin.count) {
+                return bin.count == 1 ? bin.min
+                                      : bin.min + (bin.max - bin.min) * static_cast<rep>(rank - before)
+                                                      / static_cast<rep>(bin.count - 1);
+            }
+            before += bin.count;
+        }
+    };
+
+    // linear interpolation between the order statistics around the rank (numpy default)
+    const rep rank = static_cast<rep>(std::min(std::max(fraction, 0.0), 1.0)) * static_cast<rep>(ordered - 1);
+    const auto below = std::min(static_cast<std::size_t>(rank), ordered - 1);
+    const rep weight = rank - static_cast<rep>(below);
+    const rep first = order_statistic(below);
+    if (!(weight > rep(0))) {
+        return mean_type(first);
+    }
+    const rep second = order_statistic(below + 1);
+    if (std::isinf(first)) {
+        // -inf and +inf around the rank: no value between them
+        return mean_type(std::isinf(second) && second != first ? std::numeric_limits<rep>::quiet_NaN() : first);
+    }
+    if (std::isinf(second)) {
+        return mean_type(second);
+    }
+    return mean_type(first + (second - first) * weight);
+}
+
+}
+
+// Sum in accumulation_rep with Kahan-Neumaier compensation: the error does not grow
+// with the number of terms, unlike a running total through operator+=
+template<class Policy, class Quantity>
+inline accumulator_type<typename std::remove_const<Quantity>::type> sum(const Policy &policy, span<Quantity> values)
+{
+    return detail::sum(policy, values.data(), values.size());
+}
+
+template<class Quantity>
+inline accumulator_type<typename std::remove_const<Quantity>::type> sum(span<Quantity> values)
+{
+    return sum(execution::seq, values);
+}
+
+// Count, min, max, mean and variance in a single call (two passes over every chunk).
+// All members are zero for an empty array. NaN values are skipped as by quantile: count
+// is the number of the other values, the statistics are NaN if every value is NaN.
+template<class Policy, class Quantity>
+inline summary<typename std::remove_const<Quantity>::type> summarize(const Policy &policy, span<Quantity> values)
+{
+    return detail::summarize(policy, values.data(), values.size());
+}
+
+template<class Quantity>
+inline summary<typename std::remove_const<Quantity>::type> summarize(span<Quantity> values)
+{
+    return summarize(execution::seq, values);
+}
+
+// Approximate quantile (fraction 0.5 is the median) from a histogram of the values, without
+// sorting or copying them: linear interpolation between the two order statistics around
+// the rank (numpy's default), each estimated within its histogram bin. The error is at most
+// (max - min) / 4096 over the finite values, none for values alone in their bin; zero for an
+// empty array. Infinite values are ordered below or above every finite value and may be the
+// result. NaN values are skipped, as numpy's nanquantile: the result is the quantile of the
+// other values, NaN if every value is NaN.
+template<class Policy, class Quantity>
+inline typename summary<typename std::remove_const<Quantity>::type>::mean_type quantile(const Policy &policy,
+                                                                                       span<Quantity> values,
+                                                                                       double fraction)
+{
+    return detail::quantile(policy, values.data(), values.size(), fraction);
+}
+
+template<class Quantity>
+inline typename summary<typename std::remove_const<Quantity>::type>::mean_type quantile(span<Quantity> values,
+                                                                                       double fraction)
+{
+    return quantile(execution::seq, values, fraction);
+}
+
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <cstddef>
+
+#include "batch.hpp"
+
+namespace sipp {
+
+namespace detail {
+
+// Cephes minimax polynomials of sin and cos on [-pi/4, pi/4], highest degree first:
+// sin(r) = r + r^3 * P(r^2), cos(r) = 1 - r^2 / 2 + r^4 * Q(r^2), within 1 ulp
+constexpr double sin_coefficients[6] = {
+    1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+    -1.98412698295895385996e-4, 8.33333333332211858878e-3, -1.66666666666666307295e-1};
+constexpr double cos_coefficients[6] = {
+    -1.13585365213876817300e-11, 2.08757008419747316778e-9, -2.75573141792967388112e-7,
+    2.48015872888517045348e-5, -1.38888888888730564116e-3, 4.16666666666665929218e-2};
+
+// pi / 2 in three parts (Cody-Waite): x - k * pi / 2 is exact to double precision for |k| < 2^20
+constexpr double pio2_1 = 1.57079625129699707031e+00;
+constexpr double pio2_2 = 7.54978941586159635336e-08;
+constexpr double pio2_3 = 5.39030285815811905290e-15;
+constexpr double two_over_pi = 0.636619772367581343076;
+constexpr double half_pi = 1.57079632679489661923;
+
+// fdlibm rational approximation on [0, 0.5]: asin(x) = x + x * t * P(t) / Q(t), t = x^2;
+// above 0.5, asin(x) = pi / 2 - 2 * asin(sqrt((1 - x) / 2)). Within 2 ulp.
+constexpr double asin_p[6] = {
+    3.47933107596021167570e-05, 7.91534994289814532176e-04, -4.00555345006794114027e-02,
+    2.01212532134862925881e-01, -3.25565818622400915405e-01, 1.66666666666666657415e-01};
+constexpr double asin_q[5] = {
+    7.70381505559019352791e-02, -6.88283971605453293030e-01, 2.02094576023350569471e+00,
+    -2.40339491173441421878e+00, 1.0};
+
+// Cephes rational approximation on [0, 0.66]: atan(x) = x + x * z * P(z) / Q(z), z = x^2;
+// up to 1, atan(x) = pi / 4 + atan((x - 1) / (x + 1)). Within 2 ulp.
+constexpr double atan_p[5] = {
+    -8.750608600031904122785e-01, -1.615753718733365076637e+01, -7.500855792314704667340e+01,
+    -1.228866684490136173410e+02, -6.485021904942025371773e+01};
+constexpr double atan_q[6] = {
+    1.0, 2.485846490142306297962e+01, 1.650270098316988542046e+02,
+    4.328810604912902668951e+02, 4.853903996359136964868e+02, 1.945506571482613964425e+02};
+constexpr double quarter_pi = 0.785398163397448309616;
+constexpr double pi = 3.14159265358979323846;
+// pi / 4 - quarter_pi, the bits the double constant misses
+constexpr double quarter_pi_tail = 3.061616997868382943065e-17;
+
+#ifdef SIPP_SIMD_X86
+
+template<std::size_t N>
+SIPP_TARGET("avx2")
+inline __m256d horner_avx2(__m256d x, const double (&coefficients)[N])
+{
+    __m256d result = _mm256_set1_pd(coefficients[0]);
+    for (std::size_t i = 1; i < N; ++i) {
+        result = _mm256_add_pd(_mm256_mul_pd(result, x), _mm256_set1_pd(coefficients[i]));
+    }
+    return result;
+}
+
+// sin(x + quadrant * pi / 2): quadrant 0 gives sin(x), quadrant 1 gives cos(x)
+SIPP_TARGET("avx2")
+inline __m256d sin_avx2(__m256d x, int quadrant)
+{
+    const __m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(two_over_pi)),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(pio2_1)));
+    r = _mm256_sub_pd(r, _mm256_mul_pd(k, _mm256_set1_pd(pio2_2)));
+    r = _mm256_sub_pd(r, _mm256_mul_pd(k, _mm256_set1_pd(pio2_3)));
+
+    const __m256d z = _mm256_mul_pd(r, r);
+    const __m256d sin = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, z), horner_avx2(z, sin_coefficients)));
+    const __m256d cos = _mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_mul_pd(_mm256_set1_pd(0.5), z)),
+                                      _mm256_mul_pd(_mm256_mul_pd(z, z), horner_avx2(z, cos_coefficients)));
+
+    // odd quadrants take the cosine, quadrants 2 and 3 are negated
+    const __m256i q = _mm256_cvtepi32_epi64(_mm_add_epi32(_mm256_cvtpd_epi32(k), _mm_set1_epi32(quadrant)));
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256d odd = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(q, one), one));
+    const __m256d sign = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_and_si256(q, _mm256_set1_epi64x(2)), 62));
+    return _mm256_xor_pd(_mm256_blendv_pd(sin, cos, odd), sign);
+}
+
+SIPP_TARGET("avx2")
+inline __m256d asin_avx2(__m256d x)
+{
+    const __m256d sign_bit = _mm256_set1_pd(-0.0);
+    const __m256d a = _mm256_andnot_pd(sign_bit, x);
+    const __m256d large = _mm256_cmp_pd(a, _mm256_set1_pd(0.5), _CMP_GE_OQ);
+
+    const __m256d t = _mm256_blendv_pd(_mm256_mul_pd(a, a),
+                                       _mm256_mul_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), a), _mm256_set1_pd(0.5)),
+                                       large);
+    const __m256d ratio = _mm256_div_pd(_mm256_mul_pd(t, horner_avx2(t, asin_p)), horner_avx2(t, asin_q));
+    const __m256d s = _mm256_blendv_pd(a, _mm256_sqrt_pd(t), large);
+    const __m256d y = _mm256_add_pd(s, _mm256_mul_pd(s, ratio));
+    const __m256d result = _mm256_blendv_pd(y, _mm256_sub_pd(_mm256_set1_pd(half_pi), _mm256_add_pd(y, y)), large);
+    return _mm256_or_pd(result, _mm256_and_pd(sign_bit, x));
+}
+
+// atan(x) for x in [0, 1]
+SIPP_TARGET("avx2")
+inline __m256d atan_unit_avx2(__m256d x)
+{
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d large = _mm256_cmp_pd(x, _mm256_set1_pd(0.66), _CMP_GT_OQ);
+    const __m256d t = _mm256_blendv_pd(x, _mm256_div_pd(_mm256_sub_pd(x, one), _mm256_add_pd(x, one)), large);
+    const __m256d z = _mm256_mul_pd(t, t);
+    const __m256d ratio = _mm256_div_pd(_mm256_mul_pd(z, horner_avx2(z, atan_p)), horner_avx2(z, atan_q));
+    const __m256d y = _mm256_add_pd(t, _mm256_mul_pd(t, ratio));
+    const __m256d offset = _mm256_and_pd(large, _mm256_set1_pd(quarter_pi));
+    const __m256d tail = _mm256_and_pd(large, _mm256_set1_pd(quarter_pi_tail));
+    return _mm256_add_pd(offset, _mm256_add_pd(y, tail));
+}
+
+// atan2(y, x) of finite arguments, signed zeros handled as std::atan2
+SIPP_TARGET("avx2")
+inline __m256d atan2_avx2(__m256d y, __m256d x)
+{
+    const __m256d sign_bit = _mm256_set1_pd(-0.0);
+    const __m256d a = _mm256_andnot_pd(sign_bit, y);
+    const __m256d b = _mm256_andnot_pd(sign_bit, x);
+    const __m256d steep = _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+    const __m256d numerator = _mm256_min_pd(a, b);
+    const __m256d denominator = _mm256_max_pd(a, b);
+    // 0 / 0 gives 0
+    const __m256d nonzero = _mm256_cmp_pd(denominator, _mm256_setzero_pd(), _CMP_NEQ_OQ);
+    const __m256d t = _mm256_and_pd(nonzero, _mm256_div_pd(numerator, denominator));
+
+    __m256d angle = atan_unit_avx2(t);
+    angle = _mm256_blendv_pd(angle, _mm256_sub_pd(_mm256_set1_pd(half_pi), angle), steep);
+    angle = _mm256_blendv_pd(angle, _mm256_sub_pd(_mm256_set1_pd(pi), angle), _mm256_and_pd(x, sign_bit));
+    return _mm256_or_pd(angle, _mm256_and_pd(y, sign_bit));
+}
+
+// The AVX-512 functions use the zero-masked forms of the intrinsics with all lanes enabled:
+// GCC 12 reports the undefined source operand of the plain forms as maybe-uninitialized
+constexpr unsigned char all_lanes = 0xFF;
+
+template<std::size_t N>
+SIPP_TARGET("avx512f")
+inline __m512d horner_avx512(__m512d x, const double (&coefficients)[N])
+{
+    __m512d result = _mm512_set1_pd(coefficients[0]);
+    for (std::size_t i = 1; i < N; ++i) {
+        result = _mm512_add_pd(_mm512_mul_pd(result, x), _mm512_set1_pd(coefficients[i]));
+    }
+    return result;
+}
+
+SIPP_TARGET("avx512f")
+inline __m512d sin_avx512(__m512d x, int quadrant)
+{
+    const __m512d k = _mm512_maskz_roundscale_pd(all_lanes, _mm512_mul_pd(x, _mm512_set1_pd(two_over_pi)),
+                                                 _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_sub_pd(x, _mm512_mul_pd(k, _mm512_set1_pd(pio2_1)));
+    r = _mm512_sub_pd(r, _mm512_mul_pd(k, _mm512_set1_pd(pio2_2)));
+    r = _mm512_sub_pd(r, _mm512_mul_pd(k, _mm512_set1_pd(pio2_3)));
+
+    const __m512d z = _mm512_mul_pd(r, r);
+    const __m512d sin = _mm512_add_pd(r, _mm512_mul_pd(_mm512_mul_pd(r, z), horner_avx512(z, sin_coefficients)));
+    const __m512d cos = _mm512_add_pd(_mm512_sub_pd(_mm512_set1_pd(1.0), _mm512_mul_pd(_mm512_set1_pd(0.5), z)),
+                                      _mm512_mul_pd(_mm512_mul_pd(z, z), horner_avx512(z, cos_coefficients)));
+
+    const __m512i q = _mm512_maskz_cvtepi32_epi64(
+        all_lanes, _mm256_add_epi32(_mm512_maskz_cvtpd_epi32(all_lanes, k), _mm256_set1_epi32(quadrant)));
+    const __mmask8 odd = _mm512_test_epi64_mask(q, _mm512_set1_epi64(1));
+    const __m512i sign = _mm512_maskz_slli_epi64(all_lanes, _mm512_and_si512(q, _mm512_set1_epi64(2)), 62);
+    return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_mask_blend_pd(odd, sin, cos)), sign));
+}
+
+SIPP_TARGET("avx512f")
+inline __m512d asin_avx512(__m512d x)
+{
+    const __m512i sign_bit = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+    const __m512d a = _mm512_castsi512_pd(_mm512_maskz_andnot_epi64(all_lanes, sign_bit, _mm512_castpd_si512(x)));
+    const __mmask8 large = _mm512_cmp_pd_mask(a, _mm512_set1_pd(0.5), _CMP_GE_OQ);
+
+    const __m512d t = _mm512_mask_blend_pd(large, _mm512_mul_pd(a, a),
+                                           _mm512_mul_pd(_mm512_sub_pd(_mm512_set1_pd(1.0), a), _mm512_set1_pd(0.5)));
+    const __m512d ratio = _mm512_div_pd(_mm512_mul_pd(t, horner_avx512(t, asin_p)), horner_avx512(t, asin_q));
+    const __m512d s = _mm512_mask_blend_pd(large, a, _mm512_maskz_sqrt_pd(all_lanes, t));
+    const __m512d y = _mm512_add_pd(s, _mm512_mul_pd(s, ratio));
+    const __m512d result = _mm512_mask_blend_pd(large, y,
+                                                _mm512_sub_pd(_mm512_set1_pd(half_pi), _mm512_add_pd(y, y)));
+    return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(result),
+                                               _mm512_and_si512(_mm512_castpd_si512(x), sign_bit)));
+}
+
+SIPP_TARGET("avx512f")
+inline __m512d atan_unit_avx512(__m512d x)
+{
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __mmask8 large = _mm512_cmp_pd_mask(x, _mm512_set1_pd(0.66), _CMP_GT_OQ);
+    const __m512d t = _mm512_mask_blend_pd(large, x, _mm512_div_pd(_mm512_sub_pd(x, one), _mm512_add_pd(x, one)));
+    const __m512d z = _mm512_mul_pd(t, t);
+    const __m512d ratio = _mm512_div_pd(_mm512_mul_pd(z, horner_avx512(z, atan_p)), horner_avx512(z, atan_q));
+    const __m512d y = _mm512_add_pd(t, _mm512_mul_pd(t, ratio));
+    return _mm512_add_pd(_mm512_maskz_mov_pd(large, _mm512_set1_pd(quarter_pi)),
+                         _mm512_add_pd(y, _mm512_maskz_mov_pd(large, _mm512_set1_pd(quarter_pi_tail))));
+}
+
+SIPP_TARGET("avx512f")
+inline __m512d atan2_avx512(__m512d y, __m512d x)
+{
+    const __m512i sign_bit = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+    const __m512d a = _mm512_castsi512_pd(_mm512_maskz_andnot_epi64(all_lanes, sign_bit, _mm512_castpd_si512(y)));
+    const __m512d b = _mm512_castsi512_pd(_mm512_maskz_andnot_epi64(all_lanes, sign_bit, _mm512_castpd_si512(x)));
+    const __mmask8 steep = _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+    const __mmask8 nonzero = _mm512_cmp_pd_mask(a, _mm512_setzero_pd(), _CMP_NEQ_OQ)
+                             | _mm512_cmp_pd_mask(b, _mm512_setzero_pd(), _CMP_NEQ_OQ);
+    const __m512d t = _mm512_maskz_div_pd(nonzero, _mm512_maskz_min_pd(all_lanes, a, b),
+                                          _mm512_maskz_max_pd(all_lanes, a, b));
+
+    __m512d angle = atan_unit_avx512(t);
+    angle = _mm512_mask_blend_pd(steep, angle, _mm512_sub_pd(_mm512_set1_pd(half_pi), angle));
+    const __mmask8 negative_x = _mm512_test_epi64_mask(_mm512_castpd_si512(x), sign_bit);
+    angle = _mm512_mask_blend_pd(negative_x, angle, _mm512_sub_pd(_mm512_set1_pd(pi), angle));
+    return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(angle),
+                                               _mm512_and_si512(_mm512_castpd_si512(y), sign_bit)));
+}
+
+#endif
+
+}
+
+}
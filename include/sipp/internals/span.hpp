@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace sipp {
+
+// Minimal non-owning view over a contiguous sequence (subset of C++20 std::span)
+template<class T>
+class span {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using size_type = std::size_t;
+    using pointer = T *;
+    using reference = T &;
+    using iterator = T *;
+
+    constexpr span() : m_data(nullptr), m_size(0)
+    {}
+
+    constexpr span(T *data, std::size_t size) : m_data(data), m_size(size)
+    {}
+
+    constexpr span(T *first, T *last) : m_data(first), m_size(static_cast<std::size_t>(last - first))
+    {}
+
+    template<std::size_t N>
+    constexpr span(T (&array)[N]) : m_data(array), m_size(N)
+    {}
+
+    template<class Container,
+        class = typename std::enable_if<
+            !std::is_same<typename std::remove_cv<Container>::type, span>::value
+                && std::is_convertible<decltype(std::declval<Container &>().data()),
+                                       T *>::value>::type>
+    constexpr span(Container &container) : m_data(container.data()), m_size(container.size())
+    {}
+
+    template<class U,
+        class = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    constexpr span(const span<U> &other) : m_data(other.data()), m_size(other.size())
+    {}
+
+    constexpr T *data() const
+    { return m_data; }
+
+    constexpr std::size_t size() const
+    { return m_size; }
+
+    constexpr bool empty() const
+    { return m_size == 0; }
+
+    constexpr T *begin() const
+    { return m_data; }
+
+    constexpr T *end() const
+    { return m_data + m_size; }
+
+    constexpr T &operator[](std::size_t index) const
+    { return m_data[index]; }
+
+    constexpr span<T> first(std::size_t count) const
+    { return span<T>(m_data, count); }
+
+    constexpr span<T> last(std::size_t count) const
+    { return span<T>(m_data + (m_size - count), count); }
+
+    constexpr span<T> subspan(std::size_t offset, std::size_t count) const
+    { return span<T>(m_data + offset, count); }
+
+    constexpr span<T> subspan(std::size_t offset) const
+    { return span<T>(m_data + offset, m_size - offset); }
+
+private:
+    T *m_data;
+    std::size_t m_size;
+};
+
+}
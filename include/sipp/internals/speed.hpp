@@ -1,6 +1,5 @@
 #pragma once
 
-#include <cmath>
 #include <chrono>
 
 #include "distance.hpp"
@@ -8,16 +7,71 @@
 
 namespace sipp {
 
-template<class ToSpeed, class Rep, class DistanceType, class Ratio>
+namespace detail {
+
+// Speed unit expressed as a single ratio of meters per second
+template<class DistanceType, class Ratio>
+using speed_ratio = std::ratio_divide<typename DistanceType::ratio, Ratio>;
+
+template<class Rep, class DistanceType, class Ratio>
+struct quantity_traits<Speed<Rep, DistanceType, Ratio>> {
+    using dimension = speed_dimension;
+    using ratio = speed_ratio<DistanceType, Ratio>;
+};
+
+}
+
+template<class Rep0, class DistanceType, class Ratio, class Rep>
+struct rebind_rep<Speed<Rep0, DistanceType, Ratio>, Rep> {
+    using type = Speed<Rep, typename rebind_rep<DistanceType, Rep>::type, Ratio>;
+};
+
+}
+
+namespace std {
+
+// Speed able to represent both operands exactly, as for std::chrono::duration
+template<class Rep1, class DistanceType1, class Ratio1, class Rep2, class DistanceType2, class Ratio2>
+struct common_type<sipp::Speed<Rep1, DistanceType1, Ratio1>, sipp::Speed<Rep2, DistanceType2, Ratio2>> {
+    using type = sipp::Speed<typename common_type<Rep1, Rep2>::type,
+                             typename common_type<DistanceType1, DistanceType2>::type,
+                             sipp::detail::common_period<Ratio1, Ratio2>>;
+};
+
+}
+
+namespace sipp {
+
+template<class ToSpeed, class Rounding = rounding::toward_zero, class Rep, class DistanceType, class Ratio>
 constexpr ToSpeed speed_cast(const Speed<Rep, DistanceType, Ratio> &speed)
 {
-    const auto converted_distance =
-        distance_cast<typename ToSpeed::distance_type>(DistanceType(speed.count())).count();
-    const auto converted_period =
-        (static_cast<double>(Ratio::num) * static_cast<double>(ToSpeed::ratio::den))
-            / (static_cast<double>(Ratio::den) * static_cast<double>(ToSpeed::ratio::num));
+    SIPP_TRACE_CONVERSION(Speed<Rep, DistanceType, Ratio>, ToSpeed);
+    using conversion = detail::unit_conversion<
+        typename ToSpeed::rep,
+        detail::speed_ratio<typename ToSpeed::distance_type, typename ToSpeed::ratio>,
+        Rep,
+        detail::speed_ratio<DistanceType, Ratio>,
+        Rounding>;
+
+    return ToSpeed(conversion::apply(speed.count()));
+}
+
+template<class ToSpeed, class Rep, class DistanceType, class Ratio>
+constexpr ToSpeed floor(const Speed<Rep, DistanceType, Ratio> &speed)
+{
+    return speed_cast<ToSpeed, rounding::downward>(speed);
+}
 
-    return ToSpeed(static_cast<typename ToSpeed::rep>(converted_distance / converted_period));
+template<class ToSpeed, class Rep, class DistanceType, class Ratio>
+constexpr ToSpeed ceil(const Speed<Rep, DistanceType, Ratio> &speed)
+{
+    return speed_cast<ToSpeed, rounding::upward>(speed);
+}
+
+template<class ToSpeed, class Rep, class DistanceType, class Ratio>
+constexpr ToSpeed round(const Speed<Rep, DistanceType, Ratio> &speed)
+{
+    return speed_cast<ToSpeed, rounding::to_nearest>(speed);
 }
 
 template<class Rep, class DistanceType, class Ratio = std::ratio<1>>
@@ -36,18 +90,22 @@ public:
 
     template<class Rep2, class DistanceType2, class Ratio2>
     constexpr Speed(const Speed<Rep2, DistanceType2, Ratio2> &other)
+        : m_count(speed_cast<Speed<Rep, DistanceType, Ratio>>(other).count())
     {
-        *this = other;
+        static_assert(detail::is_lossless_conversion<
+                          Rep,
+                          Rep2,
+                          std::ratio_divide<detail::speed_ratio<DistanceType2, Ratio2>,
+                                            detail::speed_ratio<DistanceType, Ratio>>>::value,
+                      "Use sipp::speed_cast<> to perform explicit cast of integer types "
+                          "(possible precision loss)");
     }
 
     template<class Rep2, class DistanceType2, class Ratio2>
-    constexpr void operator=(const Speed<Rep2, DistanceType2, Ratio2> &other)
+    constexpr Speed<Rep, DistanceType, Ratio> &operator=(const Speed<Rep2, DistanceType2, Ratio2> &other)
     {
-        static_assert(std::is_floating_point<Rep>::value
-                          && std::is_floating_point<Rep2>::value,
-                      "Use sipp::speed_cast<> to perform explicit cast of integer types "
-                          "(possible precision loss)");
-        *this = speed_cast<Speed<Rep, DistanceType, Ratio>>(other);
+        *this = Speed<Rep, DistanceType, Ratio>(other);
+        return *this;
     }
 
     template<class Rep2, class DistanceType2, class Ratio2>
@@ -87,7 +145,9 @@ public:
                                          DistanceType2,
                                          Ratio2> &other) const
     {
-        return m_count < speed_cast<Speed<Rep, DistanceType, Ratio>>(other).m_count;
+        using counts = detail::comparable_counts<Speed<Rep, DistanceType, Ratio>,
+                                                 Speed<Rep2, DistanceType2, Ratio2>>;
+        return counts::lhs(*this) < counts::rhs(other);
     }
 
     template<class Rep2, class DistanceType2, class Ratio2>
@@ -95,7 +155,9 @@ public:
                                           DistanceType2,
                                           Ratio2> &other) const
     {
-        return m_count <= speed_cast<Speed<Rep, DistanceType, Ratio>>(other).m_count;
+        using counts = detail::comparable_counts<Speed<Rep, DistanceType, Ratio>,
+                                                 Speed<Rep2, DistanceType2, Ratio2>>;
+        return counts::lhs(*this) <= counts::rhs(other);
     }
 
     template<class Rep2, class DistanceType2, class Ratio2>
@@ -119,7 +181,17 @@ public:
                                           DistanceType2,
                                           Ratio2> &other) const
     {
-        return m_count == speed_cast<Speed<Rep, DistanceType, Ratio>>(other).m_count;
+        using counts = detail::comparable_counts<Speed<Rep, DistanceType, Ratio>,
+                                                 Speed<Rep2, DistanceType2, Ratio2>>;
+        return counts::lhs(*this) == counts::rhs(other);
+    }
+
+    template<class Rep2, class DistanceType2, class Ratio2>
+    constexpr bool operator!=(const Speed<Rep2,
+                                          DistanceType2,
+                                          Ratio2> &other) const
+    {
+        return !(*this == other);
     }
 
     constexpr Speed<Rep, DistanceType, Ratio> operator-() const
@@ -132,7 +204,7 @@ public:
 
     constexpr Speed<Rep, DistanceType, Ratio> abs() const
     {
-        return Speed<Rep, DistanceType, Ratio>(std::abs(m_count));
+        return Speed<Rep, DistanceType, Ratio>(m_count < Rep(0) ? -m_count : m_count);
     }
 
 private:
@@ -147,9 +219,14 @@ template<class Rep,
 constexpr DistanceType operator*(const Speed<Rep, DistanceType, Ratio> &speed,
                                  std::chrono::duration<RepTime, PeriodTime> time)
 {
-    using common_ratio = std::ratio_divide<PeriodTime, Ratio>;
-    return DistanceType(speed.count() * time.count() * static_cast<Rep>(common_ratio::num)
-                            / static_cast<Rep>(common_ratio::den));
+    using product_rep = typename std::common_type<Rep, RepTime>::type;
+    using conversion = detail::unit_conversion<typename DistanceType::rep,
+                                               Ratio,
+                                               product_rep,
+                                               PeriodTime>;
+
+    return DistanceType(conversion::apply(static_cast<product_rep>(speed.count())
+                                              * static_cast<product_rep>(time.count())));
 }
 
 template<class Rep,
@@ -182,11 +259,10 @@ constexpr std::chrono::duration<Rep, RatioSpeed> operator/(
     const Distance<Rep, Ratio> &distance,
     const Speed<RepSpeed, DistanceTypeSpeed, RatioSpeed> &speed)
 {
-    using common_ratio = std::ratio_divide<typename DistanceTypeSpeed::ratio, Ratio>;
+    using factor = std::ratio_divide<Ratio, typename DistanceTypeSpeed::ratio>;
 
-    auto d = static_cast<double>(common_ratio::den);
-    auto n = static_cast<double>(common_ratio::num);
-    return std::chrono::duration<Rep, RatioSpeed>(((distance.count() * (d / n)) / speed.count()));
+    return std::chrono::duration<Rep, RatioSpeed>(
+        detail::scaled_quotient<factor, Rep>(distance.count(), speed.count()));
 }
 
 template<class Rep,
@@ -233,15 +309,14 @@ template<class Rep1,
     class Rep2,
     class DistanceType2,
     class Ratio2>
-constexpr Speed<Rep1, DistanceType1, Ratio1> operator+(const Speed<Rep1,
-                                                                   DistanceType1,
-                                                                   Ratio1> &speed1,
-                                                       const Speed<Rep2,
-                                                                   DistanceType2,
-                                                                   Ratio2> &speed2)
+constexpr typename std::common_type<Speed<Rep1, DistanceType1, Ratio1>,
+                                    Speed<Rep2, DistanceType2, Ratio2>>::type
+operator+(const Speed<Rep1, DistanceType1, Ratio1> &speed1,
+          const Speed<Rep2, DistanceType2, Ratio2> &speed2)
 {
-    const Speed<Rep1, DistanceType1, Ratio1> converted_speed2 = speed2;
-    return Speed<Rep1, DistanceType1, Ratio1>(speed1.count() + converted_speed2.count());
+    using common = typename std::common_type<Speed<Rep1, DistanceType1, Ratio1>,
+                                             Speed<Rep2, DistanceType2, Ratio2>>::type;
+    return common(speed_cast<common>(speed1).count() + speed_cast<common>(speed2).count());
 }
 
 template<class Rep1,
@@ -250,55 +325,14 @@ template<class Rep1,
     class Rep2,
     class DistanceType2,
     class Ratio2>
-constexpr Speed<Rep1, DistanceType1, Ratio1> operator-(const Speed<Rep1,
-                                                                   DistanceType1,
-                                                                   Ratio1> &speed1,
-                                                       const Speed<Rep2,
-                                                                   DistanceType2,
-                                                                   Ratio2> &speed2)
+constexpr typename std::common_type<Speed<Rep1, DistanceType1, Ratio1>,
+                                    Speed<Rep2, DistanceType2, Ratio2>>::type
+operator-(const Speed<Rep1, DistanceType1, Ratio1> &speed1,
+          const Speed<Rep2, DistanceType2, Ratio2> &speed2)
 {
-    const Speed<Rep1, DistanceType1, Ratio1> converted_speed2 = speed2;
-    return Speed<Rep1, DistanceType1, Ratio1>(speed1.count() - converted_speed2.count());
-}
-
-namespace literals {
-
-constexpr KmPerHour operator "" _km_h(long double value)
-{ return KmPerHour(value); }
-
-constexpr KmPerHour operator "" _km_h(unsigned long long int value)
-{ return KmPerHour(value); }
-
-constexpr MetersPerSecond operator "" _m_s(long double value)
-{ return MetersPerSecond(value); }
-
-constexpr MetersPerSecond operator "" _m_s(unsigned long long int value)
-{ return MetersPerSecond(value); }
-
-constexpr FeetPerSecond operator "" _ft_s(long double value)
-{ return FeetPerSecond(value); }
-
-constexpr FeetPerSecond operator "" _ft_s(unsigned long long int value)
-{ return FeetPerSecond(value); }
-
-constexpr FeetPerMinute operator "" _ft_min(long double value)
-{ return FeetPerMinute(value); }
-
-constexpr FeetPerMinute operator "" _ft_min(unsigned long long int value)
-{ return FeetPerMinute(value); }
-
-constexpr Knots operator "" _kts(long double value)
-{ return Knots(value); }
-
-constexpr Knots operator "" _kts(unsigned long long int value)
-{ return Knots(value); }
-
-constexpr MilesPerHour operator "" _mph(long double value)
-{ return MilesPerHour(value); }
-
-constexpr MilesPerHour operator "" _mph(unsigned long long int value)
-{ return MilesPerHour(value); }
-
+    using common = typename std::common_type<Speed<Rep1, DistanceType1, Ratio1>,
+                                             Speed<Rep2, DistanceType2, Ratio2>>::type;
+    return common(speed_cast<common>(speed1).count() - speed_cast<common>(speed2).count());
 }
 
 }
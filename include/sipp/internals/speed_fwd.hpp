@@ -18,4 +18,16 @@ using FeetPerMinute = Speed<double, Feet, MinuteRatio>;
 using Knots = Speed<double, NauticalMiles, HourRatio>;
 using MilesPerHour = Speed<double, StatuteMiles, HourRatio>;
 
+// Single precision variants, e.g. sipp::f32::Knots
+namespace f32 {
+
+using KmPerHour = Speed<float, Kilometers, HourRatio>;
+using MetersPerSecond = Speed<float, Meters, SecondRatio>;
+using FeetPerSecond = Speed<float, Feet, SecondRatio>;
+using FeetPerMinute = Speed<float, Feet, MinuteRatio>;
+using Knots = Speed<float, NauticalMiles, HourRatio>;
+using MilesPerHour = Speed<float, StatuteMiles, HourRatio>;
+
+}
+
 }
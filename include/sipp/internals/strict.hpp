@@ -0,0 +1,188 @@
+#pragma once
+
+#include <type_traits>
+
+#include "conversion.hpp"
+#include "distance.hpp"
+#include "speed.hpp"
+#include "angle.hpp"
+#include "quantity.hpp"
+
+namespace sipp {
+
+// Quantities which never convert between units implicitly: construction, assignment,
+// arithmetic and comparison only compile for the same unit, every conversion is a
+// strict::quantity_cast<> and the boundary to the ordinary types is explicit:
+//
+//   sipp::strict::Meters altitude(sipp::Feet(1000.0));                     // error
+//   sipp::strict::Meters altitude(sipp::Meters(sipp::Feet(1000.0)));       // converted outside
+//   auto feet = sipp::strict::quantity_cast<sipp::strict::Feet>(altitude); // converted inside
+//   sipp::Feet plain = feet.quantity();
+namespace strict {
+
+template<class Quantity>
+class unit {
+    static_assert(detail::is_quantity<Quantity>::value, "sipp::strict::unit wraps a quantity type");
+
+public:
+    using quantity_type = Quantity;
+    using rep = typename Quantity::rep;
+
+    constexpr unit() = default;
+
+    constexpr explicit unit(const Quantity &quantity) : m_quantity(quantity)
+    {}
+
+    // Count in this unit
+    template<class Rep2, typename std::enable_if<std::is_arithmetic<Rep2>::value, int>::type = 0>
+    constexpr explicit unit(const Rep2 &count) : m_quantity(count)
+    {}
+
+    // Other units: convert the ordinary quantity first, or use strict::quantity_cast<>
+    template<class Quantity2,
+             typename std::enable_if<detail::is_quantity<Quantity2>::value
+                                         && !std::is_same<Quantity2, Quantity>::value,
+                                     int>::type = 0>
+    unit(const Quantity2 &) = delete;
+
+    template<class Quantity2>
+    unit(const unit<Quantity2> &) = delete;
+
+    constexpr const Quantity &quantity() const
+    { return m_quantity; }
+
+    constexpr rep count() const
+    { return m_quantity.count(); }
+
+    constexpr unit operator-() const
+    { return unit(-m_quantity.count()); }
+
+    constexpr unit &operator+=(const unit &other)
+    {
+        m_quantity = Quantity(m_quantity.count() + other.count());
+        return *this;
+    }
+
+    constexpr unit &operator-=(const unit &other)
+    {
+        m_quantity = Quantity(m_quantity.count() - other.count());
+        return *this;
+    }
+
+    constexpr unit &operator*=(const rep &multiplier)
+    {
+        m_quantity = Quantity(m_quantity.count() * multiplier);
+        return *this;
+    }
+
+    constexpr unit &operator/=(const rep &divider)
+    {
+        m_quantity = Quantity(m_quantity.count() / divider);
+        return *this;
+    }
+
+    friend constexpr unit operator+(const unit &lhs, const unit &rhs)
+    { return unit(lhs.count() + rhs.count()); }
+
+    friend constexpr unit operator-(const unit &lhs, const unit &rhs)
+    { return unit(lhs.count() - rhs.count()); }
+
+    friend constexpr unit operator*(const unit &lhs, const rep &multiplier)
+    { return unit(lhs.count() * multiplier); }
+
+    friend constexpr unit operator*(const rep &multiplier, const unit &rhs)
+    { return unit(multiplier * rhs.count()); }
+
+    friend constexpr unit operator/(const unit &lhs, const rep &divider)
+    { return unit(lhs.count() / divider); }
+
+    // Ratio of two values in the same unit
+    friend constexpr rep operator/(const unit &lhs, const unit &rhs)
+    { return lhs.count() / rhs.count(); }
+
+    friend constexpr bool operator==(const unit &lhs, const unit &rhs)
+    { return lhs.count() == rhs.count(); }
+
+    friend constexpr bool operator!=(const unit &lhs, const unit &rhs)
+    { return lhs.count() != rhs.count(); }
+
+    friend constexpr bool operator<(const unit &lhs, const unit &rhs)
+    { return lhs.count() < rhs.count(); }
+
+    friend constexpr bool operator<=(const unit &lhs, const unit &rhs)
+    { return lhs.count() <= rhs.count(); }
+
+    friend constexpr bool operator>(const unit &lhs, const unit &rhs)
+    { return lhs.count() > rhs.count(); }
+
+    friend constexpr bool operator>=(const unit &lhs, const unit &rhs)
+    { return lhs.count() >= rhs.count(); }
+
+private:
+    Quantity m_quantity;
+};
+
+// The only conversion between strict units, with the rounding policies of distance_cast
+template<class ToUnit, class Rounding = rounding::toward_zero, class Quantity>
+constexpr ToUnit quantity_cast(const unit<Quantity> &value)
+{
+    return ToUnit(sipp::quantity_cast<typename ToUnit::quantity_type, Rounding>(value.quantity()));
+}
+
+template<class Quantity>
+constexpr unit<Quantity> make_strict(const Quantity &quantity)
+{
+    return unit<Quantity>(quantity);
+}
+
+using Meters = unit<sipp::Meters>;
+using Kilometers = unit<sipp::Kilometers>;
+using Millimeters = unit<sipp::Millimeters>;
+using Micrometers = unit<sipp::Micrometers>;
+using Nanometers = unit<sipp::Nanometers>;
+using Feet = unit<sipp::Feet>;
+using NauticalMiles = unit<sipp::NauticalMiles>;
+using StatuteMiles = unit<sipp::StatuteMiles>;
+
+using KmPerHour = unit<sipp::KmPerHour>;
+using MetersPerSecond = unit<sipp::MetersPerSecond>;
+using FeetPerSecond = unit<sipp::FeetPerSecond>;
+using FeetPerMinute = unit<sipp::FeetPerMinute>;
+using Knots = unit<sipp::Knots>;
+using MilesPerHour = unit<sipp::MilesPerHour>;
+
+using Radians = unit<sipp::Radians>;
+using Degrees = unit<sipp::Degrees>;
+using ArcMinutes = unit<sipp::ArcMinutes>;
+using Turns = unit<sipp::Turns>;
+
+using Seconds = unit<sipp::Seconds>;
+
+namespace f32 {
+
+using Meters = unit<sipp::f32::Meters>;
+using Kilometers = unit<sipp::f32::Kilometers>;
+using Millimeters = unit<sipp::f32::Millimeters>;
+using Micrometers = unit<sipp::f32::Micrometers>;
+using Nanometers = unit<sipp::f32::Nanometers>;
+using Feet = unit<sipp::f32::Feet>;
+using NauticalMiles = unit<sipp::f32::NauticalMiles>;
+using StatuteMiles = unit<sipp::f32::StatuteMiles>;
+
+using KmPerHour = unit<sipp::f32::KmPerHour>;
+using MetersPerSecond = unit<sipp::f32::MetersPerSecond>;
+using FeetPerSecond = unit<sipp::f32::FeetPerSecond>;
+using FeetPerMinute = unit<sipp::f32::FeetPerMinute>;
+using Knots = unit<sipp::f32::Knots>;
+using MilesPerHour = unit<sipp::f32::MilesPerHour>;
+
+using Radians = unit<sipp::f32::Radians>;
+using Degrees = unit<sipp::f32::Degrees>;
+using ArcMinutes = unit<sipp::f32::ArcMinutes>;
+using Turns = unit<sipp::f32::Turns>;
+
+}
+
+}
+
+}
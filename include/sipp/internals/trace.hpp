@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "conversion.hpp"
+#include "angle_fwd.hpp"
+#include "distance_fwd.hpp"
+#include "quantity_fwd.hpp"
+#include "speed_fwd.hpp"
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define SIPP_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#ifndef SIPP_CONSTANT_EVALUATED
+// Casts can then not be evaluated at compile time while tracing
+#define SIPP_CONSTANT_EVALUATED() false
+#endif
+
+namespace sipp {
+
+// Number of casts between two units, from and to being typedef names (e.g. "Kilometers",
+// "f32::Feet") or the representation and ratio of other units
+struct conversion_count {
+    std::string from;
+    std::string to;
+    std::uint64_t count;
+};
+
+namespace detail {
+
+template<class Quantity>
+struct traced_name {
+    static std::string get()
+    {
+        using traits = quantity_traits<Quantity>;
+        using dimension = typename traits::dimension;
+        return std::string(std::is_floating_point<typename Quantity::rep>::value ? "float" : "integer")
+               + std::to_string(sizeof(typename Quantity::rep) * 8) + " m^" + std::to_string(dimension::length)
+               + " kg^" + std::to_string(dimension::mass) + " s^" + std::to_string(dimension::time)
+               + " rad^" + std::to_string(dimension::angle) + " x " + std::to_string(traits::ratio::num) + "/"
+               + std::to_string(traits::ratio::den);
+    }
+};
+
+#define SIPP_TRACED_NAME(Type) \
+    template<> \
+    struct traced_name<Type> { \
+        static std::string get() \
+        { return #Type; } \
+    }
+
+SIPP_TRACED_NAME(Meters);
+SIPP_TRACED_NAME(Kilometers);
+SIPP_TRACED_NAME(Millimeters);
+SIPP_TRACED_NAME(Micrometers);
+SIPP_TRACED_NAME(Nanometers);
+SIPP_TRACED_NAME(Feet);
+SIPP_TRACED_NAME(NauticalMiles);
+SIPP_TRACED_NAME(StatuteMiles);
+SIPP_TRACED_NAME(KmPerHour);
+SIPP_TRACED_NAME(MetersPerSecond);
+SIPP_TRACED_NAME(FeetPerSecond);
+SIPP_TRACED_NAME(FeetPerMinute);
+SIPP_TRACED_NAME(Knots);
+SIPP_TRACED_NAME(MilesPerHour);
+SIPP_TRACED_NAME(Radians);
+SIPP_TRACED_NAME(Degrees);
+SIPP_TRACED_NAME(ArcMinutes);
+SIPP_TRACED_NAME(Turns);
+SIPP_TRACED_NAME(Seconds);
+SIPP_TRACED_NAME(SquareMeters);
+SIPP_TRACED_NAME(SquareKilometers);
+SIPP_TRACED_NAME(SquareNauticalMiles);
+SIPP_TRACED_NAME(MetersPerSecondSquared);
+SIPP_TRACED_NAME(KnotsPerSecond);
+SIPP_TRACED_NAME(StandardGravities);
+SIPP_TRACED_NAME(FeetPerNauticalMile);
+SIPP_TRACED_NAME(Percent);
+SIPP_TRACED_NAME(f32::Meters);
+SIPP_TRACED_NAME(f32::Kilometers);
+SIPP_TRACED_NAME(f32::Millimeters);
+SIPP_TRACED_NAME(f32::Micrometers);
+SIPP_TRACED_NAME(f32::Nanometers);
+SIPP_TRACED_NAME(f32::Feet);
+SIPP_TRACED_NAME(f32::NauticalMiles);
+SIPP_TRACED_NAME(f32::StatuteMiles);
+SIPP_TRACED_NAME(f32::KmPerHour);
+SIPP_TRACED_NAME(f32::MetersPerSecond);
+SIPP_TRACED_NAME(f32::FeetPerSecond);
+SIPP_TRACED_NAME(f32::FeetPerMinute);
+SIPP_TRACED_NAME(f32::Knots);
+SIPP_TRACED_NAME(f32::MilesPerHour);
+SIPP_TRACED_NAME(f32::Radians);
+SIPP_TRACED_NAME(f32::Degrees);
+SIPP_TRACED_NAME(f32::ArcMinutes);
+SIPP_TRACED_NAME(f32::Turns);
+
+#undef SIPP_TRACED_NAME
+
+// Every traced (from, to) pair gets an index on its first cast; the counts of threads
+// which have exited are kept here
+class conversion_registry {
+public:
+    std::size_t add(std::string from, std::string to)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pairs.push_back(conversion_count{std::move(from), std::move(to), 0});
+        return m_pairs.size() - 1;
+    }
+
+    void merge(const std::vector<std::uint64_t> &counts)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            m_pairs[i].count += counts[i];
+        }
+    }
+
+    // Pairs with the exited threads' counts plus the given ones, most frequent first
+    std::vector<conversion_count> snapshot(const std::vector<std::uint64_t> &counts, bool exited) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<conversion_count> result;
+        for (std::size_t i = 0; i < m_pairs.size(); ++i) {
+            const std::uint64_t count = (exited ? m_pairs[i].count : 0) + (i < counts.size() ? counts[i] : 0);
+            if (count != 0) {
+                result.push_back(conversion_count{m_pairs[i].from, m_pairs[i].to, count});
+            }
+        }
+        std::stable_sort(result.begin(), result.end(), [](const conversion_count &a, const conversion_count &b) {
+            return a.count > b.count;
+        });
+        return result;
+    }
+
+    void reset_exited()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto &pair : m_pairs) {
+            pair.count = 0;
+        }
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<conversion_count> m_pairs;
+};
+
+inline conversion_registry &conversion_pairs()
+{
+    static conversion_registry registry;
+    return registry;
+}
+
+struct thread_conversion_counts {
+    std::vector<std::uint64_t> counts;
+
+    ~thread_conversion_counts()
+    {
+        conversion_pairs().merge(counts);
+    }
+};
+
+inline std::vector<std::uint64_t> &thread_counts()
+{
+    static thread_local thread_conversion_counts counts;
+    return counts.counts;
+}
+
+template<class From, class To>
+inline void count_conversion()
+{
+    static const std::size_t index = conversion_pairs().add(traced_name<From>::get(), traced_name<To>::get());
+    auto &counts = thread_counts();
+    if (index >= counts.size()) {
+        counts.resize(index + 1);
+    }
+    ++counts[index];
+}
+
+// Called by every cast when SIPP_TRACE_CONVERSIONS is defined: counts casts between
+// different types at run time, none at compile time
+template<class From, class To>
+constexpr bool trace_conversion()
+{
+    return std::is_same<From, To>::value || SIPP_CONSTANT_EVALUATED() || (count_conversion<From, To>(), true);
+}
+
+}
+
+// Casts counted on the calling thread, most frequent first
+inline std::vector<conversion_count> thread_conversion_counts()
+{
+    return detail::conversion_pairs().snapshot(detail::thread_counts(), false);
+}
+
+// Casts counted on the calling thread and on every thread which has exited
+inline std::vector<conversion_count> conversion_counts()
+{
+    return detail::conversion_pairs().snapshot(detail::thread_counts(), true);
+}
+
+// Clears the counts of the calling thread and of the exited threads
+inline void reset_conversion_counts()
+{
+    detail::thread_counts().clear();
+    detail::conversion_pairs().reset_exited();
+}
+
+// Writes conversion_counts() as CSV: from,to,count
+inline std::ostream &write_conversion_counts(std::ostream &out)
+{
+    out << "from,to,count\n";
+    for (const auto &pair : conversion_counts()) {
+        out << pair.from << ',' << pair.to << ',' << pair.count << '\n';
+    }
+    return out;
+}
+
+}
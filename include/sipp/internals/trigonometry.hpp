@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#include "angle.hpp"
+#include "batch.hpp"
+#include "quantity.hpp"
+#include "simd_math.hpp"
+#include "span.hpp"
+
+namespace sipp {
+
+namespace detail {
+
+// Result of the trigonometric functions: integral angles give double
+template<class Rep>
+using trig_rep = typename std::conditional<std::is_floating_point<Rep>::value, Rep, double>::type;
+
+// Units dividing a quarter turn (degrees, arc minutes, turns) are reduced to the nearest
+// quarter before conversion to radians, so that sin(180 deg) and cos(90 deg) are exactly 0
+template<class Ratio>
+using has_exact_quarter = std::integral_constant<bool, turn_count<Ratio>::den == 1
+                                                           && turn_count<Ratio>::num % 4 == 0>;
+
+// sin(angle + quadrant * pi / 2)
+template<class Rep, class Ratio>
+inline trig_rep<Rep> sin_quadrant(const Angle<Rep, Ratio> &angle, int quadrant, std::true_type)
+{
+    using rep = trig_rep<Rep>;
+    constexpr rep quarter = rep(turn_count<Ratio>::num / 4);
+    constexpr rep radian = rep(Ratio::num) / rep(Ratio::den);
+
+    const rep count = static_cast<rep>(angle.count());
+    const rep k = std::round(count / quarter);
+    const rep r = (count - k * quarter) * radian;
+    switch ((static_cast<long long>(std::fmod(k, rep(4))) + quadrant) & 3) {
+        case 0:
+            return std::sin(r);
+        case 1:
+            return std::cos(r);
+        case 2:
+            return -std::sin(r);
+        default:
+            return -std::cos(r);
+    }
+}
+
+template<class Rep, class Ratio>
+inline trig_rep<Rep> sin_quadrant(const Angle<Rep, Ratio> &angle, int quadrant, std::false_type)
+{
+    const auto radians = angle_cast<Angle<trig_rep<Rep>, RadianRatio>>(angle).count();
+    return quadrant == 0 ? std::sin(radians) : std::cos(radians);
+}
+
+// out[i] = sin(in[i] * scale + Quadrant * pi / 2)
+using angle_kernel = void (*)(const double *, double *, std::size_t, double);
+
+// out[i] = atan2(y[i], x[i]) * scale
+using atan2_kernel = void (*)(const double *, const double *, double *, std::size_t, double);
+
+template<int Quadrant>
+inline void sin_portable(const double *in, double *out, std::size_t count, double scale)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = Quadrant == 0 ? std::sin(in[i] * scale) : std::cos(in[i] * scale);
+    }
+}
+
+inline void atan2_portable(const double *y, const double *x, double *out, std::size_t count, double scale)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = std::atan2(y[i], x[i]) * scale;
+    }
+}
+
+#ifdef SIPP_SIMD_X86
+
+template<int Quadrant>
+SIPP_TARGET("avx2")
+inline void sin_avx2(const double *in, double *out, std::size_t count, double scale)
+{
+    const __m256d factor = _mm256_set1_pd(scale);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(out + i, sin_avx2(_mm256_mul_pd(_mm256_loadu_pd(in + i), factor), Quadrant));
+    }
+    sin_portable<Quadrant>(in + i, out + i, count - i, scale);
+}
+
+SIPP_TARGET("avx2")
+inline void atan2_avx2(const double *y, const double *x, double *out, std::size_t count, double scale)
+{
+    const __m256d factor = _mm256_set1_pd(scale);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d angle = atan2_avx2(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i));
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(angle, factor));
+    }
+    atan2_portable(y + i, x + i, out + i, count - i, scale);
+}
+
+template<int Quadrant>
+SIPP_TARGET("avx512f")
+inline void sin_avx512(const double *in, double *out, std::size_t count, double scale)
+{
+    const __m512d factor = _mm512_set1_pd(scale);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm512_storeu_pd(out + i, sin_avx512(_mm512_mul_pd(_mm512_loadu_pd(in + i), factor), Quadrant));
+    }
+    sin_portable<Quadrant>(in + i, out + i, count - i, scale);
+}
+
+SIPP_TARGET("avx512f")
+inline void atan2_avx512(const double *y, const double *x, double *out, std::size_t count, double scale)
+{
+    const __m512d factor = _mm512_set1_pd(scale);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d angle = atan2_avx512(_mm512_loadu_pd(y + i), _mm512_loadu_pd(x + i));
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(angle, factor));
+    }
+    atan2_portable(y + i, x + i, out + i, count - i, scale);
+}
+
+#endif
+
+template<int Quadrant>
+inline angle_kernel select_sin_kernel(simd_isa isa)
+{
+    switch (isa) {
+#ifdef SIPP_SIMD_X86
+        case simd_isa::avx512:
+            return &sin_avx512<Quadrant>;
+        case simd_isa::avx2:
+            return &sin_avx2<Quadrant>;
+#endif
+        default:
+            return &sin_portable<Quadrant>;
+    }
+}
+
+inline atan2_kernel select_atan2_kernel(simd_isa isa)
+{
+    switch (isa) {
+#ifdef SIPP_SIMD_X86
+        case simd_isa::avx512:
+            return &atan2_avx512;
+        case simd_isa::avx2:
+            return &atan2_avx2;
+#endif
+        default:
+            return &atan2_portable;
+    }
+}
+
+template<int Quadrant, class Ratio>
+inline void sin(const Angle<double, Ratio> *in, double *out, std::size_t count)
+{
+    static const angle_kernel kernel = select_sin_kernel<Quadrant>(detect_simd_isa());
+    kernel(rep_data(in), out, count, static_cast<double>(Ratio::num) / static_cast<double>(Ratio::den));
+}
+
+template<class Quantity, class Ratio>
+inline void atan2(const Quantity *y, const Quantity *x, Angle<double, Ratio> *out, std::size_t count,
+                  std::true_type)
+{
+    static const atan2_kernel kernel = select_atan2_kernel(detect_simd_isa());
+    kernel(rep_data(y), rep_data(x), rep_data(out), count,
+           static_cast<double>(Ratio::den) / static_cast<double>(Ratio::num));
+}
+
+template<class Quantity, class Rep, class Ratio>
+inline void atan2(const Quantity *y, const Quantity *x, Angle<Rep, Ratio> *out, std::size_t count,
+                  std::false_type)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = angle_cast<Angle<Rep, Ratio>>(Angle<double>(std::atan2(static_cast<double>(y[i].count()),
+                                                                        static_cast<double>(x[i].count()))));
+    }
+}
+
+}
+
+template<class Rep, class Ratio>
+inline detail::trig_rep<Rep> sin(const Angle<Rep, Ratio> &angle)
+{
+    return detail::sin_quadrant(angle, 0, detail::has_exact_quarter<Ratio>());
+}
+
+template<class Rep, class Ratio>
+inline detail::trig_rep<Rep> cos(const Angle<Rep, Ratio> &angle)
+{
+    return detail::sin_quadrant(angle, 1, detail::has_exact_quarter<Ratio>());
+}
+
+template<class Rep, class Ratio>
+inline detail::trig_rep<Rep> tan(const Angle<Rep, Ratio> &angle)
+{
+    return sin(angle) / cos(angle);
+}
+
+// Direction of the vector (x, y) from the x axis, in (-pi, pi], for any two quantities of
+// the same dimension, e.g. atan2(east, north) of two distances or speeds is a track
+template<class QuantityY,
+         class QuantityX,
+         class = typename std::enable_if<detail::is_same_dimension<QuantityY, QuantityX>::value>::type>
+inline Radians atan2(const QuantityY &y, const QuantityX &x)
+{
+    using common = Quantity<double, typename detail::quantity_traits<QuantityY>::dimension>;
+    return Radians(std::atan2(quantity_cast<common>(y).count(), quantity_cast<common>(x).count()));
+}
+
+// Batch sin of double angles with AVX2 or AVX-512 kernels: Cephes polynomials after a
+// three-part reduction modulo pi / 2, within 2 ulp of std::sin for |angle| < 1e5 rad
+// (the reduction loses accuracy beyond 2^20 * pi / 2). Degrees are scaled to radians
+// first, so the batch form does not give the exact zeros of the scalar sin().
+// Computes min(sizes) values, returns that number.
+template<class Ratio>
+inline std::size_t sin(span<const Angle<double, Ratio>> angles, span<double> out)
+{
+    const auto count = std::min(angles.size(), out.size());
+    detail::sin<0>(angles.data(), out.data(), count);
+    return count;
+}
+
+// Batch cos of double angles, same kernels and error bounds as the batch sin
+template<class Ratio>
+inline std::size_t cos(span<const Angle<double, Ratio>> angles, span<double> out)
+{
+    const auto count = std::min(angles.size(), out.size());
+    detail::sin<1>(angles.data(), out.data(), count);
+    return count;
+}
+
+// Batch atan2(y[i], x[i]) of finite quantities of the same type. Double quantities and
+// angles use AVX2 or AVX-512 kernels (Cephes atan rational approximation, within 2 ulp of
+// std::atan2); other representations go through std::atan2. Computes min(sizes) values,
+// returns that number.
+template<class Quantity, class Rep, class Ratio>
+inline std::size_t atan2(span<const Quantity> y, span<const Quantity> x, span<Angle<Rep, Ratio>> out)
+{
+    static_assert(detail::is_quantity<Quantity>::value, "atan2 takes the components as quantities");
+    const auto count = std::min(std::min(y.size(), x.size()), out.size());
+    detail::atan2(y.data(), x.data(), out.data(), count,
+                  std::integral_constant<bool, std::is_same<typename Quantity::rep, double>::value
+                                                   && std::is_same<Rep, double>::value>());
+    return count;
+}
+
+// Horizontal velocity as north and east components, e.g. the ground speed vector is
+// the air vector plus the wind vector
+template<class Speed>
+struct velocity_vector {
+    Speed north;
+    Speed east;
+};
+
+template<class Speed1, class Speed2>
+constexpr auto operator+(const velocity_vector<Speed1> &vector1, const velocity_vector<Speed2> &vector2)
+    -> velocity_vector<decltype(vector1.north + vector2.north)>
+{
+    return {vector1.north + vector2.north, vector1.east + vector2.east};
+}
+
+template<class Speed1, class Speed2>
+constexpr auto operator-(const velocity_vector<Speed1> &vector1, const velocity_vector<Speed2> &vector2)
+    -> velocity_vector<decltype(vector1.north - vector2.north)>
+{
+    return {vector1.north - vector2.north, vector1.east - vector2.east};
+}
+
+// Velocity of the given speed along a track (or heading) measured clockwise from north
+template<class Speed, class Rep, class Ratio>
+inline velocity_vector<Speed> make_velocity(const Speed &speed, const Angle<Rep, Ratio> &track)
+{
+    return {speed * cos(track), speed * sin(track)};
+}
+
+template<class Speed>
+inline Speed speed_of(const velocity_vector<Speed> &vector)
+{
+    return Speed(std::hypot(vector.north.count(), vector.east.count()));
+}
+
+// Track of a velocity clockwise from north, within [0, 360) degrees
+template<class ToAngle = Degrees, class Speed>
+inline ToAngle track_of(const velocity_vector<Speed> &vector)
+{
+    return wrap(angle_cast<ToAngle>(atan2(vector.east, vector.north)));
+}
+
+}
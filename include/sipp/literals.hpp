@@ -0,0 +1,4 @@
+#pragma once
+
+// Distance and speed literals (sipp::literals) with the classes they construct only
+#include "internals/literals.hpp"
@@ -1,2 +1,5 @@
+#pragma once
+
 #include "internals/distance.hpp"
 #include "internals/speed.hpp"
+#include "internals/literals.hpp"
@@ -2,4 +2,5 @@
 
 #include "internals/distance_fwd.hpp"
 #include "internals/speed_fwd.hpp"
+#include "internals/angle_fwd.hpp"
 
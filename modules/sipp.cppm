@@ -0,0 +1,292 @@
+// C++20 module interface of sipp.hpp and the feature headers (expression.hpp and
+// columnar.hpp excepted): import sipp; instead of the includes. The headers are parsed
+// once when the module is built; importers only load the compiled interface.
+// Experimental: the interface is not built by CI.
+module;
+
+#include <sipp/sipp.hpp>
+#include <sipp/angle.hpp>
+#include <sipp/batch.hpp>
+#include <sipp/dynamic.hpp>
+#include <sipp/format.hpp>
+#include <sipp/geodesy.hpp>
+#include <sipp/kinematics.hpp>
+#include <sipp/lookup_table.hpp>
+#include <sipp/ordering.hpp>
+#include <sipp/parse.hpp>
+#include <sipp/precision.hpp>
+#include <sipp/quantity.hpp>
+#include <sipp/quantity_vector.hpp>
+#include <sipp/reduce.hpp>
+#include <sipp/strict.hpp>
+#include <sipp/trigonometry.hpp>
+
+export module sipp;
+
+export namespace sipp {
+
+using sipp::Distance;
+using sipp::Speed;
+using sipp::Quantity;
+using sipp::Angle;
+
+using sipp::Meters;
+using sipp::Kilometers;
+using sipp::Millimeters;
+using sipp::Micrometers;
+using sipp::Nanometers;
+using sipp::Feet;
+using sipp::NauticalMiles;
+using sipp::StatuteMiles;
+
+using sipp::SecondRatio;
+using sipp::MinuteRatio;
+using sipp::HourRatio;
+using sipp::KmPerHour;
+using sipp::MetersPerSecond;
+using sipp::FeetPerSecond;
+using sipp::FeetPerMinute;
+using sipp::Knots;
+using sipp::MilesPerHour;
+
+using sipp::Seconds;
+using sipp::SquareMeters;
+using sipp::SquareKilometers;
+using sipp::SquareNauticalMiles;
+using sipp::MetersPerSecondSquared;
+using sipp::KnotsPerSecond;
+using sipp::StandardGravities;
+using sipp::FeetPerNauticalMile;
+using sipp::Percent;
+
+using sipp::RadianRatio;
+using sipp::DegreeRatio;
+using sipp::TurnRatio;
+using sipp::Radians;
+using sipp::Degrees;
+using sipp::ArcMinutes;
+using sipp::Turns;
+
+using sipp::dimension;
+using sipp::dimension_multiply;
+using sipp::dimension_divide;
+
+using sipp::distance_cast;
+using sipp::speed_cast;
+using sipp::quantity_cast;
+using sipp::as_quantity;
+using sipp::angle_cast;
+
+// Distance, Speed and Angle overloads
+using sipp::floor;
+using sipp::ceil;
+using sipp::round;
+
+using sipp::operator+;
+using sipp::operator-;
+using sipp::operator*;
+using sipp::operator/;
+
+using sipp::span;
+using sipp::simd_isa;
+using sipp::active_simd_isa;
+using sipp::convert;
+
+using sipp::quantity_vector;
+using sipp::quantity_view;
+using sipp::quantity_iterator;
+
+using sipp::accumulate;
+using sipp::accumulator_type;
+using sipp::rebind_rep;
+
+using sipp::from_chars;
+using sipp::from_chars_result;
+using sipp::parse;
+using sipp::parse_error;
+using sipp::parse_result;
+using sipp::parse_column;
+using sipp::parse_column_result;
+
+using sipp::to_chars;
+using sipp::to_chars_result;
+using sipp::format_column;
+using sipp::format_column_result;
+using sipp::max_formatted_size;
+using sipp::unit_symbol;
+
+using sipp::distance_unit;
+using sipp::speed_unit;
+using sipp::dynamic_quantity;
+using sipp::dynamic_distance;
+using sipp::dynamic_speed;
+using sipp::unit_of;
+
+using sipp::order_key;
+using sipp::radix_sort;
+using sipp::lower_bound;
+using sipp::upper_bound;
+
+using sipp::advance;
+using sipp::time_to_go;
+
+// reduce.hpp, the execution policies are in namespace execution below
+using sipp::summary;
+using sipp::sum;
+using sipp::summarize;
+using sipp::quantile;
+
+// geodesy.hpp
+using sipp::geo_point;
+using sipp::haversine;
+using sipp::vincenty;
+
+using sipp::wrap;
+using sipp::wrap_signed;
+using sipp::sin;
+using sipp::cos;
+using sipp::tan;
+using sipp::atan2;
+using sipp::velocity_vector;
+using sipp::make_velocity;
+using sipp::speed_of;
+using sipp::track_of;
+
+#ifdef SIPP_TRACE_CONVERSIONS
+using sipp::conversion_count;
+using sipp::thread_conversion_counts;
+using sipp::conversion_counts;
+using sipp::reset_conversion_counts;
+using sipp::write_conversion_counts;
+#endif
+
+using sipp::lookup_table;
+
+// reduce.hpp
+namespace execution {
+
+using sipp::execution::sequenced_policy;
+using sipp::execution::parallel_policy;
+using sipp::execution::seq;
+using sipp::execution::par;
+
+}
+
+namespace f32 {
+
+using sipp::f32::Meters;
+using sipp::f32::Kilometers;
+using sipp::f32::Millimeters;
+using sipp::f32::Micrometers;
+using sipp::f32::Nanometers;
+using sipp::f32::Feet;
+using sipp::f32::NauticalMiles;
+using sipp::f32::StatuteMiles;
+using sipp::f32::KmPerHour;
+using sipp::f32::MetersPerSecond;
+using sipp::f32::FeetPerSecond;
+using sipp::f32::FeetPerMinute;
+using sipp::f32::Knots;
+using sipp::f32::MilesPerHour;
+using sipp::f32::Radians;
+using sipp::f32::Degrees;
+using sipp::f32::ArcMinutes;
+using sipp::f32::Turns;
+
+}
+
+namespace strict {
+
+using sipp::strict::unit;
+using sipp::strict::quantity_cast;
+using sipp::strict::make_strict;
+using sipp::strict::Meters;
+using sipp::strict::Kilometers;
+using sipp::strict::Millimeters;
+using sipp::strict::Micrometers;
+using sipp::strict::Nanometers;
+using sipp::strict::Feet;
+using sipp::strict::NauticalMiles;
+using sipp::strict::StatuteMiles;
+using sipp::strict::KmPerHour;
+using sipp::strict::MetersPerSecond;
+using sipp::strict::FeetPerSecond;
+using sipp::strict::FeetPerMinute;
+using sipp::strict::Knots;
+using sipp::strict::MilesPerHour;
+using sipp::strict::Radians;
+using sipp::strict::Degrees;
+using sipp::strict::ArcMinutes;
+using sipp::strict::Turns;
+using sipp::strict::Seconds;
+
+namespace f32 {
+
+using sipp::strict::f32::Meters;
+using sipp::strict::f32::Kilometers;
+using sipp::strict::f32::Millimeters;
+using sipp::strict::f32::Micrometers;
+using sipp::strict::f32::Nanometers;
+using sipp::strict::f32::Feet;
+using sipp::strict::f32::NauticalMiles;
+using sipp::strict::f32::StatuteMiles;
+using sipp::strict::f32::KmPerHour;
+using sipp::strict::f32::MetersPerSecond;
+using sipp::strict::f32::FeetPerSecond;
+using sipp::strict::f32::FeetPerMinute;
+using sipp::strict::f32::Knots;
+using sipp::strict::f32::MilesPerHour;
+using sipp::strict::f32::Radians;
+using sipp::strict::f32::Degrees;
+using sipp::strict::f32::ArcMinutes;
+using sipp::strict::f32::Turns;
+
+}
+
+}
+
+namespace rounding {
+
+using sipp::rounding::toward_zero;
+using sipp::rounding::downward;
+using sipp::rounding::upward;
+using sipp::rounding::to_nearest;
+
+}
+
+namespace dimensions {
+
+using sipp::dimensions::dimensionless;
+using sipp::dimensions::length;
+using sipp::dimensions::mass;
+using sipp::dimensions::time;
+using sipp::dimensions::area;
+using sipp::dimensions::velocity;
+using sipp::dimensions::acceleration;
+using sipp::dimensions::angle;
+using sipp::dimensions::angular_velocity;
+
+}
+
+namespace literals {
+
+using sipp::literals::operator""_m;
+using sipp::literals::operator""_km;
+using sipp::literals::operator""_mm;
+using sipp::literals::operator""_um;
+using sipp::literals::operator""_nm;
+using sipp::literals::operator""_ft;
+using sipp::literals::operator""_NM;
+using sipp::literals::operator""_mi;
+using sipp::literals::operator""_km_h;
+using sipp::literals::operator""_m_s;
+using sipp::literals::operator""_ft_s;
+using sipp::literals::operator""_ft_min;
+using sipp::literals::operator""_kts;
+using sipp::literals::operator""_mph;
+using sipp::literals::operator""_deg;
+using sipp::literals::operator""_rad;
+
+}
+
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <sipp/trigonometry.hpp>
+
+class AngleTestFixture : public ::testing::Test {
+
+};
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+std::vector<double> random_values(std::size_t count, double range, std::uint64_t state)
+{
+    std::vector<double> values(count);
+    for (auto &value : values) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        value = (static_cast<double>(state >> 11) / 9007199254740992.0 * 2.0 - 1.0) * range;
+    }
+    return values;
+}
+
+}
+
+TEST_F(AngleTestFixture, TestConversions)
+{
+    using namespace sipp::literals;
+
+    EXPECT_DOUBLE_EQ(pi, sipp::angle_cast<sipp::Radians>(180_deg).count());
+    EXPECT_DOUBLE_EQ(90.0, sipp::angle_cast<sipp::Degrees>(sipp::Radians(pi / 2.0)).count());
+
+    // degrees, arc minutes and turns convert into each other exactly
+    EXPECT_EQ(sipp::Turns(1.0), 360_deg);
+    EXPECT_EQ(sipp::ArcMinutes(90.0), 1.5_deg);
+    EXPECT_EQ(0.25, sipp::angle_cast<sipp::Turns>(90_deg).count());
+
+    using IntegralDegrees = sipp::Angle<int, sipp::DegreeRatio>;
+    using IntegralArcMinutes = sipp::Angle<long, std::ratio_divide<sipp::DegreeRatio, std::ratio<60>>>;
+    const IntegralArcMinutes minutes = IntegralDegrees(3);
+    EXPECT_EQ(180, minutes.count());
+    EXPECT_EQ(2, sipp::angle_cast<IntegralDegrees>(IntegralArcMinutes(179)).count());
+    EXPECT_EQ(3, sipp::round<IntegralDegrees>(IntegralArcMinutes(179)).count());
+    static_assert(std::is_same<sipp::rebind_rep<sipp::f32::Degrees, double>::type, sipp::Degrees>::value,
+                  "Angles rebind their representation like the other quantities");
+
+    EXPECT_EQ(100_deg, 30_deg + 70_deg);
+    EXPECT_EQ(-40_deg, 30_deg - 70_deg);
+    EXPECT_TRUE(1_rad > 57_deg);
+    EXPECT_TRUE(1_rad < 58_deg);
+}
+
+TEST_F(AngleTestFixture, TestWrap)
+{
+    using namespace sipp::literals;
+
+    EXPECT_EQ(350_deg, sipp::wrap(-10_deg));
+    EXPECT_EQ(5_deg, sipp::wrap(725_deg));
+    EXPECT_EQ(0_deg, sipp::wrap(360_deg));
+    EXPECT_EQ(0_deg, sipp::wrap(sipp::Degrees(-1e-20)));
+    EXPECT_EQ(-90_deg, sipp::wrap_signed(270_deg));
+    EXPECT_EQ(-180_deg, sipp::wrap_signed(180_deg));
+    EXPECT_EQ(179_deg, sipp::wrap_signed(-181_deg));
+
+    using IntegralDegrees = sipp::Angle<int, sipp::DegreeRatio>;
+    EXPECT_EQ(350, sipp::wrap(IntegralDegrees(-370)).count());
+    EXPECT_EQ(-10, sipp::wrap_signed(IntegralDegrees(350)).count());
+
+    EXPECT_NEAR(2.0 * pi - 0.5, sipp::wrap(sipp::Radians(-0.5)).count(), 1e-15);
+    EXPECT_NEAR(-pi / 2.0, sipp::wrap_signed(sipp::Radians(1.5 * pi)).count(), 1e-15);
+}
+
+TEST_F(AngleTestFixture, TestScalarTrigonometry)
+{
+    using namespace sipp::literals;
+
+    // cardinal directions are exact in degrees
+    EXPECT_EQ(0.0, sipp::sin(180_deg));
+    EXPECT_EQ(0.0, sipp::cos(90_deg));
+    EXPECT_EQ(-1.0, sipp::cos(-540_deg));
+    EXPECT_EQ(-1.0, sipp::sin(sipp::Angle<int, sipp::DegreeRatio>(270)));
+
+    EXPECT_DOUBLE_EQ(0.5, sipp::sin(30_deg));
+    EXPECT_DOUBLE_EQ(0.5, sipp::cos(sipp::Radians(pi / 3.0)));
+    EXPECT_DOUBLE_EQ(1.0, sipp::tan(45_deg));
+    EXPECT_DOUBLE_EQ(std::sin(2.0), sipp::sin(2_rad));
+    EXPECT_FLOAT_EQ(0.5f, sipp::sin(sipp::f32::Degrees(150.0f)));
+
+    EXPECT_DOUBLE_EQ(pi / 4.0, sipp::atan2(sipp::Meters(1.0), sipp::Kilometers(0.001)).count());
+    EXPECT_DOUBLE_EQ(pi / 2.0, sipp::atan2(sipp::Knots(1.0), sipp::MetersPerSecond(0.0)).count());
+    EXPECT_DOUBLE_EQ(-3.0 * pi / 4.0, sipp::atan2(sipp::Feet(-1.0), sipp::Feet(-1.0)).count());
+}
+
+TEST_F(AngleTestFixture, TestBatchSinCos)
+{
+    for (const std::size_t count : {std::size_t(0), std::size_t(3), std::size_t(1001)}) {
+        const auto values = random_values(count, 1000.0, 42);
+        std::vector<sipp::Radians> radians;
+        std::vector<sipp::Degrees> degrees;
+        for (const double value : values) {
+            radians.emplace_back(value);
+            degrees.emplace_back(value);
+        }
+
+        std::vector<double> sines(count);
+        std::vector<double> cosines(count + 1, 2.0);
+        EXPECT_EQ(count, sipp::sin(sipp::span<const sipp::Radians>(radians), sipp::span<double>(sines)));
+        EXPECT_EQ(count, sipp::cos(sipp::span<const sipp::Radians>(radians), sipp::span<double>(cosines)));
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_NEAR(std::sin(values[i]), sines[i], 4e-16) << values[i];
+            EXPECT_NEAR(std::cos(values[i]), cosines[i], 4e-16) << values[i];
+        }
+        EXPECT_EQ(2.0, cosines[count]);
+
+        sipp::sin(sipp::span<const sipp::Degrees>(degrees), sipp::span<double>(sines));
+        for (std::size_t i = 0; i < count; ++i) {
+            // scaling to radians rounds the argument: 1 ulp of the angle in radians
+            EXPECT_NEAR(sipp::sin(degrees[i]), sines[i], 4e-16 + 2e-16 * std::abs(values[i]) * pi / 180.0)
+                << values[i];
+        }
+    }
+}
+
+TEST_F(AngleTestFixture, TestBatchAtan2)
+{
+    const std::size_t count = 1003;
+    const auto ys = random_values(count, 100.0, 7);
+    const auto xs = random_values(count, 100.0, 11);
+    std::vector<sipp::Meters> north;
+    std::vector<sipp::Meters> east;
+    for (std::size_t i = 0; i < count; ++i) {
+        north.emplace_back(ys[i]);
+        east.emplace_back(xs[i]);
+    }
+    // axes, signed zeros and the branch points of the approximation
+    const double special[][2] = {{0.0, 0.0}, {-0.0, 0.0}, {0.0, -0.0}, {-0.0, -0.0}, {1.0, 0.0}, {0.0, -1.0},
+                                 {-1.0, 0.0}, {0.0, 1.0}, {0.66, 1.0}, {1.0, 1.0}, {-1.0, -1.0}, {1e-300, 1.0}};
+    for (const auto &pair : special) {
+        north.emplace_back(pair[0]);
+        east.emplace_back(pair[1]);
+    }
+
+    std::vector<sipp::Radians> radians(north.size());
+    std::vector<sipp::Degrees> degrees(north.size());
+    std::vector<sipp::f32::Degrees> floats(north.size());
+    EXPECT_EQ(north.size(), sipp::atan2(sipp::span<const sipp::Meters>(north), sipp::span<const sipp::Meters>(east),
+                                        sipp::span<sipp::Radians>(radians)));
+    sipp::atan2(sipp::span<const sipp::Meters>(north), sipp::span<const sipp::Meters>(east),
+                sipp::span<sipp::Degrees>(degrees));
+    sipp::atan2(sipp::span<const sipp::Meters>(north), sipp::span<const sipp::Meters>(east),
+                sipp::span<sipp::f32::Degrees>(floats));
+    for (std::size_t i = 0; i < north.size(); ++i) {
+        const double expected = std::atan2(north[i].count(), east[i].count());
+        EXPECT_NEAR(expected, radians[i].count(), 4e-16 * std::abs(expected) + 1e-300) << i;
+        EXPECT_EQ(std::signbit(expected), std::signbit(radians[i].count())) << i;
+        EXPECT_NEAR(expected * 180.0 / pi, degrees[i].count(), 1e-13) << i;
+        EXPECT_NEAR(expected * 180.0 / pi, floats[i].count(), 1e-4) << i;
+    }
+}
+
+TEST_F(AngleTestFixture, TestWindTriangle)
+{
+    using namespace sipp::literals;
+
+    // heading 090 at 100 kts true airspeed, wind from 360 at 20 kts
+    const auto air = sipp::make_velocity(100_kts, 90_deg);
+    const auto wind = sipp::make_velocity(20_kts, sipp::wrap(360_deg + 180_deg));
+    const auto ground = air + wind;
+
+    EXPECT_DOUBLE_EQ(-20.0, ground.north.count());
+    EXPECT_DOUBLE_EQ(100.0, ground.east.count());
+    EXPECT_DOUBLE_EQ(std::sqrt(10400.0), sipp::speed_of(ground).count());
+    EXPECT_DOUBLE_EQ(90.0 + std::atan(0.2) * 180.0 / pi, sipp::track_of(ground).count());
+
+    // mixed units take the common speed type
+    const auto mixed = sipp::make_velocity(10_m_s, 0_deg) + sipp::make_velocity(36_km_h, 270_deg);
+    EXPECT_DOUBLE_EQ(315.0, sipp::track_of(mixed).count());
+    EXPECT_EQ(sipp::MetersPerSecond(0.0), (air - air).north);
+}
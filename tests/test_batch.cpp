@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <sipp/batch.hpp>
+
+class BatchTestFixture : public ::testing::Test {
+
+};
+
+namespace {
+
+std::vector<sipp::Meters> make_meters(std::size_t count)
+{
+    std::vector<sipp::Meters> meters;
+    for (std::size_t i = 0; i < count; ++i) {
+        meters.emplace_back(static_cast<double>(i) * 12.25 - 100.0);
+    }
+    return meters;
+}
+
+}
+
+TEST_F(BatchTestFixture, TestConvertMetersToFeetMatchesDistanceCast)
+{
+    // covers empty input, unaligned tails and full vector blocks
+    for (std::size_t count = 0; count < 40; ++count) {
+        const auto meters = make_meters(count);
+        std::vector<sipp::Feet> feet(count);
+
+        ASSERT_EQ(count, sipp::convert(sipp::span<const sipp::Meters>(meters),
+                                       sipp::span<sipp::Feet>(feet)));
+        for (std::size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(sipp::distance_cast<sipp::Feet>(meters[i]).count(), feet[i].count());
+        }
+    }
+}
+
+TEST_F(BatchTestFixture, TestConvertIdentity)
+{
+    const auto meters = make_meters(17);
+    std::vector<sipp::Meters> copy(meters.size());
+
+    sipp::convert(meters.data(), meters.data() + meters.size(), copy.data());
+    for (std::size_t i = 0; i < meters.size(); ++i) {
+        ASSERT_EQ(meters[i].count(), copy[i].count());
+    }
+}
+
+TEST_F(BatchTestFixture, TestConvertStopsAtShorterSpan)
+{
+    const auto meters = make_meters(10);
+    std::vector<sipp::Kilometers> kilometers(4);
+
+    ASSERT_EQ(4u, sipp::convert(sipp::span<const sipp::Meters>(meters),
+                                sipp::span<sipp::Kilometers>(kilometers)));
+    ASSERT_DOUBLE_EQ(meters[3].count() / 1000.0, kilometers[3].count());
+}
+
+TEST_F(BatchTestFixture, TestConvertIntegerDistances)
+{
+    std::vector<sipp::Distance<int, std::milli>> millimeters{sipp::Distance<int, std::milli>(1500),
+                                                              sipp::Distance<int, std::milli>(-2999)};
+    std::vector<sipp::Distance<int>> meters(millimeters.size());
+
+    sipp::convert(sipp::span<sipp::Distance<int, std::milli>>(millimeters),
+                  sipp::span<sipp::Distance<int>>(meters));
+    ASSERT_EQ(1, meters[0].count());
+    ASSERT_EQ(-2, meters[1].count());
+}
+
+TEST_F(BatchTestFixture, TestConvertKnotsToKmPerHour)
+{
+    std::vector<sipp::Knots> knots;
+    for (int i = 0; i < 23; ++i) {
+        knots.emplace_back(i * 10.5);
+    }
+    std::vector<sipp::KmPerHour> km_per_hour(knots.size());
+
+    sipp::convert(sipp::span<const sipp::Knots>(knots), sipp::span<sipp::KmPerHour>(km_per_hour));
+    for (std::size_t i = 0; i < knots.size(); ++i) {
+        ASSERT_EQ(sipp::speed_cast<sipp::KmPerHour>(knots[i]).count(), km_per_hour[i].count());
+    }
+}
+
+TEST_F(BatchTestFixture, TestEverySupportedKernelMatchesPortable)
+{
+    std::vector<double> in(67);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<double>(i) * 0.7 - 3.0;
+    }
+
+    const auto active = static_cast<int>(sipp::active_simd_isa());
+    for (int isa = 0; isa <= active; ++isa) {
+        const auto kernel = sipp::detail::select_scale_kernel<double>(static_cast<sipp::simd_isa>(isa));
+        for (std::size_t count = 0; count <= in.size(); ++count) {
+            std::vector<double> out(count + 1, -1.0);
+            kernel(in.data(), out.data(), count, 0.3048);
+            for (std::size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(in[i] * 0.3048, out[i]) << "isa " << isa << ", count " << count;
+            }
+            ASSERT_EQ(-1.0, out[count]) << "kernel wrote past the end, isa " << isa;
+        }
+    }
+}
+
+TEST_F(BatchTestFixture, TestEverySupportedSinglePrecisionKernelMatchesPortable)
+{
+    std::vector<float> in(67);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<float>(i) * 0.7f - 3.0f;
+    }
+
+    const auto active = static_cast<int>(sipp::active_simd_isa());
+    for (int isa = 0; isa <= active; ++isa) {
+        const auto kernel = sipp::detail::select_scale_kernel<float>(static_cast<sipp::simd_isa>(isa));
+        for (std::size_t count = 0; count <= in.size(); ++count) {
+            std::vector<float> out(count + 1, -1.0f);
+            kernel(in.data(), out.data(), count, 0.3048f);
+            for (std::size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(in[i] * 0.3048f, out[i]) << "isa " << isa << ", count " << count;
+            }
+            ASSERT_EQ(-1.0f, out[count]) << "kernel wrote past the end, isa " << isa;
+        }
+    }
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <sipp/columnar.hpp>
+
+class ColumnarTestFixture : public ::testing::Test {
+protected:
+    void TearDown() override
+    {
+        std::remove(path.c_str());
+    }
+
+    void write_telemetry(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            altitude.emplace_back(static_cast<double>(i) * 10.5);
+            speed.emplace_back(100.0 + static_cast<double>(i));
+        }
+        sipp::columnar_writer().add("altitude", altitude).add("speed", speed).write(path);
+    }
+
+    const std::string path = "sipp_test_columnar.bin";
+    std::vector<sipp::Meters> altitude;
+    std::vector<sipp::Knots> speed;
+};
+
+TEST_F(ColumnarTestFixture, TestColumnsKeepTheirUnits)
+{
+    write_telemetry(1000);
+
+    sipp::columnar_file file(path);
+    ASSERT_EQ(2u, file.column_count());
+    ASSERT_EQ("altitude", file.column(0).name);
+    ASSERT_EQ(sipp::column_dimension::distance, file.column("altitude").dimension);
+    ASSERT_EQ(sipp::column_rep::float64, file.column("altitude").rep);
+    ASSERT_EQ(463, file.column("speed").ratio_num);
+    ASSERT_EQ(900, file.column("speed").ratio_den);
+    ASSERT_TRUE(file.holds<sipp::Meters>("altitude"));
+    ASSERT_FALSE(file.holds<sipp::Feet>("altitude"));
+    ASSERT_FALSE(file.contains("heading"));
+}
+
+TEST_F(ColumnarTestFixture, TestZeroCopyColumns)
+{
+    write_telemetry(1000);
+
+    sipp::columnar_file file(path);
+    const auto values = file.values<sipp::Knots>("speed");
+    ASSERT_EQ(speed.size(), values.size());
+    ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.data()) % 64);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(speed[i].count(), values[i].count());
+    }
+
+    ASSERT_THROW(file.values<sipp::KmPerHour>("speed"), sipp::columnar_error);
+    ASSERT_THROW(file.values<sipp::Meters>("heading"), sipp::columnar_error);
+}
+
+TEST_F(ColumnarTestFixture, TestChunksAreConvertedLazily)
+{
+    write_telemetry(1000);
+
+    sipp::columnar_file file(path);
+    auto feet = file.reader<sipp::Feet>("altitude", 300);
+    ASSERT_FALSE(feet.zero_copy());
+    ASSERT_EQ(4u, feet.chunk_count());
+
+    const auto last = feet.chunk(3);
+    ASSERT_EQ(100u, last.size());
+    for (std::size_t i = 0; i < last.size(); ++i) {
+        ASSERT_EQ(sipp::distance_cast<sipp::Feet>(altitude[900 + i]).count(), last[i].count());
+    }
+
+    auto knots = file.reader<sipp::Knots>("speed", 300);
+    ASSERT_TRUE(knots.zero_copy());
+    ASSERT_EQ(file.values<sipp::Knots>("speed").data() + 300, knots.chunk(1).data());
+
+    ASSERT_THROW(file.reader<sipp::Knots>("altitude"), sipp::columnar_error);
+}
+
+TEST_F(ColumnarTestFixture, TestConversionMatchesCompileTimeCasts)
+{
+    using IntMillimeters = sipp::Distance<std::int64_t, std::milli>;
+    using IntMeters = sipp::Distance<std::int32_t, std::ratio<1>>;
+
+    const std::vector<IntMillimeters> millimeters = {IntMillimeters(-2500), IntMillimeters(1999),
+                                                     IntMillimeters(3000)};
+    const std::vector<sipp::f32::Knots> knots = {sipp::f32::Knots(1.5f), sipp::f32::Knots(250.0f)};
+    sipp::columnar_writer().add("mm", millimeters).add("knots", knots).write(path);
+
+    sipp::columnar_file file(path);
+    const auto meters = file.load<IntMeters>("mm");
+    ASSERT_EQ(3u, meters.size());
+    for (std::size_t i = 0; i < meters.size(); ++i) {
+        ASSERT_EQ(sipp::distance_cast<IntMeters>(millimeters[i]).count(), meters[i].count());
+    }
+
+    const auto per_hour = file.load<sipp::KmPerHour>("knots");
+    for (std::size_t i = 0; i < per_hour.size(); ++i) {
+        ASSERT_EQ(sipp::speed_cast<sipp::KmPerHour>(knots[i]).count(), per_hour[i].count());
+    }
+
+    const auto same = file.load<sipp::f32::Knots>("knots");
+    ASSERT_EQ(knots[1].count(), same[1].count());
+}
+
+TEST_F(ColumnarTestFixture, TestEmptyColumns)
+{
+    sipp::columnar_writer().add("empty", std::vector<sipp::Meters>()).write(path);
+
+    sipp::columnar_file file(path);
+    ASSERT_EQ(0u, file.values<sipp::Meters>("empty").size());
+    ASSERT_EQ(0u, file.reader<sipp::Feet>("empty").chunk_count());
+}
+
+TEST_F(ColumnarTestFixture, TestIntegerRepresentationsBySize)
+{
+    using LongMeters = sipp::Distance<long long>;
+    using LongMillimeters = sipp::Distance<long, std::milli>;
+    const std::vector<LongMeters> meters{LongMeters(1), LongMeters(-2), LongMeters(3)};
+    sipp::columnar_writer().add("meters", meters).write(path);
+
+    sipp::columnar_file file(path);
+    ASSERT_EQ(sipp::column_rep::int64, file.column("meters").rep);
+    ASSERT_TRUE(file.holds<sipp::Distance<std::int64_t>>("meters"));
+    ASSERT_EQ(-2, file.values<LongMeters>("meters")[1].count());
+    ASSERT_EQ(3000, file.load<LongMillimeters>("meters")[2].count());
+}
+
+TEST_F(ColumnarTestFixture, TestReadersSurviveMovedFile)
+{
+    write_telemetry(100);
+
+    sipp::columnar_file file(path);
+    auto feet = file.reader<sipp::Feet>("altitude", 16);
+    const auto meters = file.values<sipp::Meters>("altitude");
+
+    sipp::columnar_file moved(std::move(file));
+    ASSERT_NEAR(sipp::Feet(altitude[20]).count(), feet.chunk(1)[4].count(), 1e-9);
+    ASSERT_EQ(altitude[99].count(), meters[99].count());
+}
+
+TEST_F(ColumnarTestFixture, TestInvalidFiles)
+{
+    ASSERT_THROW(sipp::columnar_file("sipp_test_missing.bin"), std::system_error);
+
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    std::fputs("not a columnar file, just some text long enough for a header", file);
+    std::fclose(file);
+    ASSERT_THROW(sipp::columnar_file{path}, sipp::columnar_error);
+
+    sipp::columnar_writer writer;
+    writer.add("altitude", altitude);
+    ASSERT_THROW(writer.add("altitude", altitude), sipp::columnar_error);
+    ASSERT_THROW(writer.add(std::string(64, 'x'), altitude), sipp::columnar_error);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+#include <sipp/sipp.hpp>
+
+// Everything below is checked by the compiler, the test cases only repeat a few of the
+// same computations at runtime to make sure both evaluations agree
+
+namespace {
+
+template<class... Types>
+struct type_list {};
+
+using distances = type_list<sipp::Meters,
+                            sipp::Kilometers,
+                            sipp::Millimeters,
+                            sipp::Micrometers,
+                            sipp::Nanometers,
+                            sipp::Feet,
+                            sipp::NauticalMiles,
+                            sipp::StatuteMiles,
+                            sipp::f32::Meters,
+                            sipp::f32::Feet,
+                            sipp::f32::NauticalMiles>;
+
+using speeds = type_list<sipp::KmPerHour,
+                         sipp::MetersPerSecond,
+                         sipp::FeetPerSecond,
+                         sipp::FeetPerMinute,
+                         sipp::Knots,
+                         sipp::MilesPerHour,
+                         sipp::f32::MetersPerSecond,
+                         sipp::f32::Knots>;
+
+template<class T>
+constexpr bool near(T value, T expected)
+{
+    return (value - expected < 0 ? expected - value : value - expected)
+        <= (expected < 0 ? -expected : expected) * static_cast<T>(1e-5);
+}
+
+constexpr bool all_of(const bool *first, const bool *last)
+{
+    return first == last || (*first && all_of(first + 1, last));
+}
+
+// Implicit conversion, explicit cast, comparison and arithmetic across units
+template<class From, class To>
+constexpr bool distance_pair()
+{
+    const To converted = From(12.0);
+    To assigned;
+    assigned = From(12.0);
+    assigned += From(1.0);
+    assigned -= From(1.0);
+
+    return near(converted.count(), sipp::distance_cast<To>(From(12.0)).count())
+        && near(assigned.count(), converted.count())
+        && From(12.0) < From(13.0) + To(0.0)
+        && near(sipp::distance_cast<From>(converted).count(), From(12.0).count())
+        && near((converted - From(2.0)).count(), (From(10.0) + To(0.0)).count());
+}
+
+template<class From, class To>
+constexpr bool speed_pair()
+{
+    const To converted = From(12.0);
+    To assigned;
+    assigned = From(12.0);
+    assigned += From(1.0);
+    assigned -= From(1.0);
+
+    return near(converted.count(), sipp::speed_cast<To>(From(12.0)).count())
+        && near(assigned.count(), converted.count())
+        && From(12.0) < From(13.0) + To(0.0)
+        && near(sipp::speed_cast<From>(converted).count(), From(12.0).count());
+}
+
+template<class From, class... To>
+constexpr bool distance_row(type_list<To...>)
+{
+    const bool results[] = {distance_pair<From, To>()...};
+    return all_of(results, results + sizeof...(To));
+}
+
+template<class From, class... To>
+constexpr bool speed_row(type_list<To...>)
+{
+    const bool results[] = {speed_pair<From, To>()...};
+    return all_of(results, results + sizeof...(To));
+}
+
+template<class... From>
+constexpr bool all_distance_pairs(type_list<From...>)
+{
+    const bool results[] = {distance_row<From>(distances())...};
+    return all_of(results, results + sizeof...(From));
+}
+
+template<class... From>
+constexpr bool all_speed_pairs(type_list<From...>)
+{
+    const bool results[] = {speed_row<From>(speeds())...};
+    return all_of(results, results + sizeof...(From));
+}
+
+static_assert(all_distance_pairs(distances()), "Distance conversions must be constant expressions");
+static_assert(all_speed_pairs(speeds()), "Speed conversions must be constant expressions");
+
+using namespace sipp::literals;
+
+constexpr sipp::Feet hundred_km_in_feet = 100.0_km;
+static_assert(near(hundred_km_in_feet.count(), 328083.98950131), "");
+
+static_assert(near(sipp::Meters(1_ft).count(), 0.3048), "");
+static_assert(near(sipp::Meters(1.0_NM).count(), 1852.0), "");
+static_assert(near(sipp::Meters(1_mi).count(), 1609.34), "");
+static_assert(near(sipp::Meters(1_mm).count(), 1e-3), "");
+static_assert(near(sipp::Meters(1_um).count(), 1e-6), "");
+static_assert(near(sipp::Meters(1_nm).count(), 1e-9), "");
+static_assert(near(sipp::Kilometers(1500_m).count(), 1.5), "");
+
+static_assert(near(sipp::MetersPerSecond(sipp::KmPerHour(36.0)).count(), 10.0), "");
+static_assert(near(sipp::KmPerHour(sipp::Knots(1.0)).count(), 1.852), "");
+
+// Integer representations, exact and rounded
+using IntMeters = sipp::Distance<std::int64_t, std::ratio<1>>;
+using IntMillimeters = sipp::Distance<std::int64_t, std::milli>;
+
+static_assert(IntMillimeters(IntMeters(3)).count() == 3000, "");
+static_assert(sipp::distance_cast<IntMeters>(IntMillimeters(2500)).count() == 2, "");
+static_assert(sipp::floor<IntMeters>(IntMillimeters(-2500)).count() == -3, "");
+static_assert(sipp::ceil<IntMeters>(IntMillimeters(2500)).count() == 3, "");
+static_assert(sipp::round<IntMeters>(IntMillimeters(2500)).count() == 2, "");
+static_assert(sipp::round<IntMeters>(IntMillimeters(3500)).count() == 4, "");
+static_assert(IntMeters(1) + IntMillimeters(1) == IntMillimeters(1001), "");
+
+// Scalar arithmetic, negation, abs and compound assignment
+constexpr sipp::Meters scaled()
+{
+    sipp::Meters value(10.0);
+    value *= 3;
+    value /= 2;
+    value += 1_km;
+    return value;
+}
+
+static_assert(scaled().count() == 1015.0, "");
+static_assert((-sipp::Meters(2.0)).abs().count() == 2.0, "");
+static_assert((-sipp::Knots(2.0)).abs().count() == 2.0, "");
+static_assert((2 * sipp::Meters(2.0) / 4).count() == 1.0, "");
+static_assert(sipp::Meters(1.0) != sipp::Feet(1.0), "");
+
+// Mixed quantities
+static_assert(near((sipp::Knots(10.0) * std::chrono::hours(2)).count(), 20.0), "");
+static_assert(near(sipp::Meters(sipp::Knots(1.0) * std::chrono::duration<double>(3600.0)).count(),
+                   1852.0), "");
+static_assert(near((sipp::Meters(100.0) / std::chrono::duration<double>(10.0)).count(), 10.0), "");
+static_assert(near((sipp::NauticalMiles(10.0) / sipp::Knots(5.0)).count(), 2.0), "");
+
+}
+
+class ConstexprTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(ConstexprTestFixture, TestConstantAndRuntimeConversionsAgree)
+{
+    volatile double kilometers = 100.0;
+    ASSERT_EQ(hundred_km_in_feet.count(), sipp::Feet(sipp::Kilometers(kilometers)).count());
+
+    volatile double knots = 10.0;
+    constexpr sipp::MetersPerSecond constant = sipp::Knots(10.0);
+    ASSERT_EQ(constant.count(), sipp::MetersPerSecond(sipp::Knots(knots)).count());
+}
+
+TEST_F(ConstexprTestFixture, TestConstantArithmetic)
+{
+    ASSERT_EQ(1015.0, scaled().count());
+    ASSERT_TRUE((distance_pair<sipp::Feet, sipp::Kilometers>()));
+    ASSERT_TRUE((speed_pair<sipp::Knots, sipp::FeetPerMinute>()));
+}
@@ -33,6 +33,30 @@ TEST_F(DistanceTestFixture, TestExplicitConversionWithPrecisionLoss)
     ASSERT_EQ(1, km.count());
 }
 
+TEST_F(DistanceTestFixture, TestExplicitIntegerConversionIsExact)
+{
+    sipp::Distance<std::int64_t, std::milli> millimeters(1234567);
+    auto micrometers = sipp::distance_cast<sipp::Distance<std::int64_t, std::micro>>(millimeters);
+    ASSERT_EQ(1234567000, micrometers.count());
+}
+
+TEST_F(DistanceTestFixture, TestIdentityConversionKeepsValue)
+{
+    sipp::Meters meters(0.1);
+    auto same = sipp::distance_cast<sipp::Meters>(meters);
+    ASSERT_EQ(meters.count(), same.count());
+}
+
+TEST_F(DistanceTestFixture, TestConversionIsSingleMultiplication)
+{
+    // Feet -> Meters is folded into 381/1250, Kilometers -> Feet into 1250000/381
+    for (double value : {0.1, 1.0, 3.3, 12345.678, -98765.4321}) {
+        ASSERT_EQ(value * (381.0 / 1250.0), sipp::distance_cast<sipp::Meters>(sipp::Feet(value)).count());
+        ASSERT_EQ(value * (1250000.0 / 381.0),
+                  sipp::distance_cast<sipp::Feet>(sipp::Kilometers(value)).count());
+    }
+}
+
 TEST_F(DistanceTestFixture, TestMultiplyDistanceWithInteger)
 {
     auto d = 100.0_km;
@@ -166,3 +190,92 @@ TEST_F(DistanceTestFixture, TestAbs)
     ASSERT_EQ(altitude1.abs(), 1000_ft);
     ASSERT_EQ(altitude2.abs(), 1000_ft);
 }
+
+TEST_F(DistanceTestFixture, TestCommonType)
+{
+    static_assert(std::is_same<std::common_type<sipp::Meters, sipp::Kilometers>::type,
+                               sipp::Meters>::value, "");
+    static_assert(std::is_same<std::common_type<sipp::Feet, sipp::Feet>::type,
+                               sipp::Feet>::value, "");
+    static_assert(std::is_same<std::common_type<sipp::Distance<int, std::milli>,
+                                                sipp::Distance<long long, std::micro>>::type,
+                               sipp::Distance<long long, std::micro>>::value, "");
+
+    auto sum = 100.0_km + 20.0_m;
+    static_assert(std::is_same<decltype(sum), sipp::Meters>::value, "");
+    ASSERT_FLOAT_EQ(100020.0, sum.count());
+}
+
+TEST_F(DistanceTestFixture, TestMixedIntegerArithmetic)
+{
+    sipp::Distance<std::int64_t, std::milli> millimeters(3);
+    sipp::Distance<std::int64_t, std::micro> micrometers(250);
+
+    auto sum = millimeters + micrometers;
+    auto difference = micrometers - millimeters;
+    static_assert(std::is_same<decltype(sum), sipp::Distance<std::int64_t, std::micro>>::value, "");
+    ASSERT_EQ(3250, sum.count());
+    ASSERT_EQ(-2750, difference.count());
+
+    sipp::Distance<std::int64_t, std::micro> widened = millimeters;
+    ASSERT_EQ(3000, widened.count());
+}
+
+TEST_F(DistanceTestFixture, TestMixedIntegerComparison)
+{
+    sipp::Distance<int, std::kilo> kilometers(1);
+    sipp::Distance<int> meters(1001);
+
+    ASSERT_LT(kilometers, meters);
+    ASSERT_GT(meters, kilometers);
+    ASSERT_NE(kilometers, meters);
+    ASSERT_EQ(kilometers, sipp::Distance<int>(1000));
+}
+
+TEST_F(DistanceTestFixture, TestMixedFloatingComparison)
+{
+    // The right-hand side is scaled into the left-hand unit by one folded factor
+    constexpr sipp::Kilometers kilometers(1.5);
+    static_assert(kilometers == sipp::Meters(1500.0), "constexpr comparison");
+    static_assert(sipp::Meters(1500.0) == kilometers, "constexpr comparison");
+    ASSERT_LT(sipp::Meters(1499.9), kilometers);
+    ASSERT_GT(kilometers, sipp::Meters(1499.9));
+    ASSERT_LE(sipp::NauticalMiles(1.0), sipp::Meters(1852.0));
+    ASSERT_GE(sipp::Meters(1852.0), sipp::NauticalMiles(1.0));
+    ASSERT_LT(sipp::f32::Feet(3280.0f), kilometers);
+}
+
+TEST_F(DistanceTestFixture, TestIntegerRoundingPolicies)
+{
+    using IntMeters = sipp::Distance<int>;
+
+    ASSERT_EQ(1, sipp::floor<IntMeters>(sipp::Distance<int, std::milli>(1500)).count());
+    ASSERT_EQ(2, sipp::ceil<IntMeters>(sipp::Distance<int, std::milli>(1500)).count());
+    ASSERT_EQ(2, sipp::round<IntMeters>(sipp::Distance<int, std::milli>(1500)).count());
+    ASSERT_EQ(2, sipp::round<IntMeters>(sipp::Distance<int, std::milli>(2500)).count());
+    ASSERT_EQ(3, sipp::round<IntMeters>(sipp::Distance<int, std::milli>(2501)).count());
+    ASSERT_EQ(-2, sipp::floor<IntMeters>(sipp::Distance<int, std::milli>(-1500)).count());
+    ASSERT_EQ(-1, sipp::ceil<IntMeters>(sipp::Distance<int, std::milli>(-1500)).count());
+    ASSERT_EQ(-2, sipp::round<IntMeters>(sipp::Distance<int, std::milli>(-1500)).count());
+    ASSERT_EQ(-1, sipp::distance_cast<IntMeters>(sipp::Distance<int, std::milli>(-1500)).count());
+}
+
+TEST_F(DistanceTestFixture, TestFloatingToIntegerRoundingPolicies)
+{
+    using IntMeters = sipp::Distance<int>;
+
+    ASSERT_EQ(2, sipp::round<IntMeters>(1.5_m).count());
+    ASSERT_EQ(2, sipp::round<IntMeters>(2.5_m).count());
+    ASSERT_EQ(-3, sipp::round<IntMeters>(-2.6_m).count());
+    ASSERT_EQ(-1, sipp::floor<IntMeters>(-0.5_m).count());
+    ASSERT_EQ(1, sipp::ceil<IntMeters>(0.001_m).count());
+    ASSERT_EQ(0, sipp::distance_cast<IntMeters>(0.999_m).count());
+}
+
+TEST_F(DistanceTestFixture, TestIntegerConversionUsesWideIntermediate)
+{
+    // 9e18 * 381 overflows 64 bits, the exact result fits
+    sipp::Distance<std::int64_t, std::ratio<3048, 10000>> feet(9000000000000000000);
+    auto meters = sipp::distance_cast<sipp::Distance<std::int64_t>>(feet);
+    ASSERT_EQ(2743200000000000000, meters.count());
+}
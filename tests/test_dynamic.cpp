@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <sipp/dynamic.hpp>
+
+class DynamicTestFixture : public ::testing::Test {
+
+};
+
+namespace {
+
+template<class... Units>
+struct unit_list {};
+
+using distances = unit_list<sipp::Meters, sipp::Kilometers, sipp::Millimeters, sipp::Micrometers, sipp::Nanometers,
+                            sipp::Feet, sipp::NauticalMiles, sipp::StatuteMiles>;
+
+// distance_cast from a runtime unit agrees with the cast from its typedef
+template<class To, class... Froms>
+void expect_casts_match(unit_list<Froms...>)
+{
+    const double count = 1234.5678;
+    const bool matches[] = {
+        sipp::distance_cast<To>(sipp::dynamic_distance(count, sipp::unit_of<Froms>()))
+        == sipp::distance_cast<To>(Froms(count))...};
+    for (const bool match : matches) {
+        EXPECT_TRUE(match);
+    }
+}
+
+template<class To>
+void expect_all_casts_match()
+{
+    expect_casts_match<To>(distances());
+    expect_casts_match<sipp::Distance<float, typename To::ratio>>(distances());
+}
+
+}
+
+TEST_F(DynamicTestFixture, TestUnitIds)
+{
+    static_assert(sipp::unit_of<sipp::Meters>() == sipp::distance_unit::meters, "");
+    static_assert(sipp::unit_of<sipp::f32::Feet>() == sipp::distance_unit::feet, "");
+    static_assert(sipp::unit_of<sipp::Distance<int, std::ratio<1852>>>() == sipp::distance_unit::nautical_miles, "");
+    static_assert(sipp::unit_of<sipp::Knots>() == sipp::speed_unit::knots, "");
+    static_assert(sipp::unit_of<sipp::f32::MilesPerHour>() == sipp::speed_unit::miles_per_hour, "");
+
+    ASSERT_STREQ("NM", sipp::unit_symbol(sipp::distance_unit::nautical_miles));
+    ASSERT_STREQ("ft/min", sipp::unit_symbol(sipp::speed_unit::feet_per_minute));
+
+    const sipp::dynamic_distance altitude = sipp::Feet(35000.0);
+    ASSERT_EQ(sipp::distance_unit::feet, altitude.unit());
+    ASSERT_EQ(35000.0, altitude.count());
+}
+
+TEST_F(DynamicTestFixture, TestConversionsMatchCompileTimeCasts)
+{
+    const sipp::dynamic_distance miles(3.5, sipp::distance_unit::nautical_miles);
+    ASSERT_EQ(sipp::distance_cast<sipp::Feet>(sipp::NauticalMiles(3.5)).count(),
+              miles.in(sipp::distance_unit::feet).count());
+    ASSERT_EQ(sipp::distance_unit::feet, miles.in(sipp::distance_unit::feet).unit());
+    static_assert(sipp::dynamic_distance(2.0, sipp::distance_unit::kilometers).in(sipp::distance_unit::meters)
+                      .count() == 2000.0, "");
+
+    const sipp::dynamic_speed climb(3000.0, sipp::speed_unit::feet_per_minute);
+    ASSERT_EQ(sipp::speed_cast<sipp::Knots>(sipp::FeetPerMinute(3000.0)).count(),
+              climb.in(sipp::speed_unit::knots).count());
+    ASSERT_EQ(sipp::speed_cast<sipp::f32::KmPerHour>(sipp::FeetPerMinute(3000.0)).count(),
+              sipp::speed_cast<sipp::f32::KmPerHour>(climb).count());
+
+    expect_all_casts_match<sipp::Meters>();
+    expect_all_casts_match<sipp::Feet>();
+    expect_all_casts_match<sipp::NauticalMiles>();
+    expect_all_casts_match<sipp::Nanometers>();
+
+    using IntMeters = sipp::Distance<long, std::ratio<1>>;
+    ASSERT_EQ(1852, sipp::distance_cast<IntMeters>(sipp::dynamic_distance(1.0, sipp::distance_unit::nautical_miles))
+                        .count());
+}
+
+TEST_F(DynamicTestFixture, TestArithmeticAndComparison)
+{
+    const sipp::dynamic_distance meters(1852.0, sipp::distance_unit::meters);
+    const sipp::dynamic_distance miles(1.0, sipp::distance_unit::nautical_miles);
+    const sipp::dynamic_distance feet(1.0, sipp::distance_unit::feet);
+
+    ASSERT_TRUE(meters == miles);
+    ASSERT_FALSE(meters != miles);
+    ASSERT_TRUE(feet < miles);
+    ASSERT_TRUE(miles > feet);
+    ASSERT_TRUE(miles >= meters);
+    ASSERT_TRUE(feet <= feet);
+
+    const auto sum = miles + meters;
+    ASSERT_EQ(sipp::distance_unit::nautical_miles, sum.unit());
+    ASSERT_EQ(2.0, sum.count());
+    ASSERT_EQ(sipp::distance_unit::meters, (meters - miles).unit());
+    ASSERT_EQ(0.0, (meters - miles).count());
+    ASSERT_EQ(2.0, (miles * 2.0) / meters);
+    ASSERT_EQ(0.5, (miles / 2.0).count());
+    ASSERT_EQ(-1.0, (-miles).count());
+
+    sipp::dynamic_distance total(0.0, sipp::distance_unit::kilometers);
+    total += meters;
+    total -= sipp::Kilometers(0.852);
+    total *= 4.0;
+    total /= 2.0;
+    ASSERT_DOUBLE_EQ(2.0, total.count());
+}
+
+TEST_F(DynamicTestFixture, TestBatchConversionDispatchesPerArray)
+{
+    std::vector<double> feet(1000);
+    for (std::size_t i = 0; i < feet.size(); ++i) {
+        feet[i] = static_cast<double>(i) * 100.0 + 0.25;
+    }
+
+    std::vector<double> meters(feet.size());
+    ASSERT_EQ(feet.size(), sipp::convert(sipp::span<const double>(feet), sipp::distance_unit::feet,
+                                         sipp::span<double>(meters), sipp::distance_unit::meters));
+    std::vector<sipp::f32::NauticalMiles> miles(feet.size());
+    sipp::convert(sipp::span<const double>(feet), sipp::distance_unit::feet, sipp::span<sipp::f32::NauticalMiles>(miles));
+    for (std::size_t i = 0; i < feet.size(); ++i) {
+        ASSERT_EQ(sipp::Meters(sipp::Feet(feet[i])).count(), meters[i]);
+        ASSERT_EQ(sipp::distance_cast<sipp::f32::NauticalMiles>(sipp::Feet(feet[i])).count(), miles[i].count());
+    }
+
+    std::vector<sipp::Knots> knots = {sipp::Knots(100.0), sipp::Knots(250.0)};
+    std::vector<double> per_hour(3, -1.0);
+    ASSERT_EQ(2u, sipp::convert(sipp::span<const sipp::Knots>(knots), sipp::span<double>(per_hour),
+                                sipp::speed_unit::km_per_hour));
+    ASSERT_EQ(sipp::KmPerHour(knots[1]).count(), per_hour[1]);
+    ASSERT_EQ(-1.0, per_hour[2]);
+
+    std::vector<double> same(2);
+    sipp::convert(sipp::span<const double>(per_hour.data(), 2), sipp::speed_unit::km_per_hour,
+                  sipp::span<double>(same), sipp::speed_unit::km_per_hour);
+    ASSERT_EQ(per_hour[0], same[0]);
+}
+
+TEST_F(DynamicTestFixture, TestParseAndFormatKeepTheUnit)
+{
+    const auto altitude = sipp::parse<sipp::dynamic_distance>("35000 ft");
+    ASSERT_TRUE(static_cast<bool>(altitude));
+    ASSERT_EQ(sipp::distance_unit::feet, altitude.value.unit());
+    ASSERT_EQ(35000.0, altitude.value.count());
+
+    const auto speed = sipp::parse<sipp::dynamic_speed>("250kt");
+    ASSERT_EQ(sipp::speed_unit::knots, speed.value.unit());
+    ASSERT_EQ(sipp::parse_error::dimension_mismatch, sipp::parse<sipp::dynamic_speed>("250km").error);
+    ASSERT_EQ(sipp::parse_error::dimension_mismatch, sipp::parse<sipp::dynamic_distance>("250mph").error);
+
+    char buffer[sipp::max_formatted_size];
+    const auto formatted = sipp::to_chars(buffer, buffer + sizeof(buffer), speed.value);
+    ASSERT_EQ("250kts", std::string(buffer, formatted.ptr));
+}
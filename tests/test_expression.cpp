@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <utility>
+
+#include <sipp/expression.hpp>
+
+using namespace sipp::literals;
+using sipp::expr::lazy;
+
+class ExpressionTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(ExpressionTestFixture, TestMixedUnitScalarExpression)
+{
+    auto a = 1.0_km;
+    auto b = 1000.0_ft;
+    auto c = 1.0_NM;
+
+    auto meters = sipp::expr::evaluate<sipp::Meters>(lazy(a) + b - c * 2);
+    ASSERT_FLOAT_EQ(1000.0 + 304.8 - 3704.0, meters.count());
+}
+
+TEST_F(ExpressionTestFixture, TestDefaultsToLeftmostUnit)
+{
+    auto sum = sipp::expr::evaluate(lazy(2.0_km) + 500.0_m);
+    ASSERT_FLOAT_EQ(2.5, sum.count());
+    ASSERT_EQ(2.5_km, sum);
+}
+
+TEST_F(ExpressionTestFixture, TestScalarOperations)
+{
+    auto result = sipp::expr::evaluate<sipp::Meters>(-(3 * lazy(1.0_km) / 2.0) + 500.0_m);
+    ASSERT_FLOAT_EQ(-1000.0, result.count());
+}
+
+TEST_F(ExpressionTestFixture, TestIntegralTargetIsConvertedOnce)
+{
+    const sipp::Distance<int> a(10);
+    const sipp::Distance<int> b(3);
+    ASSERT_EQ(14, sipp::expr::evaluate(lazy(a) + lazy(b) * 1.5).count());
+    ASSERT_EQ(16, sipp::expr::evaluate(lazy(a) + lazy(b) * 1.5 + lazy(b) * 0.5).count());
+    ASSERT_EQ(8, sipp::expr::evaluate(lazy(a) - lazy(b) / 1.5).count());
+
+    sipp::quantity_vector<sipp::Distance<int>> values{a, b};
+    const auto scaled = sipp::expr::materialize<sipp::Distance<int>>(lazy(values) * 0.5 + lazy(values) * 0.5);
+    ASSERT_EQ(10, scaled[0].count());
+    ASSERT_EQ(3, scaled[1].count());
+}
+
+template<class T, class = void>
+struct is_lazy_callable : std::false_type {};
+
+template<class T>
+struct is_lazy_callable<T, decltype(void(lazy(std::declval<T>())))> : std::true_type {};
+
+TEST_F(ExpressionTestFixture, TestTemporaryVectorsAreRejected)
+{
+    static_assert(is_lazy_callable<const sipp::quantity_vector<sipp::Meters> &>::value, "");
+    static_assert(!is_lazy_callable<sipp::quantity_vector<sipp::Meters>>::value,
+                  "An expression over a temporary vector would dangle");
+}
+
+TEST_F(ExpressionTestFixture, TestSpeedExpression)
+{
+    auto knots = sipp::expr::evaluate<sipp::Knots>(lazy(100.0_km_h) - 10.0_kts);
+    ASSERT_FLOAT_EQ(100.0 / 1.852 - 10.0, knots.count());
+}
+
+TEST_F(ExpressionTestFixture, TestArrayExpression)
+{
+    sipp::quantity_vector<sipp::Kilometers> kilometers{1.0_km, 2.0_km, 3.0_km};
+    sipp::quantity_vector<sipp::Feet> feet{1000.0_ft, 2000.0_ft, 3000.0_ft};
+
+    auto meters = sipp::expr::materialize<sipp::Meters>(lazy(kilometers) + lazy(feet) * 2 - 1.0_NM);
+    ASSERT_EQ(3u, meters.size());
+    for (std::size_t i = 0; i < meters.size(); ++i) {
+        const double expected = (i + 1) * 1000.0 + (i + 1) * 1000.0 * 0.3048 * 2 - 1852.0;
+        ASSERT_FLOAT_EQ(expected, meters[i].count());
+    }
+}
+
+TEST_F(ExpressionTestFixture, TestAssignIntoSpan)
+{
+    std::vector<sipp::Meters> meters{1.0_m, 2.0_m, 3.0_m, 4.0_m};
+    std::vector<sipp::Kilometers> kilometers(2);
+
+    sipp::expr::assign(sipp::span<sipp::Kilometers>(kilometers),
+                       lazy(sipp::span<const sipp::Meters>(meters)) * 1000);
+    ASSERT_FLOAT_EQ(1.0, kilometers[0].count());
+    ASSERT_FLOAT_EQ(2.0, kilometers[1].count());
+}
+
+TEST_F(ExpressionTestFixture, TestViewTerms)
+{
+    sipp::quantity_vector<sipp::Meters> meters{1852.0_m, 3704.0_m};
+
+    auto doubled = sipp::expr::materialize<sipp::NauticalMiles>(
+        lazy(meters.as<sipp::NauticalMiles>()) + lazy(meters));
+    ASSERT_FLOAT_EQ(2.0, doubled[0].count());
+    ASSERT_FLOAT_EQ(4.0, doubled[1].count());
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <sipp/format.hpp>
+#include <sipp/parse.hpp>
+
+class FormatTestFixture : public ::testing::Test {
+protected:
+    template<class Quantity>
+    static std::string format(const Quantity &value)
+    {
+        char buffer[sipp::max_formatted_size];
+        const auto result = sipp::to_chars(buffer, buffer + sizeof(buffer), value);
+        EXPECT_EQ(std::errc(), result.ec);
+        return std::string(buffer, result.ptr);
+    }
+};
+
+TEST_F(FormatTestFixture, TestEveryUnitHasItsSymbol)
+{
+    using namespace sipp::literals;
+
+    ASSERT_EQ("12.5m", format(12.5_m));
+    ASSERT_EQ("12.5km", format(12.5_km));
+    ASSERT_EQ("12.5mm", format(12.5_mm));
+    ASSERT_EQ("12.5um", format(12.5_um));
+    ASSERT_EQ("12.5nm", format(12.5_nm));
+    ASSERT_EQ("12.5ft", format(12.5_ft));
+    ASSERT_EQ("12.5NM", format(12.5_NM));
+    ASSERT_EQ("12.5mi", format(12.5_mi));
+
+    ASSERT_EQ("250km/h", format(250.0_km_h));
+    ASSERT_EQ("250m/s", format(250.0_m_s));
+    ASSERT_EQ("250ft/s", format(250.0_ft_s));
+    ASSERT_EQ("3000ft/min", format(3000.0_ft_min));
+    ASSERT_EQ("250kts", format(250.0_kts));
+    ASSERT_EQ("250mph", format(250.0_mph));
+
+    ASSERT_EQ("1.5km", format(sipp::f32::Kilometers(1.5f)));
+    ASSERT_EQ("-42m", format(sipp::Distance<std::int64_t, std::ratio<1>>(-42)));
+    ASSERT_EQ("7kts", format(sipp::Speed<int, sipp::NauticalMiles, std::ratio<3600>>(7)));
+}
+
+TEST_F(FormatTestFixture, TestShortestOutput)
+{
+    ASSERT_EQ("0.3048m", format(sipp::Meters(0.3048)));
+    ASSERT_EQ("0.1m", format(sipp::Meters(0.1)));
+    ASSERT_EQ("0m", format(sipp::Meters(0.0)));
+    ASSERT_EQ("-0.001km", format(sipp::Kilometers(-0.001)));
+    ASSERT_EQ("0.1ft", format(sipp::f32::Feet(0.1f)));
+    ASSERT_EQ("100000000m", format(sipp::Meters(1e8)));
+    ASSERT_EQ("0.30000000000000004m", format(sipp::Meters(0.1 + 0.2)));
+    ASSERT_EQ("9007199254740991m", format(sipp::Meters(9007199254740991.0)));
+    ASSERT_EQ("0.0001m", format(sipp::Meters(1e-4)));
+    // 0x1.7bca62360b928p+46, the digits of the shortest decimal are rounded half to even
+    ASSERT_EQ("104396034507492.62m", format(sipp::Meters(std::ldexp(static_cast<double>(0x17bca62360b928ull), -6))));
+
+    const auto third = format(sipp::Meters(1.0 / 3.0));
+    ASSERT_EQ(1.0 / 3.0, std::strtod(third.c_str(), nullptr));
+    ASSERT_GE(19u, third.size());
+}
+
+TEST_F(FormatTestFixture, TestShortestOutputOverTheWholeRange)
+{
+    // Outside the fast paths: the layout of std::to_chars, fixed or scientific
+    ASSERT_EQ("1e+16m", format(sipp::Meters(1e16)));
+    ASSERT_EQ("1.7976931348623157e+308m", format(sipp::Meters(std::numeric_limits<double>::max())));
+    ASSERT_EQ("5e-324m", format(sipp::Meters(std::numeric_limits<double>::denorm_min())));
+    ASSERT_EQ("2.2250738585072014e-308m", format(sipp::Meters(std::numeric_limits<double>::min())));
+    ASSERT_EQ("1.5e-05m", format(sipp::Meters(1.5e-5)));
+    ASSERT_EQ("-1e+23m", format(sipp::Meters(-1e23)));
+    ASSERT_EQ("123456789012345683968m", format(sipp::Meters(1.2345678901234568e20)));
+    ASSERT_EQ("3.4028235e+38m", format(sipp::f32::Meters(std::numeric_limits<float>::max())));
+    ASSERT_EQ("1e-45m", format(sipp::f32::Meters(std::numeric_limits<float>::denorm_min())));
+    ASSERT_EQ("443091424m", format(sipp::f32::Meters(443091424.0f)));
+
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 10000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double value = 0.0;
+        std::memcpy(&value, &state, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        const auto text = format(sipp::Meters(value));
+        ASSERT_EQ(value, std::strtod(text.c_str(), nullptr)) << text;
+        ASSERT_EQ(value, sipp::parse<sipp::Meters>(text.c_str()).value.count()) << text;
+    }
+}
+
+TEST_F(FormatTestFixture, TestOutputRoundTripsThroughParse)
+{
+    std::mt19937_64 generator(42);
+    std::uniform_int_distribution<int> exponent(-30, 30);
+    std::uniform_real_distribution<double> mantissa(-10.0, 10.0);
+
+    for (int i = 0; i < 20000; ++i) {
+        const double value = std::ldexp(mantissa(generator), exponent(generator));
+        const sipp::NauticalMiles miles(value);
+        const auto parsed = sipp::parse<sipp::NauticalMiles>(format(miles).c_str());
+        ASSERT_TRUE(static_cast<bool>(parsed)) << format(miles);
+        ASSERT_EQ(value, parsed.value.count()) << format(miles);
+
+        const sipp::f32::Knots knots(static_cast<float>(value));
+        const auto parsed_knots = sipp::parse<sipp::f32::Knots>(format(knots).c_str());
+        ASSERT_EQ(knots.count(), parsed_knots.value.count()) << format(knots);
+    }
+
+    const double extremes[] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::min(),
+                               std::numeric_limits<double>::denorm_min(), 1e15, 123456789012345.67};
+    for (const double value : extremes) {
+        ASSERT_EQ(value, sipp::parse<sipp::Meters>(format(sipp::Meters(value)).c_str()).value.count());
+    }
+}
+
+TEST_F(FormatTestFixture, TestFormatIgnoresLocale)
+{
+    const char *previous = std::setlocale(LC_NUMERIC, nullptr);
+    const std::string saved = previous != nullptr ? previous : "C";
+    if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8") == nullptr) {
+        std::setlocale(LC_NUMERIC, "C");
+    }
+
+    const auto fixed = format(sipp::Kilometers(1.5));
+    const auto general = format(sipp::Kilometers(1.0 / 3.0));
+    std::setlocale(LC_NUMERIC, saved.c_str());
+
+    ASSERT_EQ("1.5km", fixed);
+    ASSERT_EQ(std::string::npos, general.find(','));
+}
+
+TEST_F(FormatTestFixture, TestBufferTooSmall)
+{
+    char buffer[8] = "xxxxxxx";
+    const auto result = sipp::to_chars(buffer, buffer + 5, sipp::FeetPerMinute(3000.0));
+    ASSERT_EQ(std::errc::value_too_large, result.ec);
+    ASSERT_EQ(buffer + 5, result.ptr);
+    ASSERT_EQ(std::string("xxxxxxx"), buffer);
+
+    const auto fits = sipp::to_chars(buffer, buffer + 5, sipp::Meters(12.5));
+    ASSERT_EQ(std::errc(), fits.ec);
+    ASSERT_EQ("12.5m", std::string(buffer, fits.ptr));
+}
+
+TEST_F(FormatTestFixture, TestFormatColumn)
+{
+    std::vector<sipp::Meters> values = {sipp::Meters(12.5), sipp::Meters(-3.0), sipp::Meters(0.25)};
+    char text[64];
+
+    const auto all = sipp::format_column(sipp::span<sipp::Meters>(values), text, text + sizeof(text));
+    ASSERT_EQ(3u, all.count);
+    ASSERT_EQ("12.5m\n-3m\n0.25m\n", std::string(text, all.ptr));
+
+    std::vector<sipp::Meters> parsed(3);
+    const auto back = sipp::parse_column(text, all.ptr, sipp::span<sipp::Meters>(parsed));
+    ASSERT_EQ(3u, back.count);
+    ASSERT_EQ(values, parsed);
+
+    const auto partial = sipp::format_column(sipp::span<sipp::Meters>(values), text, text + 10, ';');
+    ASSERT_EQ(2u, partial.count);
+    ASSERT_EQ("12.5m;-3m;", std::string(text, partial.ptr));
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include <sipp/geodesy.hpp>
+
+class GeodesyTestFixture : public ::testing::Test {
+
+};
+
+namespace {
+
+const double pi = 3.14159265358979323846;
+
+double degrees(double degrees, double minutes, double seconds)
+{
+    const double magnitude = std::abs(degrees) + minutes / 60.0 + seconds / 3600.0;
+    return degrees < 0.0 ? -magnitude : magnitude;
+}
+
+std::vector<sipp::geo_point> random_points(std::size_t count, std::uint64_t state)
+{
+    std::vector<sipp::geo_point> points(count);
+    for (auto &point : points) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        point.latitude = static_cast<double>(state >> 11) / 9007199254740992.0 * 180.0 - 90.0;
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        point.longitude = static_cast<double>(state >> 11) / 9007199254740992.0 * 360.0 - 180.0;
+    }
+    return points;
+}
+
+}
+
+TEST_F(GeodesyTestFixture, TestVincentyReferenceGeodesic)
+{
+    // Vincenty (1975) / Geoscience Australia: Flinders Peak to Buninyong
+    const sipp::geo_point flinders_peak{degrees(-37, 57, 3.72030), degrees(144, 25, 29.52440)};
+    const sipp::geo_point buninyong{degrees(-37, 39, 10.15610), degrees(143, 55, 35.38390)};
+
+    ASSERT_NEAR(54972.271, sipp::vincenty(flinders_peak, buninyong).count(), 1e-3);
+    ASSERT_NEAR(54972.271 / 1852.0, sipp::vincenty<sipp::NauticalMiles>(flinders_peak, buninyong).count(), 1e-6);
+    ASSERT_NEAR(54972.271, sipp::vincenty(buninyong, flinders_peak).count(), 1e-3);
+
+    // one degree of longitude on the equator is a / 180 * pi on the ellipsoid
+    ASSERT_NEAR(6378137.0 * pi / 180.0, sipp::vincenty(sipp::geo_point{0.0, 0.0}, sipp::geo_point{0.0, 1.0}).count(),
+                1e-6);
+    ASSERT_EQ(0.0, sipp::vincenty(buninyong, buninyong).count());
+}
+
+TEST_F(GeodesyTestFixture, TestVincentyAntipodalPoints)
+{
+    // reference lengths from GeographicLib (Karney 2013), where the iteration diverges
+    struct geodesic {
+        sipp::geo_point from;
+        sipp::geo_point to;
+        double meters;
+    };
+    const geodesic geodesics[] = {
+        {{0.0, 0.0}, {0.0, 180.0}, 20003931.458625447},
+        {{0.0, 0.0}, {0.5, 179.7}, 19944127.420750458},
+        {{0.0, 0.0}, {0.0, 179.7}, 19995624.889961265},
+        {{0.0, 0.0}, {0.0, -179.7}, 19995624.889961265},
+        {{0.001, 0.0}, {0.0, 179.9}, 20002899.375704896},
+        {{0.0, 0.0}, {-0.1, 179.95}, 19992675.94161326},
+        {{-30.0, 0.0}, {29.9, 179.8}, 19989832.82760953},
+        {{45.0, 10.0}, {-45.0, -170.0}, 20003931.458625447},
+        {{90.0, 0.0}, {-90.0, 0.0}, 20003931.458625447},
+    };
+    for (const auto &expected : geodesics) {
+        ASSERT_NEAR(expected.meters, sipp::vincenty(expected.from, expected.to).count(), 1e-3)
+            << expected.from.latitude << " " << expected.from.longitude << " to " << expected.to.latitude << " "
+            << expected.to.longitude;
+        ASSERT_NEAR(expected.meters, sipp::vincenty(expected.to, expected.from).count(), 1e-3);
+    }
+}
+
+TEST_F(GeodesyTestFixture, TestHaversine)
+{
+    const sipp::geo_point origin{0.0, 0.0};
+    // one arc minute of a great circle is one nautical mile on a sphere of 1852 * 60 * 180 / pi meters
+    ASSERT_NEAR(6371008.8 * pi / 180.0, sipp::haversine(origin, sipp::geo_point{1.0, 0.0}).count(), 1e-6);
+    ASSERT_NEAR(6371008.8 * pi, sipp::haversine(origin, sipp::geo_point{0.0, 180.0}).count(), 1e-6);
+
+    const sipp::geo_point flinders_peak{degrees(-37, 57, 3.72030), degrees(144, 25, 29.52440)};
+    const sipp::geo_point buninyong{degrees(-37, 39, 10.15610), degrees(143, 55, 35.38390)};
+    const auto sphere = sipp::haversine<sipp::NauticalMiles>(flinders_peak, buninyong);
+    ASSERT_NEAR(54972.271 / 1852.0, sphere.count(), 54972.271 / 1852.0 * 0.005);
+}
+
+TEST_F(GeodesyTestFixture, TestBatchKernelsMatchScalar)
+{
+    const auto from = random_points(1003, 1);
+    auto to = random_points(1003, 2);
+    // short legs exercise the small-angle end of asin
+    for (std::size_t i = 0; i < 100; ++i) {
+        to[i].latitude = from[i].latitude + 1e-6 * static_cast<double>(i);
+        to[i].longitude = from[i].longitude - 2e-6 * static_cast<double>(i);
+    }
+
+    std::vector<double> expected(from.size());
+    sipp::detail::haversine_portable(from.data(), to.data(), expected.data(), from.size(), 6371008.8);
+
+    const sipp::simd_isa isas[] = {sipp::simd_isa::avx2, sipp::simd_isa::avx512};
+    for (const auto isa : isas) {
+        if (static_cast<int>(isa) > static_cast<int>(sipp::active_simd_isa())) {
+            continue;
+        }
+        std::vector<double> actual(from.size());
+        sipp::detail::select_haversine_kernel(isa)(from.data(), to.data(), actual.data(), from.size(), 6371008.8);
+        for (std::size_t i = 0; i < from.size(); ++i) {
+            ASSERT_NEAR(expected[i], actual[i], 1e-6 + expected[i] * 1e-14) << i;
+        }
+    }
+
+    std::vector<sipp::NauticalMiles> miles(from.size());
+    ASSERT_EQ(from.size(), sipp::haversine(sipp::span<const sipp::geo_point>(from),
+                                           sipp::span<const sipp::geo_point>(to),
+                                           sipp::span<sipp::NauticalMiles>(miles)));
+    std::vector<sipp::f32::Kilometers> kilometers(from.size());
+    sipp::haversine(sipp::span<const sipp::geo_point>(from), sipp::span<const sipp::geo_point>(to),
+                    sipp::span<sipp::f32::Kilometers>(kilometers));
+    std::vector<sipp::Meters> geodesics(10);
+    ASSERT_EQ(10u, sipp::vincenty(sipp::span<const sipp::geo_point>(from), sipp::span<const sipp::geo_point>(to),
+                                  sipp::span<sipp::Meters>(geodesics)));
+    for (std::size_t i = 0; i < from.size(); ++i) {
+        ASSERT_NEAR(expected[i] / 1852.0, miles[i].count(), 1e-9 + expected[i] / 1852.0 * 1e-14);
+        ASSERT_NEAR(expected[i] / 1000.0, kilometers[i].count(), expected[i] / 1000.0 * 1e-6);
+    }
+    for (std::size_t i = 0; i < geodesics.size(); ++i) {
+        ASSERT_NEAR(expected[i], geodesics[i].count(), expected[i] * 0.005 + 1e-6);
+    }
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <sipp/kinematics.hpp>
+
+class KinematicsTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(KinematicsTestFixture, TestAdvanceMatchesScalarOperators)
+{
+    std::vector<sipp::Meters> positions;
+    std::vector<sipp::Knots> velocities;
+    for (int i = 0; i < 1003; ++i) {
+        positions.emplace_back(static_cast<double>(i) * 37.5 - 10000.0);
+        velocities.emplace_back(static_cast<double>(i % 17) * 25.0 - 100.0);
+    }
+    auto expected = positions;
+    const std::chrono::milliseconds timestep(100);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        expected[i] += velocities[i] * timestep;
+    }
+
+    ASSERT_EQ(positions.size(), sipp::advance(sipp::span<sipp::Meters>(positions),
+                                              sipp::span<const sipp::Knots>(velocities), timestep));
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        ASSERT_DOUBLE_EQ(expected[i].count(), positions[i].count());
+    }
+
+    std::vector<sipp::f32::Feet> feet(10, sipp::f32::Feet(1000.0f));
+    std::vector<sipp::f32::FeetPerMinute> climb(10, sipp::f32::FeetPerMinute(1200.0f));
+    sipp::advance(sipp::span<sipp::f32::Feet>(feet), sipp::span<sipp::f32::FeetPerMinute>(climb),
+                  std::chrono::seconds(30));
+    for (const auto &altitude : feet) {
+        ASSERT_FLOAT_EQ(1600.0f, altitude.count());
+    }
+}
+
+TEST_F(KinematicsTestFixture, TestAdvanceWithIntegralRepresentations)
+{
+    using IntMillimeters = sipp::Distance<long, std::milli>;
+    using IntMillimetersPerSecond = sipp::Speed<long, IntMillimeters, std::ratio<1>>;
+
+    std::vector<IntMillimeters> positions = {IntMillimeters(0), IntMillimeters(500)};
+    std::vector<IntMillimetersPerSecond> velocities = {IntMillimetersPerSecond(3000), IntMillimetersPerSecond(-2000)};
+    auto expected = positions;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        expected[i] += velocities[i] * std::chrono::milliseconds(250);
+    }
+
+    sipp::advance(sipp::span<IntMillimeters>(positions), sipp::span<IntMillimetersPerSecond>(velocities),
+                  std::chrono::milliseconds(250));
+    ASSERT_EQ(expected, positions);
+    ASSERT_EQ(750, positions[0].count());
+    ASSERT_EQ(0, positions[1].count());
+}
+
+TEST_F(KinematicsTestFixture, TestTimeToGo)
+{
+    std::vector<sipp::NauticalMiles> distances;
+    std::vector<sipp::Knots> speeds;
+    for (int i = 1; i <= 100; ++i) {
+        distances.emplace_back(static_cast<double>(i) * 1.5);
+        speeds.emplace_back(static_cast<double>(i % 7 + 1) * 60.0);
+    }
+
+    std::vector<std::chrono::duration<double>> seconds(distances.size());
+    ASSERT_EQ(distances.size(), sipp::time_to_go(sipp::span<const sipp::NauticalMiles>(distances),
+                                                 sipp::span<const sipp::Knots>(speeds),
+                                                 sipp::span<std::chrono::duration<double>>(seconds)));
+    for (std::size_t i = 0; i < distances.size(); ++i) {
+        const auto expected = std::chrono::duration_cast<std::chrono::duration<double>>(distances[i] / speeds[i]);
+        ASSERT_DOUBLE_EQ(expected.count(), seconds[i].count());
+    }
+
+    std::vector<sipp::Meters> meters = {sipp::Meters(1852.0), sipp::Meters(1.0)};
+    std::vector<sipp::Knots> stopped = {sipp::Knots(1.0), sipp::Knots(0.0)};
+    std::vector<std::chrono::duration<double, std::ratio<3600>>> hours(2);
+    sipp::time_to_go(sipp::span<const sipp::Meters>(meters), sipp::span<const sipp::Knots>(stopped),
+                     sipp::span<std::chrono::duration<double, std::ratio<3600>>>(hours));
+    ASSERT_DOUBLE_EQ(1.0, hours[0].count());
+    ASSERT_EQ(std::numeric_limits<double>::infinity(), hours[1].count());
+
+    std::vector<std::chrono::milliseconds> milliseconds(2);
+    std::vector<sipp::MetersPerSecond> walking = {sipp::MetersPerSecond(2.0), sipp::MetersPerSecond(4.0)};
+    sipp::time_to_go(sipp::span<const sipp::Meters>(meters), sipp::span<const sipp::MetersPerSecond>(walking),
+                     sipp::span<std::chrono::milliseconds>(milliseconds));
+    ASSERT_EQ(926000, milliseconds[0].count());
+    ASSERT_EQ(250, milliseconds[1].count());
+
+    // Integral zero speeds saturate instead of dividing by zero
+    using IntMeters = sipp::Distance<long long>;
+    using IntMetersPerSecond = sipp::Speed<long long, IntMeters, std::ratio<1>>;
+    const std::vector<IntMeters> remaining = {IntMeters(10), IntMeters(-10), IntMeters(0), IntMeters(10)};
+    const std::vector<IntMetersPerSecond> speeds_int = {IntMetersPerSecond(0), IntMetersPerSecond(0),
+                                                        IntMetersPerSecond(0), IntMetersPerSecond(5)};
+    std::vector<std::chrono::seconds> seconds_int(remaining.size());
+    sipp::time_to_go(sipp::span<const IntMeters>(remaining), sipp::span<const IntMetersPerSecond>(speeds_int),
+                     sipp::span<std::chrono::seconds>(seconds_int));
+    ASSERT_EQ(std::chrono::seconds::max(), seconds_int[0]);
+    ASSERT_EQ(std::chrono::seconds::min(), seconds_int[1]);
+    ASSERT_EQ(std::chrono::seconds::zero(), seconds_int[2]);
+    ASSERT_EQ(2, seconds_int[3].count());
+
+    std::vector<std::chrono::duration<double>> seconds_floating(remaining.size());
+    sipp::time_to_go(sipp::span<const IntMeters>(remaining), sipp::span<const IntMetersPerSecond>(speeds_int),
+                     sipp::span<std::chrono::duration<double>>(seconds_floating));
+    ASSERT_EQ(std::numeric_limits<double>::infinity(), seconds_floating[0].count());
+    ASSERT_EQ(-std::numeric_limits<double>::infinity(), seconds_floating[1].count());
+    ASSERT_EQ(0.0, seconds_floating[2].count());
+
+    // Floating counts into an integral duration
+    std::vector<std::chrono::milliseconds> stopped_ms(2);
+    sipp::time_to_go(sipp::span<const sipp::Meters>(meters), sipp::span<const sipp::Knots>(stopped),
+                     sipp::span<std::chrono::milliseconds>(stopped_ms));
+    ASSERT_EQ(std::chrono::milliseconds::max(), stopped_ms[1]);
+
+    // Tiny floating speeds give quotients beyond the range of an integral duration
+    std::vector<sipp::Meters> signed_meters = {sipp::Meters(1.0), sipp::Meters(-1.0), sipp::Meters(1.0)};
+    std::vector<sipp::MetersPerSecond> crawling = {sipp::MetersPerSecond(1e-300), sipp::MetersPerSecond(1e-300),
+                                                   sipp::MetersPerSecond(0.5)};
+    std::vector<std::chrono::duration<int>> crawling_seconds(3);
+    sipp::time_to_go(sipp::span<const sipp::Meters>(signed_meters), sipp::span<const sipp::MetersPerSecond>(crawling),
+                     sipp::span<std::chrono::duration<int>>(crawling_seconds));
+    ASSERT_EQ(std::chrono::duration<int>::max(), crawling_seconds[0]);
+    ASSERT_EQ(std::chrono::duration<int>::min(), crawling_seconds[1]);
+    ASSERT_EQ(2, crawling_seconds[2].count());
+}
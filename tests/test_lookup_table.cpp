@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <sipp/lookup_table.hpp>
+
+class LookupTableTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(LookupTableTestFixture, TestInterpolation)
+{
+    const sipp::lookup_table<sipp::Feet, sipp::FeetPerMinute> climb{
+        {sipp::Feet(0.0), sipp::FeetPerMinute(2500.0)},
+        {sipp::Feet(10000.0), sipp::FeetPerMinute(2000.0)},
+        {sipp::Feet(25000.0), sipp::FeetPerMinute(1000.0)},
+        {sipp::Feet(35000.0), sipp::FeetPerMinute(300.0)}};
+    ASSERT_EQ(4u, climb.size());
+    ASSERT_FALSE(climb.uniform());
+    ASSERT_EQ(25000.0, climb.key(2).count());
+    ASSERT_EQ(1000.0, climb.value(2).count());
+
+    ASSERT_EQ(2500.0, climb.interpolate(sipp::Feet(0.0)).count());
+    ASSERT_EQ(2250.0, climb.interpolate(sipp::Feet(5000.0)).count());
+    ASSERT_EQ(2000.0, climb.interpolate(sipp::Feet(10000.0)).count());
+    ASSERT_EQ(650.0, climb.interpolate(sipp::Feet(30000.0)).count());
+    // Constant beyond the ends
+    ASSERT_EQ(2500.0, climb.interpolate(sipp::Feet(-500.0)).count());
+    ASSERT_EQ(300.0, climb.interpolate(sipp::Feet(41000.0)).count());
+    ASSERT_TRUE(std::isnan(climb.interpolate(sipp::Feet(std::nan(""))).count()));
+
+    // Keys in other units
+    ASSERT_NEAR(2250.0, climb.interpolate(sipp::Meters(1524.0)).count(), 1e-9);
+    ASSERT_NEAR(2250.0, climb.interpolate(sipp::f32::Kilometers(1.524f)).count(), 1e-3);
+
+    // Breakpoints in other units, converted once
+    const std::vector<sipp::Meters> altitudes{sipp::Meters(0.0), sipp::Meters(3048.0)};
+    const std::vector<sipp::Knots> speeds{sipp::Knots(250.0), sipp::Knots(300.0)};
+    const sipp::span<const sipp::Meters> keys(altitudes);
+    const sipp::lookup_table<sipp::Feet, sipp::KmPerHour> table(keys, sipp::span<const sipp::Knots>(speeds));
+    ASSERT_NEAR(10000.0, table.key(1).count(), 1e-9);
+    ASSERT_NEAR(509.3, table.interpolate(sipp::Feet(5000.0)).count(), 1e-9);
+    ASSERT_TRUE(table.uniform());
+}
+
+TEST_F(LookupTableTestFixture, TestInvalidBreakpoints)
+{
+    using table = sipp::lookup_table<sipp::Meters, sipp::Knots>;
+    ASSERT_THROW(table({{sipp::Meters(1.0), sipp::Knots(1.0)}}), std::invalid_argument);
+    ASSERT_THROW(table({{sipp::Meters(1.0), sipp::Knots(1.0)}, {sipp::Meters(1.0), sipp::Knots(2.0)}}),
+                 std::invalid_argument);
+    ASSERT_THROW(table({{sipp::Meters(2.0), sipp::Knots(1.0)}, {sipp::Meters(1.0), sipp::Knots(2.0)}}),
+                 std::invalid_argument);
+
+    const std::vector<sipp::Meters> keys{sipp::Meters(1.0), sipp::Meters(2.0)};
+    const std::vector<sipp::Knots> values{sipp::Knots(1.0)};
+    ASSERT_THROW(table(sipp::span<const sipp::Meters>(keys), sipp::span<const sipp::Knots>(values)),
+                 std::invalid_argument);
+}
+
+TEST_F(LookupTableTestFixture, TestBatchMatchesScalar)
+{
+    std::mt19937_64 random(7);
+    for (const std::size_t size : {2u, 3u, 7u, 8u, 100u, 1000u}) {
+        for (const bool uniform : {false, true}) {
+            std::vector<sipp::NauticalMiles> keys;
+            std::vector<sipp::Knots> values;
+            double key = -10.0;
+            for (std::size_t i = 0; i < size; ++i) {
+                keys.emplace_back(key);
+                values.emplace_back(std::uniform_real_distribution<double>(100.0, 500.0)(random));
+                key += uniform ? 0.1 : std::uniform_real_distribution<double>(0.01, 5.0)(random);
+            }
+            const sipp::span<const sipp::NauticalMiles> breakpoints(keys);
+            const sipp::lookup_table<sipp::NauticalMiles, sipp::Knots> table(breakpoints,
+                                                                             sipp::span<const sipp::Knots>(values));
+            ASSERT_EQ(uniform || size == 2, table.uniform());
+
+            // Every breakpoint, beyond both ends and at random, in meters and out in km/h
+            std::vector<sipp::Meters> queries;
+            for (const auto &breakpoint : keys) {
+                queries.emplace_back(breakpoint);
+            }
+            queries.emplace_back(sipp::NauticalMiles(-20.0));
+            queries.emplace_back(sipp::NauticalMiles(key + 20.0));
+            queries.emplace_back(std::numeric_limits<double>::infinity());
+            queries.emplace_back(-std::numeric_limits<double>::infinity());
+            std::uniform_real_distribution<double> around(-12.0, key + 2.0);
+            for (int i = 0; i < 203; ++i) {
+                queries.emplace_back(sipp::NauticalMiles(around(random)));
+            }
+            std::vector<sipp::KmPerHour> results(queries.size());
+            ASSERT_EQ(queries.size(), table.interpolate(sipp::span<sipp::Meters>(queries),
+                                                        sipp::span<sipp::KmPerHour>(results)));
+
+            for (std::size_t i = 0; i < queries.size(); ++i) {
+                const double expected = sipp::KmPerHour(table.interpolate(queries[i])).count();
+                ASSERT_NEAR(expected, results[i].count(), 1e-12 * expected) << size << " " << i;
+            }
+            // Breakpoints round-trip through meters: steep random segments amplify the rounding
+            for (std::size_t i = 0; i < size; ++i) {
+                ASSERT_NEAR(sipp::KmPerHour(values[i]).count(), results[i].count(), 1e-6);
+            }
+        }
+    }
+
+    // Single precision breakpoints take the portable path
+    const sipp::lookup_table<sipp::f32::Feet, sipp::f32::FeetPerMinute> climb{
+        {sipp::f32::Feet(0.0f), sipp::f32::FeetPerMinute(2000.0f)},
+        {sipp::f32::Feet(1000.0f), sipp::f32::FeetPerMinute(1000.0f)}};
+    const std::vector<sipp::Feet> altitudes{sipp::Feet(250.0), sipp::Feet(2000.0)};
+    std::vector<sipp::FeetPerMinute> rates(2);
+    climb.interpolate(sipp::span<const sipp::Feet>(altitudes), sipp::span<sipp::FeetPerMinute>(rates));
+    ASSERT_EQ(1750.0, rates[0].count());
+    ASSERT_EQ(1000.0, rates[1].count());
+}
+
+TEST_F(LookupTableTestFixture, TestKernels)
+{
+    std::mt19937_64 random(11);
+    std::vector<double> keys;
+    std::vector<double> values;
+    double key = 0.0;
+    for (std::size_t i = 0; i < 300; ++i) {
+        keys.push_back(key);
+        values.push_back(std::uniform_real_distribution<double>(-50.0, 50.0)(random));
+        key += std::uniform_real_distribution<double>(0.5, 2.0)(random);
+    }
+    std::vector<double> queries;
+    for (std::size_t i = 0; i < 1003; ++i) {
+        queries.push_back(std::uniform_real_distribution<double>(-10.0, key + 10.0)(random));
+    }
+    queries[0] = std::nan("");
+
+    std::vector<double> tree;
+    const unsigned depth = sipp::detail::eytzinger_tree(keys.data(), keys.size(), tree);
+    ASSERT_EQ(9u, depth);
+    for (const bool uniform : {false, true}) {
+        if (uniform) {
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                keys[i] = 0.25 * static_cast<double>(i);
+            }
+            sipp::detail::eytzinger_tree(keys.data(), keys.size(), tree);
+        }
+        const sipp::detail::lookup_data<double, double> table{keys.data(), values.data(), tree.data(), keys.size(),
+                                                             depth, uniform, 0.0, 4.0};
+        std::vector<double> expected(queries.size());
+        sipp::detail::lookup_portable(table, queries.data(), expected.data(), queries.size(), 0.5, 2.0);
+        ASSERT_TRUE(std::isnan(expected[0]));
+
+        const sipp::simd_isa isas[] = {sipp::simd_isa::avx2, sipp::simd_isa::avx512};
+        for (const auto isa : isas) {
+            if (static_cast<int>(isa) > static_cast<int>(sipp::active_simd_isa())) {
+                continue;
+            }
+            std::vector<double> actual(queries.size());
+            sipp::detail::select_lookup_kernel(isa)(table, queries.data(), actual.data(), queries.size(), 0.5, 2.0);
+            ASSERT_TRUE(std::isnan(actual[0]));
+            for (std::size_t i = 1; i < queries.size(); ++i) {
+                ASSERT_NEAR(expected[i], actual[i], 1e-12 * std::abs(expected[i]) + 1e-12) << i;
+            }
+        }
+    }
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <sipp/ordering.hpp>
+
+class OrderingTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(OrderingTestFixture, TestOrderKeysAcrossUnits)
+{
+    const sipp::Meters meters(1852.0);
+    const sipp::NauticalMiles miles(1.0);
+    const sipp::Feet feet(6076.0);
+
+    ASSERT_EQ(sipp::order_key(meters), sipp::order_key(miles));
+    ASSERT_LT(sipp::order_key(feet), sipp::order_key(miles));
+    ASSERT_LT(sipp::order_key(sipp::Kilometers(-2.0)), sipp::order_key(sipp::Meters(-1.0)));
+    ASSERT_LT(sipp::order_key(sipp::Meters(-0.5)), sipp::order_key(sipp::f32::Millimeters(0.0f)));
+    ASSERT_LT(sipp::order_key(sipp::Distance<int, std::milli>(-1)), sipp::order_key(sipp::Meters(0.0)));
+    ASSERT_LT(sipp::order_key(sipp::Knots(1.0)), sipp::order_key(sipp::MetersPerSecond(1.0)));
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> distribution(-1.0e6, 1.0e6);
+    for (int i = 0; i < 10000; ++i) {
+        const sipp::Feet a(distribution(generator));
+        const sipp::Kilometers b(distribution(generator) / 1000.0);
+        if (a < b) {
+            ASSERT_LE(sipp::order_key(a), sipp::order_key(b));
+        } else if (b < a) {
+            ASSERT_LE(sipp::order_key(b), sipp::order_key(a));
+        }
+    }
+}
+
+TEST_F(OrderingTestFixture, TestRadixSortMatchesStdSort)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1.0e5, 1.0e5);
+
+    std::vector<sipp::Feet> feet;
+    for (int i = 0; i < 5000; ++i) {
+        feet.emplace_back(distribution(generator));
+    }
+    feet.emplace_back(0.0);
+    feet.emplace_back(-0.0);
+    feet.emplace_back(std::numeric_limits<double>::infinity());
+    feet.emplace_back(-std::numeric_limits<double>::infinity());
+    auto expected = feet;
+    std::stable_sort(expected.begin(), expected.end());
+
+    sipp::radix_sort(sipp::span<sipp::Feet>(feet));
+    ASSERT_EQ(expected.size(), feet.size());
+    for (std::size_t i = 0; i < feet.size(); ++i) {
+        ASSERT_EQ(expected[i].count(), feet[i].count());
+    }
+
+    std::vector<sipp::f32::Knots> knots = {sipp::f32::Knots(3.0f), sipp::f32::Knots(-1.0f), sipp::f32::Knots(2.0f)};
+    sipp::radix_sort(sipp::span<sipp::f32::Knots>(knots));
+    ASSERT_EQ(-1.0f, knots[0].count());
+    ASSERT_EQ(3.0f, knots[2].count());
+
+    std::vector<sipp::Distance<std::int64_t, std::milli>> millimeters;
+    std::uniform_int_distribution<std::int64_t> integers(-1000000000000LL, 1000000000000LL);
+    for (int i = 0; i < 1000; ++i) {
+        millimeters.emplace_back(integers(generator));
+    }
+    auto expected_millimeters = millimeters;
+    std::sort(expected_millimeters.begin(), expected_millimeters.end());
+    sipp::radix_sort(sipp::span<sipp::Distance<std::int64_t, std::milli>>(millimeters));
+    ASSERT_EQ(expected_millimeters, millimeters);
+}
+
+TEST_F(OrderingTestFixture, TestRadixSortIsStable)
+{
+    std::vector<sipp::Meters> values(100, sipp::Meters(5.0));
+    values.emplace_back(-5.0);
+    sipp::radix_sort(sipp::span<sipp::Meters>(values));
+    ASSERT_EQ(-5.0, values.front().count());
+    ASSERT_EQ(5.0, values.back().count());
+
+    std::vector<sipp::Meters> empty;
+    sipp::radix_sort(sipp::span<sipp::Meters>(empty));
+    ASSERT_TRUE(empty.empty());
+}
+
+TEST_F(OrderingTestFixture, TestBoundsWithThresholdsInOtherUnits)
+{
+    std::vector<sipp::Meters> sorted;
+    for (int i = 0; i < 1000; ++i) {
+        sorted.emplace_back(static_cast<double>(i) * 10.0);
+    }
+    const sipp::span<const sipp::Meters> values(sorted);
+
+    for (double feet = -10.0; feet < 33000.0; feet += 17.3) {
+        const sipp::Feet threshold(feet);
+        const auto expected_lower = std::lower_bound(sorted.begin(), sorted.end(), threshold) - sorted.begin();
+        const auto expected_upper = std::upper_bound(sorted.begin(), sorted.end(), threshold) - sorted.begin();
+        ASSERT_EQ(static_cast<std::size_t>(expected_lower), sipp::lower_bound(values, threshold)) << feet;
+        ASSERT_EQ(static_cast<std::size_t>(expected_upper), sipp::upper_bound(values, threshold)) << feet;
+    }
+    ASSERT_EQ(1u, sipp::lower_bound(values, sipp::Kilometers(0.01)));
+    ASSERT_EQ(2u, sipp::upper_bound(values, sipp::Kilometers(0.01)));
+
+    std::vector<sipp::Distance<int, std::ratio<1>>> integers = {sipp::Distance<int, std::ratio<1>>(1),
+                                                                sipp::Distance<int, std::ratio<1>>(2),
+                                                                sipp::Distance<int, std::ratio<1>>(3)};
+    using IntMillimeters = sipp::Distance<int, std::milli>;
+    ASSERT_EQ(1u, sipp::lower_bound(sipp::span<sipp::Distance<int, std::ratio<1>>>(integers), IntMillimeters(1500)));
+    ASSERT_EQ(1u, sipp::lower_bound(sipp::span<sipp::Distance<int, std::ratio<1>>>(integers), IntMillimeters(2000)));
+    ASSERT_EQ(2u, sipp::upper_bound(sipp::span<sipp::Distance<int, std::ratio<1>>>(integers), IntMillimeters(2000)));
+    ASSERT_EQ(1u, sipp::upper_bound(sipp::span<sipp::Distance<int, std::ratio<1>>>(integers), IntMillimeters(1999)));
+    ASSERT_EQ(0u, sipp::lower_bound(sipp::span<const sipp::Meters>(), sipp::Feet(1.0)));
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <sipp/parse.hpp>
+
+class ParseTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(ParseTestFixture, TestParseEveryLiteralSuffix)
+{
+    using namespace sipp::literals;
+
+    ASSERT_EQ(12.5_m, sipp::parse<sipp::Meters>("12.5m").value);
+    ASSERT_EQ(12.5_km, sipp::parse<sipp::Kilometers>("12.5km").value);
+    ASSERT_EQ(12.5_mm, sipp::parse<sipp::Millimeters>("12.5mm").value);
+    ASSERT_EQ(12.5_um, sipp::parse<sipp::Micrometers>("12.5um").value);
+    ASSERT_EQ(12.5_nm, sipp::parse<sipp::Nanometers>("12.5nm").value);
+    ASSERT_EQ(12.5_ft, sipp::parse<sipp::Feet>("12.5_ft").value);
+    ASSERT_EQ(12.5_NM, sipp::parse<sipp::NauticalMiles>("12.5NM").value);
+    ASSERT_EQ(12.5_mi, sipp::parse<sipp::StatuteMiles>("12.5mi").value);
+
+    ASSERT_EQ(250.0_km_h, sipp::parse<sipp::KmPerHour>("250km_h").value);
+    ASSERT_EQ(250.0_km_h, sipp::parse<sipp::KmPerHour>("250 km/h").value);
+    ASSERT_EQ(250.0_m_s, sipp::parse<sipp::MetersPerSecond>("250m/s").value);
+    ASSERT_EQ(250.0_ft_s, sipp::parse<sipp::FeetPerSecond>("250_ft_s").value);
+    ASSERT_EQ(3000.0_ft_min, sipp::parse<sipp::FeetPerMinute>("3000ft/min").value);
+    ASSERT_EQ(250.0_kts, sipp::parse<sipp::Knots>("250 kts").value);
+    ASSERT_EQ(250.0_kts, sipp::parse<sipp::Knots>("250kt").value);
+    ASSERT_EQ(250.0_mph, sipp::parse<sipp::MilesPerHour>("250mph").value);
+}
+
+TEST_F(ParseTestFixture, TestParsedValueIsConvertedLikeCasts)
+{
+    const auto meters = sipp::parse<sipp::Meters>("  -3.75NM ");
+    ASSERT_TRUE(static_cast<bool>(meters));
+    ASSERT_EQ(sipp::distance_cast<sipp::Meters>(sipp::NauticalMiles(-3.75)).count(), meters.value.count());
+
+    const auto knots = sipp::parse<sipp::f32::Knots>("3000ft/min");
+    ASSERT_EQ(sipp::speed_cast<sipp::f32::Knots>(sipp::FeetPerMinute(3000.0)).count(), knots.value.count());
+
+    using IntMillimeters = sipp::Distance<std::int64_t, std::milli>;
+    ASSERT_EQ(12345, sipp::parse<IntMillimeters>("12.345m").value.count());
+}
+
+TEST_F(ParseTestFixture, TestNumbersAreCorrectlyRounded)
+{
+    const char *numbers[] = {"0.1", "1e22", "1e23", "123456789012345678901234567890", "2.2250738585072014e-308",
+                             "0.000000000000000000000000000001", "9007199254740993", "-0", "+7.25E+2",
+                             "3.141592653589793238462643383279"};
+    for (const char *number : numbers) {
+        const std::string text = std::string(number) + "m";
+        const auto parsed = sipp::parse<sipp::Meters>(text.c_str());
+        ASSERT_TRUE(static_cast<bool>(parsed)) << number;
+        ASSERT_EQ(std::strtod(number, nullptr), parsed.value.count()) << number;
+    }
+}
+
+TEST_F(ParseTestFixture, TestSlowPathIsExact)
+{
+    // 17 digits and exponents beyond the fast path, halfway cases, subnormals and overflow
+    const std::string numbers[] = {"0.30000000000000004", "1.7976931348623157e308", "1.7976931348623159e308",
+                                   "1e400", "4.9406564584124654e-324", "2.4703282292062327e-324",
+                                   "2.4703282292062328e-324", "1e-400", "8.98846567431158e307",
+                                   "1.00000000000000011102230246251565404236316680908203125",
+                                   "1.00000000000000011102230246251565404236316680908203125" + std::string(200, '0') + "1",
+                                   "0." + std::string(300, '0') + std::string(300, '3') + "e300"};
+    for (const auto &number : numbers) {
+        const auto parsed = sipp::parse<sipp::Meters>((number + "m").c_str());
+        ASSERT_TRUE(static_cast<bool>(parsed)) << number;
+        ASSERT_EQ(std::strtod(number.c_str(), nullptr), parsed.value.count()) << number;
+    }
+    ASSERT_EQ(0.1 + 0.2, sipp::parse<sipp::Meters>("0.30000000000000004m").value.count());
+
+    std::uint64_t state = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 10000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        double value = 0.0;
+        std::memcpy(&value, &state, sizeof(value));
+        if (!std::isfinite(value)) {
+            continue;
+        }
+        char text[40];
+        std::snprintf(text, sizeof(text), "%.17gm", value);
+        ASSERT_EQ(value, sipp::parse<sipp::Meters>(text).value.count()) << text;
+    }
+}
+
+TEST_F(ParseTestFixture, TestParseIgnoresLocale)
+{
+    const char *previous = std::setlocale(LC_NUMERIC, nullptr);
+    const std::string saved = previous != nullptr ? previous : "C";
+    if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8") == nullptr) {
+        std::setlocale(LC_NUMERIC, "C");
+    }
+
+    const auto fast = sipp::parse<sipp::Meters>("1.5km");
+    const auto slow = sipp::parse<sipp::Meters>("1.00000000000000000000001km");
+    std::setlocale(LC_NUMERIC, saved.c_str());
+
+    ASSERT_EQ(1500.0, fast.value.count());
+    ASSERT_EQ(1000.0, slow.value.count());
+}
+
+TEST_F(ParseTestFixture, TestParseErrors)
+{
+    ASSERT_EQ(sipp::parse_error::invalid_number, sipp::parse<sipp::Meters>("km").error);
+    ASSERT_EQ(sipp::parse_error::invalid_number, sipp::parse<sipp::Meters>("-.e5m").error);
+    ASSERT_EQ(sipp::parse_error::unknown_unit, sipp::parse<sipp::Meters>("12").error);
+    ASSERT_EQ(sipp::parse_error::unknown_unit, sipp::parse<sipp::Meters>("12 parsecs").error);
+    ASSERT_EQ(sipp::parse_error::unknown_unit, sipp::parse<sipp::Meters>("12km extra").error);
+    ASSERT_EQ(sipp::parse_error::dimension_mismatch, sipp::parse<sipp::Meters>("12kts").error);
+    ASSERT_EQ(sipp::parse_error::dimension_mismatch, sipp::parse<sipp::Knots>("12km").error);
+
+    const char text[] = "12.5km, 3ft";
+    sipp::Meters value(7.0);
+    const auto result = sipp::from_chars(text + 6, text + sizeof(text) - 1, value);
+    ASSERT_EQ(sipp::parse_error::invalid_number, result.error);
+    ASSERT_EQ(text + 6, result.ptr);
+    ASSERT_EQ(7.0, value.count());
+
+    const auto first = sipp::from_chars(text, text + sizeof(text) - 1, value);
+    ASSERT_EQ(sipp::parse_error::none, first.error);
+    ASSERT_EQ(text + 6, first.ptr);
+    ASSERT_EQ(12500.0, value.count());
+}
+
+TEST_F(ParseTestFixture, TestParseOutOfRange)
+{
+    ASSERT_EQ(sipp::parse_error::out_of_range, sipp::parse<sipp::Distance<int>>("1e30 m").error);
+    ASSERT_EQ(sipp::parse_error::out_of_range, sipp::parse<sipp::Distance<int>>("-1e30 m").error);
+    ASSERT_EQ(sipp::parse_error::out_of_range, sipp::parse<sipp::Distance<int>>("1e400 m").error);
+    ASSERT_EQ(sipp::parse_error::out_of_range, sipp::parse<sipp::Distance<int>>("2147483648 m").error);
+    ASSERT_EQ(sipp::parse_error::out_of_range, sipp::parse<sipp::Distance<int>>("2147484 km").error);
+    ASSERT_EQ(sipp::parse_error::out_of_range, sipp::parse<sipp::Distance<unsigned>>("-1 m").error);
+    ASSERT_EQ(sipp::parse_error::out_of_range,
+              sipp::parse<sipp::Distance<std::int64_t>>("9223372036854775808 m").error);
+
+    // the limits themselves, and values truncated into them, still parse
+    ASSERT_EQ(2147483647, sipp::parse<sipp::Distance<int>>("2147483647.9 m").value.count());
+    ASSERT_EQ(-2147483647 - 1, sipp::parse<sipp::Distance<int>>("-2147483648.9 m").value.count());
+    ASSERT_EQ(2147483647, sipp::parse<sipp::Distance<int>>("2147483.6479 km").value.count());
+    ASSERT_EQ(0u, sipp::parse<sipp::Distance<unsigned>>("-0.5 m").value.count());
+    ASSERT_EQ(std::numeric_limits<std::int64_t>::min(),
+              sipp::parse<sipp::Distance<std::int64_t>>("-9223372036854775808 m").value.count());
+
+    const char text[] = "1e30 m";
+    sipp::Distance<int> value(7);
+    const auto result = sipp::from_chars(text, text + sizeof(text) - 1, value);
+    ASSERT_EQ(text, result.ptr);
+    ASSERT_EQ(7, value.count());
+}
+
+TEST_F(ParseTestFixture, TestParseColumn)
+{
+    const std::string csv = "12.5km\n250 m\r\n\n1NM\n  3ft  \n";
+    std::vector<sipp::Meters> out(8);
+
+    const auto result = sipp::parse_column(csv.data(), csv.data() + csv.size(), sipp::span<sipp::Meters>(out));
+    ASSERT_EQ(sipp::parse_error::none, result.error);
+    ASSERT_EQ(4u, result.count);
+    ASSERT_EQ(csv.data() + csv.size(), result.ptr);
+    ASSERT_EQ(12500.0, out[0].count());
+    ASSERT_EQ(250.0, out[1].count());
+    ASSERT_EQ(1852.0, out[2].count());
+    ASSERT_EQ(sipp::Meters(sipp::Feet(3.0)).count(), out[3].count());
+
+    const std::string row = "1km;2km;x;4km";
+    const auto partial = sipp::parse_column(row.data(), row.data() + row.size(), sipp::span<sipp::Meters>(out), ';');
+    ASSERT_EQ(sipp::parse_error::invalid_number, partial.error);
+    ASSERT_EQ(2u, partial.count);
+    ASSERT_EQ(row.data() + 8, partial.ptr);
+
+    const auto limited = sipp::parse_column(csv.data(), csv.data() + csv.size(), sipp::span<sipp::Meters>(out.data(), 2));
+    ASSERT_EQ(2u, limited.count);
+}
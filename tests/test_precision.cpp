@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <sipp/batch.hpp>
+#include <sipp/precision.hpp>
+
+class PrecisionTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(PrecisionTestFixture, TestSinglePrecisionTypedefs)
+{
+    static_assert(sizeof(sipp::f32::Meters) == sizeof(float), "");
+    static_assert(std::is_same<sipp::f32::Knots::rep, float>::value, "");
+    static_assert(std::is_same<sipp::f32::Knots::distance_type, sipp::f32::NauticalMiles>::value, "");
+}
+
+TEST_F(PrecisionTestFixture, TestConversionStaysInSinglePrecision)
+{
+    for (float value : {0.1f, 1.0f, 3.3f, 12345.678f}) {
+        ASSERT_EQ(value * (381.0f / 1250.0f),
+                  sipp::distance_cast<sipp::f32::Meters>(sipp::f32::Feet(value)).count());
+        ASSERT_EQ(value * (463.0f / 250.0f),
+                  sipp::speed_cast<sipp::f32::KmPerHour>(sipp::f32::Knots(value)).count());
+    }
+}
+
+TEST_F(PrecisionTestFixture, TestMixedPrecisionArithmeticWidens)
+{
+    auto sum = sipp::f32::Meters(1.5f) + sipp::Kilometers(1.0);
+    static_assert(std::is_same<decltype(sum), sipp::Meters>::value, "");
+    ASSERT_EQ(1001.5, sum.count());
+}
+
+TEST_F(PrecisionTestFixture, TestBatchConvertSinglePrecision)
+{
+    std::vector<sipp::f32::Feet> feet;
+    for (int i = 0; i < 45; ++i) {
+        feet.emplace_back(static_cast<float>(i) * 100.5f);
+    }
+    std::vector<sipp::f32::Meters> meters(feet.size());
+
+    sipp::convert(sipp::span<const sipp::f32::Feet>(feet), sipp::span<sipp::f32::Meters>(meters));
+    for (std::size_t i = 0; i < feet.size(); ++i) {
+        ASSERT_EQ(sipp::distance_cast<sipp::f32::Meters>(feet[i]).count(), meters[i].count());
+    }
+}
+
+TEST_F(PrecisionTestFixture, TestAccumulateInDoublePrecision)
+{
+    // 0.1f is not representable, summing it 10^6 times in float drifts visibly
+    std::vector<sipp::f32::NauticalMiles> legs(1000000, sipp::f32::NauticalMiles(0.1f));
+
+    auto total = sipp::accumulate(sipp::span<const sipp::f32::NauticalMiles>(legs));
+    static_assert(std::is_same<decltype(total), sipp::NauticalMiles>::value, "");
+    ASSERT_NEAR(100000.0, total.count(), 0.01);
+
+    float naive = 0.0f;
+    for (const auto &leg : legs) {
+        naive += leg.count();
+    }
+    ASSERT_GT(std::abs(naive - 100000.0f), 1.0f);
+}
+
+TEST_F(PrecisionTestFixture, TestAccumulateSpeeds)
+{
+    std::vector<sipp::f32::Knots> speeds{sipp::f32::Knots(100.0f), sipp::f32::Knots(200.5f),
+                                         sipp::f32::Knots(50.25f)};
+
+    auto total = sipp::accumulate(speeds.data(), speeds.data() + speeds.size());
+    static_assert(std::is_same<decltype(total), sipp::Knots>::value, "");
+    ASSERT_EQ(350.75, total.count());
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <type_traits>
+
+#include <sipp/quantity.hpp>
+
+class QuantityTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(QuantityTestFixture, TestAccelerationFromSpeedAndDuration)
+{
+    const auto acceleration = sipp::Knots(180.0) / std::chrono::seconds(30);
+    static_assert(std::is_same<decltype(acceleration)::dimension, sipp::dimensions::acceleration>::value,
+                  "Speed divided by time must be an acceleration");
+
+    ASSERT_DOUBLE_EQ(6.0, sipp::quantity_cast<sipp::KnotsPerSecond>(acceleration).count());
+    ASSERT_DOUBLE_EQ(180.0 * 1852.0 / 3600.0 / 30.0,
+                     sipp::quantity_cast<sipp::MetersPerSecondSquared>(acceleration).count());
+
+    const sipp::StandardGravities load = sipp::MetersPerSecondSquared(9.80665 * 2.5);
+    ASSERT_DOUBLE_EQ(2.5, load.count());
+
+    // a (1 g) for t (10 s) gives v = 98.0665 m/s, integrated back through the operators
+    const sipp::MetersPerSecond speed = sipp::quantity_cast<sipp::MetersPerSecond>(
+        sipp::StandardGravities(1.0) * std::chrono::seconds(10));
+    ASSERT_DOUBLE_EQ(98.0665, speed.count());
+}
+
+TEST_F(QuantityTestFixture, TestAreaAndGradient)
+{
+    const sipp::SquareNauticalMiles area = sipp::NauticalMiles(3.0) * sipp::NauticalMiles(4.0);
+    ASSERT_DOUBLE_EQ(12.0, area.count());
+    ASSERT_DOUBLE_EQ(12.0 * 1.852 * 1.852, sipp::quantity_cast<sipp::SquareKilometers>(area).count());
+    ASSERT_DOUBLE_EQ(1.852, sipp::quantity_cast<sipp::SquareKilometers>(sipp::Kilometers(1.0) * sipp::NauticalMiles(1.0)).count());
+
+    const sipp::FeetPerNauticalMile gradient = sipp::Feet(318.0) / sipp::NauticalMiles(1.0);
+    ASSERT_DOUBLE_EQ(318.0, gradient.count());
+    ASSERT_NEAR(5.2336, sipp::quantity_cast<sipp::Percent>(gradient).count(), 1e-4);
+
+    using Ratio = sipp::Quantity<double, sipp::dimensions::dimensionless>;
+    const auto ratio = sipp::Kilometers(3.0) / sipp::Meters(1500.0);
+    ASSERT_DOUBLE_EQ(2.0, sipp::quantity_cast<Ratio>(ratio).count());
+}
+
+TEST_F(QuantityTestFixture, TestArithmeticAndComparison)
+{
+    constexpr auto sum = sipp::SquareMeters(1.0e6) + sipp::SquareKilometers(1.0);
+    static_assert(sum.count() == 2.0e6, "Sum must be in the common unit");
+    static_assert(sipp::SquareKilometers(1.0) == sipp::SquareMeters(1.0e6), "Equal areas");
+    static_assert(sipp::SquareKilometers(1.0) > sipp::SquareMeters(1.0), "Ordered areas");
+
+    sipp::Quantity<int, sipp::dimensions::area> square(4);
+    square += sipp::Quantity<int, sipp::dimensions::area, std::ratio<1>>(2);
+    square *= 3;
+    ASSERT_EQ(18, square.count());
+    ASSERT_EQ(9, (square / 2).count());
+    ASSERT_EQ(-18, (-square).count());
+    ASSERT_EQ(18, (-square).abs().count());
+    ASSERT_EQ(36, (2 * square).count());
+}
+
+TEST_F(QuantityTestFixture, TestInteroperabilityWithDistanceSpeedAndDuration)
+{
+    const sipp::Quantity<double, sipp::dimensions::length> length = sipp::NauticalMiles(1.0);
+    ASSERT_DOUBLE_EQ(1852.0, length.count());
+    ASSERT_DOUBLE_EQ(1.0, sipp::quantity_cast<sipp::NauticalMiles>(length).count());
+
+    const sipp::Seconds time = std::chrono::minutes(2);
+    ASSERT_DOUBLE_EQ(120.0, time.count());
+    ASSERT_EQ(2, sipp::quantity_cast<std::chrono::minutes>(time).count());
+
+    const auto distance = sipp::quantity_cast<sipp::Meters>(sipp::as_quantity(sipp::MetersPerSecond(5.0)) * time);
+    ASSERT_DOUBLE_EQ(600.0, distance.count());
+
+    const auto integral = sipp::quantity_cast<sipp::Quantity<int, sipp::dimensions::length>, sipp::rounding::to_nearest>(
+        sipp::Quantity<int, sipp::dimensions::length, std::kilo>(3) / 2);
+    ASSERT_EQ(1000, integral.count());
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <sipp/quantity_vector.hpp>
+
+using namespace sipp::literals;
+
+class QuantityVectorTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(QuantityVectorTestFixture, TestStoresRawCounts)
+{
+    sipp::quantity_vector<sipp::Meters> meters{1.0_m, 2.5_m, 1.0_km};
+
+    ASSERT_EQ(3u, meters.size());
+    ASSERT_EQ(1.0, meters.data()[0]);
+    ASSERT_EQ(2.5, meters.data()[1]);
+    ASSERT_EQ(1000.0, meters.data()[2]);
+    ASSERT_EQ(2.5_m, meters[1]);
+}
+
+TEST_F(QuantityVectorTestFixture, TestViewInOtherUnitDoesNotCopy)
+{
+    sipp::quantity_vector<sipp::Meters> meters{1.0_km, 1852.0_m};
+    auto nautical_miles = meters.as<sipp::NauticalMiles>();
+
+    ASSERT_EQ(meters.data(), nautical_miles.source_data());
+    ASSERT_FLOAT_EQ(1.0, nautical_miles[1].count());
+
+    meters.set(1, 3704.0_m);
+    ASSERT_FLOAT_EQ(2.0, nautical_miles[1].count());
+}
+
+TEST_F(QuantityVectorTestFixture, TestViewIteration)
+{
+    sipp::quantity_vector<sipp::Knots> knots{100.0_kts, 200.0_kts, 150.0_kts};
+    auto km_per_hour = knots.as<sipp::KmPerHour>();
+
+    auto maximum = *std::max_element(km_per_hour.begin(), km_per_hour.end());
+    ASSERT_FLOAT_EQ(370.4, maximum.count());
+    ASSERT_EQ(3, km_per_hour.end() - km_per_hour.begin());
+}
+
+TEST_F(QuantityVectorTestFixture, TestMaterializeMatchesCast)
+{
+    sipp::quantity_vector<sipp::Feet> feet;
+    for (int i = 0; i < 21; ++i) {
+        feet.push_back(sipp::Feet(i * 1000.0));
+    }
+
+    auto meters = feet.to<sipp::Meters>();
+    ASSERT_EQ(feet.size(), meters.size());
+    for (std::size_t i = 0; i < feet.size(); ++i) {
+        ASSERT_EQ(sipp::distance_cast<sipp::Meters>(feet[i]).count(), meters[i].count());
+    }
+}
+
+TEST_F(QuantityVectorTestFixture, TestBulkArithmetic)
+{
+    sipp::quantity_vector<sipp::Kilometers> kilometers{1.0_km, 2.0_km};
+    sipp::quantity_vector<sipp::Meters> meters{500.0_m, 250.0_m};
+
+    kilometers += meters;
+    ASSERT_FLOAT_EQ(1.5, kilometers[0].count());
+    ASSERT_FLOAT_EQ(2.25, kilometers[1].count());
+
+    kilometers -= meters.as<sipp::Feet>();
+    ASSERT_FLOAT_EQ(1.0, kilometers[0].count());
+
+    kilometers *= 4;
+    kilometers /= 2.0;
+    ASSERT_FLOAT_EQ(2.0, kilometers[0].count());
+    ASSERT_FLOAT_EQ(4.0, kilometers[1].count());
+}
+
+TEST_F(QuantityVectorTestFixture, TestArithmeticWithDifferentSizes)
+{
+    sipp::quantity_vector<sipp::Meters> meters{1.0_m, 2.0_m, 3.0_m};
+    const sipp::quantity_vector<sipp::Kilometers> shorter{1.0_km};
+
+    // Nothing is updated
+    ASSERT_THROW(meters += shorter, std::invalid_argument);
+    ASSERT_EQ(1.0, meters[0].count());
+    ASSERT_EQ(2.0, meters[1].count());
+    ASSERT_EQ(3.0, meters[2].count());
+
+    sipp::quantity_vector<sipp::Meters> single{5.0_m};
+    ASSERT_THROW(single -= meters, std::invalid_argument);
+    ASSERT_THROW(single -= meters.as<sipp::Feet>(), std::invalid_argument);
+    ASSERT_EQ(1u, single.size());
+    ASSERT_EQ(5.0, single[0].count());
+}
+
+TEST_F(QuantityVectorTestFixture, TestIteratorYieldsValues)
+{
+    using iterator = sipp::quantity_vector<sipp::Meters>::const_iterator;
+    static_assert(std::is_same<std::iterator_traits<iterator>::iterator_category, std::input_iterator_tag>::value,
+                  "Iterators returning values are input iterators");
+
+    const sipp::quantity_vector<sipp::Meters> meters{1.0_m, 2.0_m, 3.0_m};
+    const std::vector<sipp::Kilometers> kilometers(meters.as<sipp::Kilometers>().begin(),
+                                                   meters.as<sipp::Kilometers>().end());
+    ASSERT_EQ(3u, kilometers.size());
+    ASSERT_EQ(0.003, kilometers[2].count());
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <sipp/reduce.hpp>
+
+class ReduceTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(ReduceTestFixture, TestCompensatedSum)
+{
+    // 0.1 is not representable: a running total drifts, the compensated sum does not
+    std::vector<sipp::NauticalMiles> legs(10000003, sipp::NauticalMiles(0.1));
+
+    const auto total = sipp::sum(sipp::span<const sipp::NauticalMiles>(legs));
+    static_assert(std::is_same<decltype(total), const sipp::NauticalMiles>::value, "");
+    ASSERT_DOUBLE_EQ(1000000.3, total.count());
+
+    sipp::NauticalMiles naive(0.0);
+    for (const auto &leg : legs) {
+        naive += leg;
+    }
+    ASSERT_GT(std::abs(naive.count() - 1000000.3), 1e-6);
+
+    const auto parallel = sipp::sum(sipp::execution::parallel_policy{4}, sipp::span<sipp::NauticalMiles>(legs));
+    ASSERT_EQ(total.count(), parallel.count());
+
+    std::vector<sipp::f32::Knots> speeds{sipp::f32::Knots(100.0f), sipp::f32::Knots(200.5f)};
+    static_assert(std::is_same<decltype(sipp::sum(sipp::span<sipp::f32::Knots>(speeds))), sipp::Knots>::value, "");
+    ASSERT_EQ(300.5, sipp::sum(sipp::span<sipp::f32::Knots>(speeds)).count());
+
+    std::vector<sipp::Distance<std::int64_t>> integral(100000, sipp::Distance<std::int64_t>(3));
+    ASSERT_EQ(300000, sipp::sum(sipp::execution::par, sipp::span<sipp::Distance<std::int64_t>>(integral)).count());
+    ASSERT_EQ(0.0, sipp::sum(sipp::span<sipp::Meters>()).count());
+}
+
+TEST_F(ReduceTestFixture, TestSummarize)
+{
+    std::vector<sipp::Knots> speeds;
+    for (int i = 0; i < 100001; ++i) {
+        speeds.emplace_back(250.0 + static_cast<double>(i % 101) - 50.0);
+    }
+
+    const auto summary = sipp::summarize(sipp::execution::par, sipp::span<const sipp::Knots>(speeds));
+    ASSERT_EQ(speeds.size(), summary.count);
+    ASSERT_EQ(200.0, summary.min.count());
+    ASSERT_EQ(300.0, summary.max.count());
+
+    double mean = 0.0;
+    for (const auto &speed : speeds) {
+        mean += speed.count();
+    }
+    mean /= static_cast<double>(speeds.size());
+    double variance = 0.0;
+    for (const auto &speed : speeds) {
+        variance += (speed.count() - mean) * (speed.count() - mean);
+    }
+    variance /= static_cast<double>(speeds.size());
+
+    ASSERT_NEAR(mean, summary.mean.count(), 1e-9);
+    ASSERT_NEAR(variance, summary.variance.count(), 1e-6);
+    ASSERT_NEAR(std::sqrt(variance), summary.stddev().count(), 1e-9);
+
+    // variance is a typed quantity: knots squared
+    static_assert(std::is_same<decltype(summary.variance)::dimension,
+                               sipp::dimension_multiply<sipp::dimensions::velocity,
+                                                        sipp::dimensions::velocity>>::value, "");
+    const auto sequential = sipp::summarize(sipp::span<const sipp::Knots>(speeds));
+    ASSERT_EQ(sequential.variance.count(), summary.variance.count());
+
+    // mean of integral counts is not truncated
+    std::vector<sipp::Distance<int>> integral{sipp::Distance<int>(1), sipp::Distance<int>(2)};
+    const auto integral_summary = sipp::summarize(sipp::span<sipp::Distance<int>>(integral));
+    ASSERT_EQ(1.5, integral_summary.mean.count());
+    ASSERT_EQ(0.25, integral_summary.variance.count());
+
+    const auto empty = sipp::summarize(sipp::span<sipp::Meters>());
+    ASSERT_EQ(0u, empty.count);
+    ASSERT_EQ(0.0, empty.mean.count());
+
+    // NaNs are skipped, as by quantile, also at the start of a chunk
+    std::vector<sipp::Knots> gaps(2 * sipp::detail::reduce_chunk_size, sipp::Knots(std::nan("")));
+    gaps[5] = sipp::Knots(100.0);
+    gaps[sipp::detail::reduce_chunk_size + 7] = sipp::Knots(300.0);
+    const auto skipped = sipp::summarize(sipp::execution::par, sipp::span<const sipp::Knots>(gaps));
+    ASSERT_EQ(2u, skipped.count);
+    ASSERT_EQ(100.0, skipped.min.count());
+    ASSERT_EQ(300.0, skipped.max.count());
+    ASSERT_EQ(200.0, skipped.mean.count());
+    ASSERT_EQ(10000.0, skipped.variance.count());
+    const std::vector<sipp::Knots> missing(3, sipp::Knots(std::nan("")));
+    const auto none = sipp::summarize(sipp::span<const sipp::Knots>(missing));
+    ASSERT_EQ(0u, none.count);
+    ASSERT_TRUE(std::isnan(none.min.count()));
+    ASSERT_TRUE(std::isnan(none.mean.count()));
+}
+
+TEST_F(ReduceTestFixture, TestQuantile)
+{
+    std::vector<sipp::Feet> altitudes;
+    for (int i = 0; i <= 100000; ++i) {
+        altitudes.emplace_back(static_cast<double>(i) * 0.41);
+    }
+    const sipp::span<const sipp::Feet> values(altitudes);
+    const double tolerance = 41000.0 / 4096.0;
+
+    ASSERT_NEAR(20500.0, sipp::quantile(values, 0.5).count(), tolerance);
+    ASSERT_NEAR(36900.0, sipp::quantile(sipp::execution::par, values, 0.9).count(), tolerance);
+    ASSERT_LT(sipp::quantile(values, 0.0).count(), tolerance);
+    ASSERT_LE(sipp::quantile(values, 1.0).count(), 41000.0);
+    ASSERT_EQ(sipp::quantile(values, 0.25).count(), sipp::quantile(sipp::execution::par, values, 0.25).count());
+
+    std::vector<sipp::Feet> constant(10, sipp::Feet(5.0));
+    ASSERT_EQ(5.0, sipp::quantile(sipp::span<sipp::Feet>(constant), 0.3).count());
+    ASSERT_EQ(0.0, sipp::quantile(sipp::span<sipp::Feet>(), 0.5).count());
+
+    // NaNs are skipped, in every chunk and at the first position of one
+    std::vector<sipp::Feet> gaps(altitudes.begin(), altitudes.end());
+    for (std::size_t i = 0; i < gaps.size(); i += 3) {
+        gaps.insert(gaps.begin() + static_cast<std::ptrdiff_t>(i), sipp::Feet(std::nan("")));
+    }
+    gaps[1 << 14] = sipp::Feet(std::nan(""));
+    ASSERT_NEAR(20500.0, sipp::quantile(sipp::span<const sipp::Feet>(gaps), 0.5).count(), 2.0 * tolerance);
+    ASSERT_LE(sipp::quantile(sipp::execution::par, sipp::span<const sipp::Feet>(gaps), 1.0).count(), 41000.0);
+    std::vector<sipp::Feet> missing(5, sipp::Feet(std::nan("")));
+    ASSERT_TRUE(std::isnan(sipp::quantile(sipp::span<sipp::Feet>(missing), 0.5).count()));
+    missing[2] = sipp::Feet(7.0);
+    ASSERT_EQ(7.0, sipp::quantile(sipp::span<sipp::Feet>(missing), 0.5).count());
+}
+
+TEST_F(ReduceTestFixture, TestSparseQuantile)
+{
+    // Order statistics in different bins are interpolated, values alone in a bin are exact
+    const std::vector<sipp::Knots> two = {sipp::Knots(100.0), sipp::Knots(200.0)};
+    ASSERT_EQ(150.0, sipp::quantile(sipp::span<const sipp::Knots>(two), 0.5).count());
+    const std::vector<sipp::Meters> three = {sipp::Meters(0.0), sipp::Meters(10.0), sipp::Meters(1000.0)};
+    ASSERT_EQ(5.0, sipp::quantile(sipp::span<const sipp::Meters>(three), 0.25).count());
+    ASSERT_EQ(505.0, sipp::quantile(sipp::span<const sipp::Meters>(three), 0.75).count());
+    const std::vector<sipp::Distance<int>> integral = {sipp::Distance<int>(3), sipp::Distance<int>(-7)};
+    ASSERT_EQ(-2.0, sipp::quantile(sipp::span<const sipp::Distance<int>>(integral), 0.5).count());
+
+    // Two clusters of 50000 values, [0, 1) and [1000, 1001): the median falls between them,
+    // halfway from the largest of the first (0.99998) to the smallest of the second
+    std::vector<sipp::Feet> bimodal;
+    for (int i = 0; i < 50000; ++i) {
+        bimodal.emplace_back(static_cast<double>(i) / 50000.0);
+        bimodal.emplace_back(1000.0 + static_cast<double>(i) / 50000.0);
+    }
+    const sipp::span<const sipp::Feet> clusters(bimodal);
+    const double tolerance = 1001.0 / 4096.0;
+    ASSERT_NEAR(500.49999, sipp::quantile(clusters, 0.5).count(), tolerance);
+    ASSERT_NEAR(500.49999, sipp::quantile(sipp::execution::par, clusters, 0.5).count(), tolerance);
+    ASSERT_NEAR(0.5, sipp::quantile(clusters, 0.25).count(), tolerance);
+    ASSERT_NEAR(1000.8, sipp::quantile(clusters, 0.9).count(), tolerance);
+
+    // Infinities are the extreme order statistics, outside the histogram range
+    const double infinity = std::numeric_limits<double>::infinity();
+    const std::vector<sipp::Meters> unbounded = {sipp::Meters(-infinity), sipp::Meters(1.0), sipp::Meters(2.0),
+                                                 sipp::Meters(3.0)};
+    const sipp::span<const sipp::Meters> ends(unbounded);
+    ASSERT_EQ(1.5, sipp::quantile(ends, 0.5).count());
+    ASSERT_EQ(-infinity, sipp::quantile(ends, 0.0).count());
+    ASSERT_EQ(-infinity, sipp::quantile(ends, 0.2).count());
+    ASSERT_EQ(3.0, sipp::quantile(ends, 1.0).count());
+    const std::vector<sipp::Meters> both = {sipp::Meters(-infinity), sipp::Meters(infinity)};
+    ASSERT_TRUE(std::isnan(sipp::quantile(sipp::span<const sipp::Meters>(both), 0.5).count()));
+    ASSERT_EQ(infinity, sipp::quantile(sipp::span<const sipp::Meters>(both), 1.0).count());
+
+    // Finite extrema of opposite signs do not overflow the range
+    const double largest = std::numeric_limits<double>::max();
+    const std::vector<sipp::Meters> extreme = {sipp::Meters(-largest), sipp::Meters(0.0), sipp::Meters(largest)};
+    ASSERT_EQ(0.0, sipp::quantile(sipp::span<const sipp::Meters>(extreme), 0.5).count());
+}
+
+TEST_F(ReduceTestFixture, TestExceptionJoinsWorkers)
+{
+    const std::size_t count = 64 * sipp::detail::reduce_chunk_size;
+    std::atomic<std::size_t> visited(0);
+    const auto fail_at_chunk = [&](std::size_t, std::size_t chunk, std::size_t, std::size_t) {
+        ++visited;
+        if (chunk == 5) {
+            throw std::runtime_error("chunk");
+        }
+    };
+    ASSERT_THROW(sipp::detail::for_each_chunk(count, 4, fail_at_chunk), std::runtime_error);
+    ASSERT_LE(visited.load(), 64u);
+    visited = 0;
+    ASSERT_THROW(sipp::detail::for_each_chunk(count, 1, fail_at_chunk), std::runtime_error);
+    ASSERT_EQ(6u, visited.load());
+}
@@ -33,6 +33,31 @@ TEST_F(SpeedTestFixture, TestKmhToMPH)
     ASSERT_FLOAT_EQ(miles_per_hour.count(), 559.23547);
 }
 
+TEST_F(SpeedTestFixture, TestIdentityConversionKeepsValue)
+{
+    sipp::Knots knots(0.1);
+    auto same = sipp::speed_cast<sipp::Knots>(knots);
+    ASSERT_EQ(knots.count(), same.count());
+}
+
+TEST_F(SpeedTestFixture, TestConversionIsSingleMultiplication)
+{
+    // Knots -> km/h is folded into 463/250, ft/min -> m/s into 127/25000
+    for (double value : {0.1, 1.0, 3.3, 12345.678, -98765.4321}) {
+        ASSERT_EQ(value * (463.0 / 250.0), sipp::speed_cast<sipp::KmPerHour>(sipp::Knots(value)).count());
+        ASSERT_EQ(value * (127.0 / 25000.0),
+                  sipp::speed_cast<sipp::MetersPerSecond>(sipp::FeetPerMinute(value)).count());
+    }
+}
+
+TEST_F(SpeedTestFixture, TestExplicitIntegerConversionIsExact)
+{
+    sipp::Speed<int, sipp::Distance<int, std::milli>, sipp::SecondRatio> mm_per_second(5000);
+    auto m_per_hour =
+        sipp::speed_cast<sipp::Speed<int, sipp::Distance<int>, sipp::HourRatio>>(mm_per_second);
+    ASSERT_EQ(18000, m_per_hour.count());
+}
+
 TEST_F(SpeedTestFixture, TestMultiplySpeedWithScalar)
 {
     auto spd = 900.0_km_h;
@@ -157,3 +182,57 @@ TEST_F(SpeedTestFixture, TestDivideDistanceBySpeed)
     auto t = S / V;
     ASSERT_EQ(600s, std::chrono::duration_cast<std::chrono::seconds>(t)) << t.count();
 }
+
+TEST_F(SpeedTestFixture, TestCommonType)
+{
+    using common = std::common_type<sipp::Knots, sipp::MetersPerSecond>::type;
+    static_assert(std::is_same<common::distance_type, sipp::Meters>::value, "");
+    static_assert(std::is_same<common::ratio, sipp::HourRatio>::value, "");
+    static_assert(std::is_same<std::common_type<sipp::Knots, sipp::Knots>::type, sipp::Knots>::value,
+                  "");
+
+    auto sum = 1.0_kts + 1.0_m_s;
+    ASSERT_FLOAT_EQ(1852.0 + 3600.0, sum.count());
+}
+
+TEST_F(SpeedTestFixture, TestMixedIntegerArithmetic)
+{
+    using MetersPerMinute = sipp::Speed<int, sipp::Distance<int>, sipp::MinuteRatio>;
+    using MetersPerSecondInt = sipp::Speed<int, sipp::Distance<int>, sipp::SecondRatio>;
+
+    auto sum = MetersPerSecondInt(2) + MetersPerMinute(30);
+    static_assert(std::is_same<decltype(sum), MetersPerMinute>::value, "");
+    ASSERT_EQ(150, sum.count());
+    ASSERT_LT(MetersPerMinute(119), MetersPerSecondInt(2));
+    ASSERT_NE(MetersPerMinute(119), MetersPerSecondInt(2));
+}
+
+TEST_F(SpeedTestFixture, TestIntegerSpeedRounding)
+{
+    using MillimetersPerSecond = sipp::Speed<int, sipp::Distance<int, std::milli>, sipp::SecondRatio>;
+    using MetersPerSecondInt = sipp::Speed<int, sipp::Distance<int>, sipp::SecondRatio>;
+
+    ASSERT_EQ(1, sipp::floor<MetersPerSecondInt>(MillimetersPerSecond(1999)).count());
+    ASSERT_EQ(2, sipp::round<MetersPerSecondInt>(MillimetersPerSecond(1999)).count());
+    ASSERT_EQ(2, sipp::ceil<MetersPerSecondInt>(MillimetersPerSecond(1001)).count());
+}
+
+TEST_F(SpeedTestFixture, TestIntegerSpeedMultiplyByTime)
+{
+    using MillimetersPerSecond =
+        sipp::Speed<std::int64_t, sipp::Distance<std::int64_t, std::milli>, sipp::SecondRatio>;
+
+    auto distance = MillimetersPerSecond(1500) * std::chrono::minutes(3);
+    static_assert(std::is_same<decltype(distance), sipp::Distance<std::int64_t, std::milli>>::value, "");
+    ASSERT_EQ(270000, distance.count());
+}
+
+TEST_F(SpeedTestFixture, TestIntegerDistanceDividedBySpeed)
+{
+    using MillimetersPerSecond =
+        sipp::Speed<std::int64_t, sipp::Distance<std::int64_t, std::milli>, sipp::SecondRatio>;
+
+    auto time = sipp::Distance<std::int64_t>(100) / MillimetersPerSecond(2500);
+    static_assert(std::is_same<decltype(time), std::chrono::duration<std::int64_t>>::value, "");
+    ASSERT_EQ(40, time.count());
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <type_traits>
+#include <utility>
+
+#include <sipp/strict.hpp>
+
+namespace {
+
+template<class...>
+struct void_type {
+    using type = void;
+};
+
+template<class T, class U, class = void>
+struct can_add : std::false_type {};
+
+template<class T, class U>
+struct can_add<T, U, typename void_type<decltype(std::declval<T>() + std::declval<U>())>::type>
+    : std::true_type {};
+
+template<class T, class U, class = void>
+struct can_compare : std::false_type {};
+
+template<class T, class U>
+struct can_compare<T, U, typename void_type<decltype(std::declval<T>() < std::declval<U>())>::type>
+    : std::true_type {};
+
+}
+
+class StrictTestFixture : public ::testing::Test {
+
+};
+
+TEST_F(StrictTestFixture, TestNoImplicitConversions)
+{
+    // Between strict units
+    static_assert(!std::is_constructible<sipp::strict::Meters, sipp::strict::Feet>::value, "");
+    static_assert(!std::is_convertible<sipp::strict::Meters, sipp::strict::Feet>::value, "");
+    static_assert(!std::is_assignable<sipp::strict::Meters &, sipp::strict::Kilometers>::value, "");
+    static_assert(!can_add<sipp::strict::Meters, sipp::strict::Feet>::value, "");
+    static_assert(!can_compare<sipp::strict::Knots, sipp::strict::KmPerHour>::value, "");
+    static_assert(!can_compare<sipp::strict::Degrees, sipp::strict::Radians>::value, "");
+
+    // Between strict and ordinary quantities, except for the same unit explicitly
+    static_assert(!std::is_constructible<sipp::strict::Meters, sipp::Feet>::value, "");
+    static_assert(!std::is_convertible<sipp::Meters, sipp::strict::Meters>::value, "");
+    static_assert(std::is_constructible<sipp::strict::Meters, sipp::Meters>::value, "");
+    static_assert(!std::is_assignable<sipp::strict::Meters &, sipp::Meters>::value, "");
+    static_assert(!can_add<sipp::strict::Meters, sipp::Meters>::value, "");
+    static_assert(!can_compare<sipp::strict::Meters, sipp::Meters>::value, "");
+    static_assert(!std::is_convertible<double, sipp::strict::Meters>::value, "");
+
+    // The ordinary types still convert
+    static_assert(can_add<sipp::Meters, sipp::Feet>::value, "");
+    static_assert(std::is_convertible<sipp::Meters, sipp::Feet>::value, "");
+}
+
+TEST_F(StrictTestFixture, TestSameUnitArithmetic)
+{
+    constexpr sipp::strict::NauticalMiles leg(12.0);
+    static_assert((leg + leg).count() == 24.0, "");
+    static_assert((leg - sipp::strict::NauticalMiles(2.0)) * 2.0 == sipp::strict::NauticalMiles(20.0), "");
+    static_assert(leg / sipp::strict::NauticalMiles(4.0) == 3.0, "");
+    static_assert(leg > sipp::strict::NauticalMiles(11.0), "");
+
+    sipp::strict::NauticalMiles total;
+    ASSERT_EQ(0.0, total.count());
+    total += leg;
+    total += leg / 2.0;
+    total -= sipp::strict::NauticalMiles(1.0);
+    total *= 2.0;
+    total /= 4.0;
+    ASSERT_EQ(8.5, total.count());
+    ASSERT_EQ(-8.5, (-total).count());
+    ASSERT_TRUE(total != leg);
+    ASSERT_TRUE(total <= leg && leg >= total && total < leg);
+}
+
+TEST_F(StrictTestFixture, TestExplicitBoundary)
+{
+    const sipp::strict::Feet altitude(sipp::Feet(3280.84));
+
+    // Converted inside the strict types
+    const auto meters = sipp::strict::quantity_cast<sipp::strict::Meters>(altitude);
+    static_assert(std::is_same<decltype(meters), const sipp::strict::Meters>::value, "");
+    ASSERT_NEAR(1000.0, meters.count(), 1e-3);
+    ASSERT_EQ(1000, (sipp::strict::quantity_cast<sipp::strict::unit<sipp::Distance<int>>, sipp::rounding::to_nearest>(
+                          altitude).count()));
+
+    // Converted outside, then wrapped again
+    const sipp::Kilometers km = altitude.quantity();
+    ASSERT_NEAR(1.0, km.count(), 1e-6);
+    const auto wrapped = sipp::strict::make_strict(km);
+    static_assert(std::is_same<decltype(wrapped), const sipp::strict::Kilometers>::value, "");
+
+    const sipp::strict::Knots speed(sipp::Knots(250.0));
+    ASSERT_NEAR(463.0, sipp::strict::quantity_cast<sipp::strict::KmPerHour>(speed).count(), 1e-9);
+    ASSERT_EQ(180.0, sipp::strict::quantity_cast<sipp::strict::Degrees>(sipp::strict::Turns(0.5)).count());
+}
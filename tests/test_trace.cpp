@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <thread>
+
+#include <sipp/angle.hpp>
+
+// Built twice: into sipp_tests without SIPP_TRACE_CONVERSIONS and into sipp_trace_tests with it
+
+#ifdef SIPP_TRACE_CONVERSIONS
+
+class TraceTestFixture : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        sipp::reset_conversion_counts();
+    }
+};
+
+TEST_F(TraceTestFixture, TestCountsPerPair)
+{
+    const sipp::Kilometers leg(3.048);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_NEAR(10000.0, sipp::distance_cast<sipp::Feet>(leg).count(), 1e-9);
+    }
+    const sipp::Feet implicit = leg;
+    ASSERT_NEAR(10000.0, implicit.count(), 1e-9);
+    ASSERT_NEAR(100.008, sipp::speed_cast<sipp::KmPerHour>(sipp::Knots(54.0)).count(), 1e-9);
+    ASSERT_EQ(180.0, sipp::angle_cast<sipp::Degrees>(sipp::Turns(0.5)).count());
+    ASSERT_EQ(5, sipp::distance_cast<sipp::Distance<int>>(sipp::Millimeters(5000.0)).count());
+    // Casts into the same type convert nothing
+    ASSERT_EQ(3.048, sipp::distance_cast<sipp::Kilometers>(leg).count());
+
+    const auto counts = sipp::thread_conversion_counts();
+    ASSERT_EQ(4u, counts.size());
+    ASSERT_EQ("Kilometers", counts[0].from);
+    ASSERT_EQ("Feet", counts[0].to);
+    ASSERT_EQ(4u, counts[0].count);
+    ASSERT_EQ("Millimeters", counts[3].from);
+    ASSERT_EQ("integer32 m^1 kg^0 s^0 rad^0 x 1/1", counts[3].to);
+
+    std::ostringstream csv;
+    sipp::write_conversion_counts(csv);
+    ASSERT_EQ(0u, csv.str().find("from,to,count\nKilometers,Feet,4\n"));
+
+    sipp::reset_conversion_counts();
+    ASSERT_TRUE(sipp::conversion_counts().empty());
+}
+
+TEST_F(TraceTestFixture, TestThreadCounts)
+{
+    std::thread worker([] {
+        for (int i = 0; i < 5; ++i) {
+            sipp::NauticalMiles(1.0) + sipp::Meters(1.0);
+        }
+        ASSERT_EQ(1u, sipp::thread_conversion_counts().size());
+    });
+    worker.join();
+    sipp::distance_cast<sipp::f32::Feet>(sipp::Meters(1.0));
+
+    const auto own = sipp::thread_conversion_counts();
+    ASSERT_EQ(1u, own.size());
+    ASSERT_EQ("Meters", own[0].from);
+    ASSERT_EQ("f32::Feet", own[0].to);
+
+    // The worker's counts are merged when it exits
+    const auto all = sipp::conversion_counts();
+    ASSERT_EQ(2u, all.size());
+    ASSERT_EQ("NauticalMiles", all[0].from);
+    ASSERT_EQ(5u, all[0].count);
+}
+
+TEST_F(TraceTestFixture, TestCompileTimeCasts)
+{
+    constexpr auto feet = sipp::distance_cast<sipp::Feet>(sipp::Meters(3.048));
+    static_assert(feet.count() > 9.99 && feet.count() < 10.01, "");
+    ASSERT_TRUE(sipp::thread_conversion_counts().empty());
+}
+
+#else
+
+class TraceTestFixture : public ::testing::Test {
+
+};
+
+// Without the define the casts are unchanged and the counters are not compiled in
+TEST_F(TraceTestFixture, TestDisabled)
+{
+    using IntegerFeet = sipp::Distance<int, std::ratio<3048, 10000>>;
+    ASSERT_EQ(3281, sipp::round<IntegerFeet>(sipp::Kilometers(1.0)).count());
+    ASSERT_DOUBLE_EQ(10000.0, sipp::distance_cast<sipp::Feet>(sipp::Meters(3048.0)).count());
+}
+
+#endif
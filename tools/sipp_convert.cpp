@@ -0,0 +1,534 @@
+// sipp-convert: converts the quantities of a text file into another unit, e.g.
+//
+//   sipp-convert --from ft --to m altitudes.txt > altitudes_m.txt
+//   sipp-convert --to km/h --column 3 --header tracks.csv -o tracks_kmh.csv
+//
+// Input is one value per line, or delimited lines of which one column is converted and the
+// others copied. Values may carry their own unit suffix ("12.5NM"); bare numbers take the
+// --from unit. Units are the suffixes of sipp::literals and sipp::parse.
+//
+// Regular files are memory mapped (stdin and pipes are read in large blocks), cut into
+// chunks on line boundaries and parsed, converted and formatted by a pool of threads.
+// Chunks are written in input order; at most a fixed number of them are in flight, so
+// memory use does not depend on the input size.
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <sipp/dynamic.hpp>
+#include <sipp/internals/mapped_file.hpp>
+
+namespace {
+
+const std::size_t chunk_size = std::size_t(4) << 20;
+
+const char usage[] =
+    "usage: sipp-convert --to UNIT [--from UNIT] [--column N] [--delimiter C] [--header]\n"
+    "                    [--bare] [--threads N] [-o OUTPUT] [INPUT]\n"
+    "\n"
+    "Converts every value of INPUT (stdin if absent or -) into UNIT, one value per line\n"
+    "or column N (1-based) of lines delimited by C (default ','). Values without a unit\n"
+    "suffix are read in the --from unit. --header copies the first line unchanged, --bare\n"
+    "writes numbers without the unit suffix.\n";
+
+struct options {
+    const char *to = nullptr;
+    const char *from = nullptr;
+    const char *input = nullptr;
+    const char *output = nullptr;
+    std::size_t column = 1;
+    char delimiter = ',';
+    bool header = false;
+    bool bare = false;
+    unsigned threads = 0;
+};
+
+// Slice of the input, owning its bytes when they were read from a stream
+struct chunk {
+    std::vector<char> storage;
+    const char *first = nullptr;
+    const char *last = nullptr;
+    std::string output;
+    std::size_t lines = 0;
+    // line (within the chunk) and message of the first error, if any
+    std::size_t error_line = 0;
+    const char *error = nullptr;
+    // message of an exception thrown while converting, error points into it
+    std::string failure;
+    bool ready = false;
+};
+
+template<class UnitId>
+struct unit_pair {
+    UnitId to;
+    UnitId from;
+    bool has_from;
+};
+
+template<class UnitId>
+bool find_unit(const char *name, UnitId &unit)
+{
+    sipp::dynamic_quantity<UnitId> value;
+    const std::string text = std::string("1") + name;
+    const auto parsed = sipp::from_chars(text.data(), text.data() + text.size(), value);
+    if (parsed.error != sipp::parse_error::none || parsed.ptr != text.data() + text.size()) {
+        return false;
+    }
+    unit = value.unit();
+    return true;
+}
+
+const char *describe(sipp::parse_error error)
+{
+    switch (error) {
+        case sipp::parse_error::invalid_number:
+            return "invalid number";
+        case sipp::parse_error::unknown_unit:
+            return "unknown unit";
+        case sipp::parse_error::dimension_mismatch:
+            return "unit of another dimension";
+        case sipp::parse_error::out_of_range:
+            return "value out of range";
+        default:
+            return "no error";
+    }
+}
+
+// Converts the field [first, last) and appends it to out, returns nullptr or an error
+template<class UnitId>
+const char *convert_field(const char *first, const char *last, const unit_pair<UnitId> &units, bool bare,
+                          std::string &out)
+{
+    first = sipp::detail::skip_spaces(first, last);
+    while (last != first && sipp::detail::is_space(last[-1])) {
+        --last;
+    }
+
+    sipp::dynamic_quantity<UnitId> value;
+    double count = 0.0;
+    const char *number_end = sipp::detail::parse_decimal(first, last, count);
+    if (number_end != nullptr && sipp::detail::skip_spaces(number_end, last) == last) {
+        if (!units.has_from) {
+            return "value without unit, give --from";
+        }
+        value = sipp::dynamic_quantity<UnitId>(count, units.from);
+    } else {
+        const auto parsed = sipp::from_chars(first, last, value);
+        if (parsed.error != sipp::parse_error::none) {
+            return describe(parsed.error);
+        }
+        if (parsed.ptr != last) {
+            return describe(sipp::parse_error::unknown_unit);
+        }
+    }
+
+    char buffer[sipp::max_formatted_size];
+    const auto converted = value.in(units.to);
+    const char *end = bare ? sipp::detail::write_floating(buffer, buffer + sizeof(buffer), converted.count())
+                           : sipp::to_chars(buffer, buffer + sizeof(buffer), converted).ptr;
+    out.append(buffer, static_cast<std::size_t>(end - buffer));
+    return nullptr;
+}
+
+template<class UnitId>
+void convert_chunk(chunk &work, const unit_pair<UnitId> &units, const options &settings)
+{
+    work.output.clear();
+    const auto size = static_cast<std::size_t>(work.last - work.first);
+    work.output.reserve(size + size / 2);
+    work.lines = 0;
+    work.error = nullptr;
+
+    const char *line = work.first;
+    while (line != work.last) {
+        const char *line_end = static_cast<const char *>(
+            std::memchr(line, '\n', static_cast<std::size_t>(work.last - line)));
+        line_end = line_end != nullptr ? line_end : work.last;
+        const char *content_end = line_end != line && line_end[-1] == '\r' ? line_end - 1 : line_end;
+
+        if (sipp::detail::skip_spaces(line, content_end) == content_end) {
+            // blank lines are kept as they are
+            work.output.append(line, content_end);
+        } else {
+            const char *field = line;
+            for (std::size_t column = 1; column < settings.column && field != content_end; ++column) {
+                const void *delimiter = std::memchr(field, settings.delimiter,
+                                                    static_cast<std::size_t>(content_end - field));
+                field = delimiter != nullptr ? static_cast<const char *>(delimiter) + 1 : content_end;
+            }
+            const void *delimiter = std::memchr(field, settings.delimiter,
+                                                static_cast<std::size_t>(content_end - field));
+            const char *field_end = delimiter != nullptr ? static_cast<const char *>(delimiter) : content_end;
+
+            work.output.append(line, field);
+            const char *error = convert_field(field, field_end, units, settings.bare, work.output);
+            if (error != nullptr) {
+                work.error_line = work.lines;
+                work.error = error;
+                return;
+            }
+            work.output.append(field_end, content_end);
+        }
+
+        work.output.append(content_end, line_end);
+        if (line_end != work.last) {
+            work.output.push_back('\n');
+            line = line_end + 1;
+        } else {
+            line = line_end;
+        }
+        ++work.lines;
+    }
+}
+
+// End of the last complete line in [first, last), first if there is none
+const char *last_line_end(const char *first, const char *last)
+{
+    for (const char *position = last; position != first; --position) {
+        if (position[-1] == '\n') {
+            return position;
+        }
+    }
+    return first;
+}
+
+// Converts a chunk on a worker thread, where an exception (e.g. out of memory) would
+// terminate the program: it is reported as an error of the line being converted
+template<class UnitId>
+void convert_chunk_reporting(chunk &work, const unit_pair<UnitId> &units, const options &settings)
+{
+    try {
+        convert_chunk(work, units, settings);
+    } catch (const std::exception &error) {
+        work.failure = error.what();
+        work.error_line = work.lines;
+        work.error = work.failure.c_str();
+    } catch (...) {
+        work.error_line = work.lines;
+        work.error = "conversion failed";
+    }
+}
+
+// Whether file is a regular file, which can be mapped. Pipes, FIFOs and devices
+// (e.g. "<(command)") have no size until they are read and are streamed instead.
+bool is_regular(std::FILE *file)
+{
+#if defined(_WIN32)
+    struct _stat64 status;
+    return _fstat64(_fileno(file), &status) == 0 && (status.st_mode & _S_IFMT) == _S_IFREG;
+#else
+    struct stat status;
+    return ::fstat(fileno(file), &status) == 0 && S_ISREG(status.st_mode);
+#endif
+}
+
+// Yields the input chunk by chunk, cut after a line break. A named regular file is mapped
+// (an empty one is an empty input); any other named input and stdin are streamed. Chunks
+// hold whole lines: a line longer than chunk_size makes its chunk longer. Read errors throw.
+class chunk_reader {
+public:
+    explicit chunk_reader(const char *path)
+    {
+        if (path == nullptr || std::strcmp(path, "-") == 0) {
+            return;
+        }
+        m_stream = std::fopen(path, "rb");
+        if (m_stream == nullptr) {
+            throw std::system_error(errno, std::generic_category(), std::string("can not open ") + path);
+        }
+        if (is_regular(m_stream)) {
+            m_mapped = true;
+            m_file = sipp::mapped_file(path);
+            m_position = reinterpret_cast<const char *>(m_file.data());
+            m_end = m_position + m_file.size();
+        }
+    }
+
+    chunk_reader(const chunk_reader &) = delete;
+    chunk_reader &operator=(const chunk_reader &) = delete;
+
+    ~chunk_reader()
+    {
+        if (m_stream != stdin) {
+            std::fclose(m_stream);
+        }
+    }
+
+    bool next(chunk &work)
+    {
+        return m_mapped ? next_mapped(work) : next_stream(work);
+    }
+
+private:
+    bool next_mapped(chunk &work)
+    {
+        if (m_position == m_end) {
+            return false;
+        }
+        const char *last = m_end;
+        if (static_cast<std::size_t>(m_end - m_position) > chunk_size) {
+            last = last_line_end(m_position, m_position + chunk_size);
+            if (last == m_position) {
+                const void *line_end = std::memchr(m_position + chunk_size, '\n',
+                                                   static_cast<std::size_t>(m_end - m_position) - chunk_size);
+                last = line_end != nullptr ? static_cast<const char *>(line_end) + 1 : m_end;
+            }
+        }
+        m_file.will_need(static_cast<std::size_t>(last - reinterpret_cast<const char *>(m_file.data())),
+                         chunk_size);
+        work.first = m_position;
+        work.last = last;
+        m_position = last;
+        return true;
+    }
+
+    bool next_stream(chunk &work)
+    {
+        work.storage.swap(m_carry);
+        // the carried bytes are the start of a line, read until a line ends or the input does
+        std::size_t searched = work.storage.size();
+        std::size_t cut = 0;
+        for (;;) {
+            work.storage.resize(searched + chunk_size);
+            const std::size_t read = std::fread(work.storage.data() + searched, 1, chunk_size, m_stream);
+            if (std::ferror(m_stream)) {
+                throw std::system_error(errno, std::generic_category(), "read failed");
+            }
+            work.storage.resize(searched + read);
+            if (read != chunk_size) {
+                cut = work.storage.size();
+                break;
+            }
+            const char *fresh = work.storage.data() + searched;
+            cut = static_cast<std::size_t>(last_line_end(fresh, fresh + read) - work.storage.data());
+            if (cut != searched) {
+                break;
+            }
+            searched += read;
+        }
+        if (work.storage.empty()) {
+            return false;
+        }
+
+        const char *first = work.storage.data();
+        const char *last = first + work.storage.size();
+        m_carry.assign(first + cut, last);
+        work.storage.resize(cut);
+        work.first = work.storage.data();
+        work.last = work.first + work.storage.size();
+        return true;
+    }
+
+    std::FILE *m_stream = stdin;
+    bool m_mapped = false;
+    sipp::mapped_file m_file;
+    const char *m_position = nullptr;
+    const char *m_end = nullptr;
+    std::vector<char> m_carry;
+};
+
+// Reader (calling thread), converting workers and an ordered writer over a ring of chunks
+template<class UnitId>
+int run(const options &settings, const unit_pair<UnitId> &units)
+{
+    chunk_reader reader(settings.input);
+    std::FILE *output = settings.output != nullptr ? std::fopen(settings.output, "wb") : stdout;
+    if (output == nullptr) {
+        std::fprintf(stderr, "sipp-convert: can not open %s: %s\n", settings.output, std::strerror(errno));
+        return 1;
+    }
+
+    const unsigned workers = settings.threads != 0 ? settings.threads
+                                                   : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t ring_size = 2 * workers + 2;
+    std::vector<chunk> ring(ring_size);
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::size_t read_count = 0;
+    std::size_t next_work = 0;
+    std::size_t written = 0;
+    bool reading = true;
+    bool failed = false;
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < workers; ++i) {
+        threads.emplace_back([&] {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                changed.wait(lock, [&] { return next_work < read_count || !reading || failed; });
+                if (next_work == read_count) {
+                    return;
+                }
+                chunk &work = ring[next_work++ % ring_size];
+                lock.unlock();
+                convert_chunk_reporting(work, units, settings);
+                lock.lock();
+                work.ready = true;
+                changed.notify_all();
+            }
+        });
+    }
+
+    std::thread writer([&] {
+        std::size_t lines = settings.header ? 1 : 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            changed.wait(lock, [&] { return written < read_count ? ring[written % ring_size].ready : !reading; });
+            if (written == read_count) {
+                return;
+            }
+            chunk &work = ring[written % ring_size];
+            lock.unlock();
+
+            bool ok = std::fwrite(work.output.data(), 1, work.output.size(), output) == work.output.size();
+            if (work.error != nullptr) {
+                std::fprintf(stderr, "sipp-convert: line %zu: %s\n", lines + work.error_line + 1, work.error);
+                ok = false;
+            } else if (!ok) {
+                std::fprintf(stderr, "sipp-convert: write failed: %s\n", std::strerror(errno));
+            }
+            lines += work.lines;
+
+            lock.lock();
+            work.ready = false;
+            ++written;
+            failed = failed || !ok;
+            changed.notify_all();
+            if (failed) {
+                return;
+            }
+        }
+    });
+
+    int status = 0;
+    try {
+        bool header_pending = settings.header;
+        for (;;) {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&] { return read_count - written < ring_size || failed; });
+            if (failed) {
+                break;
+            }
+            chunk &work = ring[read_count % ring_size];
+            lock.unlock();
+
+            if (!reader.next(work)) {
+                break;
+            }
+            if (header_pending) {
+                // written before the first chunk is published, so ahead of any converted line
+                header_pending = false;
+                const char *header_end = static_cast<const char *>(
+                    std::memchr(work.first, '\n', static_cast<std::size_t>(work.last - work.first)));
+                header_end = header_end != nullptr ? header_end + 1 : work.last;
+                std::fwrite(work.first, 1, static_cast<std::size_t>(header_end - work.first), output);
+                work.first = header_end;
+            }
+
+            lock.lock();
+            ++read_count;
+            changed.notify_all();
+        }
+    } catch (const std::exception &error) {
+        std::fprintf(stderr, "sipp-convert: %s\n", error.what());
+        status = 1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        reading = false;
+        changed.notify_all();
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    writer.join();
+
+    if (std::fflush(output) != 0 || (output != stdout && std::fclose(output) != 0)) {
+        std::fprintf(stderr, "sipp-convert: write failed: %s\n", std::strerror(errno));
+        status = 1;
+    }
+    return failed ? 1 : status;
+}
+
+template<class UnitId>
+int run(const options &settings, UnitId to)
+{
+    unit_pair<UnitId> units{to, to, settings.from != nullptr};
+    if (units.has_from && !find_unit(settings.from, units.from)) {
+        std::fprintf(stderr, "sipp-convert: --from %s is not a unit of the --to dimension\n", settings.from);
+        return 2;
+    }
+    return run(settings, units);
+}
+
+bool parse_arguments(int argc, char **argv, options &settings)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (argument == "--to" && has_value) {
+            settings.to = argv[++i];
+        } else if (argument == "--from" && has_value) {
+            settings.from = argv[++i];
+        } else if (argument == "--column" && has_value) {
+            settings.column = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "--delimiter" && has_value && std::strlen(argv[i + 1]) == 1) {
+            settings.delimiter = argv[++i][0];
+        } else if (argument == "--threads" && has_value) {
+            settings.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-o" && has_value) {
+            settings.output = argv[++i];
+        } else if (argument == "--header") {
+            settings.header = true;
+        } else if (argument == "--bare") {
+            settings.bare = true;
+        } else if ((argument[0] != '-' || argument == "-") && settings.input == nullptr) {
+            settings.input = argv[i];
+        } else {
+            return false;
+        }
+    }
+    return settings.to != nullptr && settings.column != 0;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    options settings;
+    if (!parse_arguments(argc, argv, settings)) {
+        std::fputs(usage, stderr);
+        return 2;
+    }
+
+    try {
+        sipp::distance_unit distance;
+        if (find_unit(settings.to, distance)) {
+            return run(settings, distance);
+        }
+        sipp::speed_unit speed;
+        if (find_unit(settings.to, speed)) {
+            return run(settings, speed);
+        }
+    } catch (const std::system_error &error) {
+        std::fprintf(stderr, "sipp-convert: %s\n", error.what());
+        return 1;
+    }
+
+    std::fprintf(stderr, "sipp-convert: unknown unit %s\n", settings.to);
+    return 2;
+}
@@ -0,0 +1,112 @@
+# Runs sipp-convert on small inputs and compares with the expected outputs:
+# cmake -DCONVERT=<sipp-convert> -DSOURCE_DIR=<tools> -DWORK_DIR=<dir> -P test_convert.cmake
+
+# Compared as files: file(READ) drops carriage returns
+function(expect_output name expected)
+  file(WRITE ${WORK_DIR}/${name}.expected "${expected}")
+  execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${WORK_DIR}/${name}.out ${WORK_DIR}/${name}.expected
+                  RESULT_VARIABLE different)
+  if(different)
+    message(FATAL_ERROR "${name}: ${WORK_DIR}/${name}.out differs from ${WORK_DIR}/${name}.expected")
+  endif()
+endfunction()
+
+function(run_convert name input)
+  file(WRITE ${WORK_DIR}/${name}.in "${input}")
+  execute_process(COMMAND ${CONVERT} ${ARGN} -o ${WORK_DIR}/${name}.out ${WORK_DIR}/${name}.in
+                  RESULT_VARIABLE result ERROR_VARIABLE error)
+  set(result ${result} PARENT_SCOPE)
+  set(error "${error}" PARENT_SCOPE)
+endfunction()
+
+# One value per line, bare numbers in the --from unit, suffixed ones in their own
+run_convert(altitudes "1000\n-250.5\n\n12NM\n 3 ft\n" --from ft --to m)
+expect_output(altitudes "304.8m\n-76.3524m\n\n22224m\n0.9144000000000001m\n")
+
+# One column of a CSV file with a header, CRLF line ends and no final line break
+run_convert(tracks "time,speed,name\n0,100kts,a\r\n1,10m/s,b\n2,250,c" --to km/h --from kts --column 2 --header --bare)
+expect_output(tracks "time,speed,name\n0,185.20000000000002,a\r\n1,36,b\n2,463,c")
+
+# Tab delimited, middle column
+run_convert(legs "a\t1.5NM\tx\nb\t2km\ty\n" --to m --column 2 --delimiter "\t")
+expect_output(legs "a\t2778m\tx\nb\t2000m\ty\n")
+
+# Errors report the line and fail
+run_convert(invalid "1\n2\nabc\n" --to m --from ft --header)
+if(result EQUAL 0 OR NOT error MATCHES "line 3: invalid number")
+  message(FATAL_ERROR "invalid: expected a failure on line 3, got ${result}: ${error}")
+endif()
+
+run_convert(mismatch "1kts\n" --to m)
+if(result EQUAL 0 OR NOT error MATCHES "line 1: unit of another dimension")
+  message(FATAL_ERROR "mismatch: expected a dimension error, got ${result}: ${error}")
+endif()
+
+# Two chunks (4 MiB each) through the thread pool and from stdin keep the input order
+set(block "0.5\n1\n10\n2\n")
+set(block_meters "0.1524m\n0.3048m\n3.048m\n0.6096m\n")
+foreach(i RANGE 18)
+  set(block "${block}${block}")
+  set(block_meters "${block_meters}${block_meters}")
+endforeach()
+run_convert(chunks "${block}" --from ft --to m --threads 3)
+expect_output(chunks "${block_meters}")
+
+execute_process(COMMAND ${CONVERT} --from ft --to m --threads 2 -
+                INPUT_FILE ${WORK_DIR}/chunks.in OUTPUT_FILE ${WORK_DIR}/stdin.out RESULT_VARIABLE result)
+expect_output(stdin "${block_meters}")
+
+# A line longer than a chunk is not split, mapped or streamed
+set(long_field "x")
+foreach(i RANGE 22)
+  set(long_field "${long_field}${long_field}")
+endforeach()
+run_convert(long_line "1,${long_field}\n2,y\n" --from ft --to m --threads 2)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "long_line: failed with ${result}: ${error}")
+endif()
+expect_output(long_line "0.3048m,${long_field}\n0.6096m,y\n")
+
+execute_process(COMMAND ${CONVERT} --from ft --to m --threads 2 -o ${WORK_DIR}/long_stdin.out -
+                INPUT_FILE ${WORK_DIR}/long_line.in RESULT_VARIABLE result ERROR_VARIABLE error)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "long_stdin: failed with ${result}: ${error}")
+endif()
+expect_output(long_stdin "0.3048m,${long_field}\n0.6096m,y\n")
+
+# A read error fails instead of ending the input (reading a directory fails on POSIX)
+if(UNIX)
+  execute_process(COMMAND ${CONVERT} --from ft --to m -o ${WORK_DIR}/directory.out ${WORK_DIR}
+                  RESULT_VARIABLE result ERROR_VARIABLE error)
+  if(result EQUAL 0 OR NOT error MATCHES "read failed")
+    message(FATAL_ERROR "directory: expected a read error, got ${result}: ${error}")
+  endif()
+endif()
+
+# An empty file is an empty input, not stdin
+file(WRITE ${WORK_DIR}/empty.in "")
+execute_process(COMMAND ${CONVERT} --from ft --to m -o ${WORK_DIR}/empty.out ${WORK_DIR}/empty.in
+                INPUT_FILE ${WORK_DIR}/chunks.in RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "empty: failed with ${result}")
+endif()
+expect_output(empty "")
+
+# A named FIFO (as "<(command)" gives) is streamed, not mapped as an empty file
+find_program(MKFIFO mkfifo)
+find_program(SHELL_PROGRAM sh)
+if(MKFIFO AND SHELL_PROGRAM)
+  file(REMOVE ${WORK_DIR}/fifo.in)
+  execute_process(COMMAND ${MKFIFO} ${WORK_DIR}/fifo.in RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "fifo: mkfifo failed with ${result}")
+  endif()
+  execute_process(COMMAND ${SHELL_PROGRAM} -c "cat \"$1\" > \"$2\" & \"$3\" --from ft --to m --threads 2 -o \"$4\" \"$2\"; status=$?; wait; exit $status"
+                          fifo ${WORK_DIR}/chunks.in ${WORK_DIR}/fifo.in ${CONVERT} ${WORK_DIR}/fifo.out
+                  INPUT_FILE ${WORK_DIR}/empty.in RESULT_VARIABLE result)
+  file(REMOVE ${WORK_DIR}/fifo.in)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "fifo: failed with ${result}")
+  endif()
+  expect_output(fifo "${block_meters}")
+endif()